@@ -16,6 +16,8 @@
 #include <TTree.h>
 #include <TVector3.h>
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cassert>  // for assert
 #include <cmath>
@@ -1582,33 +1584,237 @@ void AnnularFieldSim::populate_fieldmap()
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements * nr * nphi * nz) << std::endl;
 
-  int el = 0;
+  if (lookupCase == PhiSlice && usePhiSliceDFT)
+  {
+    populate_phislice_fieldmap_dft();
+    return;
+  }
 
-  TVector3 localF;  // holder for the summed field at the current position.
-  for (int ir = rmin_roi; ir < rmax_roi; ir++)
+  // the hybrid kernels share the q_local scratch space, the analytic model is not known to be thread safe, and the debug printout counts calls.
+  // without a lookup the unit fields are computed on the fly, and the Rossegger green's functions are not reentrant.
+  bool parallel = (lookupCase == PhiSlice || lookupCase == Full3D || (lookupCase == NoLookup && green == nullptr)) && debug_printActionEveryN <= 0;
+
+  unsigned long long el = 0;
+  long long ncells = totalelements;
+#pragma omp parallel for schedule(dynamic) num_threads(GetNThreads()) if (parallel)
+  for (long long icell = 0; icell < ncells; icell++)
   {
-    for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+    int ir = rmin_roi + icell / (nphi_roi * nz_roi);
+    int iphi = phimin_roi + (icell / nz_roi) % nphi_roi;
+    int iz = zmin_roi + icell % nz_roi;
+    TVector3 localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
+    unsigned long long thisel;
+#pragma omp atomic capture
+    thisel = el++;
+    if (percent > 0 && !(thisel % percent))
     {
-      for (int iz = zmin_roi; iz < zmax_roi; iz++)
+#pragma omp critical
       {
-        localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
-        if (!(el % percent))
+        std::cout << std::format("populate_fieldmap {}%:  ", static_cast<uint64_t>(debug_npercent) * thisel / percent);
+
+        std::cout << std::format("sum_field_at (ir={}, iphi={}, iz={}) gives ({:E},{:E},{:E})", ir, iphi, iz, localF.X(), localF.Y(), localF.Z()) << std::endl;
+      }
+    }
+
+    Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
+  }
+  return;
+}
+
+void AnnularFieldSim::populate_phislice_fieldmap_dft()
+{
+  // the phislice sum at fixed (r,z) is a circular correlation along phi of the unit field with the charge:
+  //   E(phi) = sum_{ir,iz} sum_iphi Epartial(ir, iphi-phi, iz) q(ir, iphi, iz)
+  // so we multiply the fourier transforms of the lookup (computed once per lookup) and of the charge,
+  // sum them over the sources, and transform back once per (r,z).
+  // the transforms are direct DFTs, so this pays off through the summing, which no longer loops over the source phi.
+  build_phislice_spectra();
+  const PhiSliceSpectra &t = *phislice_spectra;
+  const int nk = t.nk;
+  std::vector<double> cosv(nphi);
+  std::vector<double> sinv(nphi);
+  for (int n = 0; n < nphi; n++)
+  {
+    cosv[n] = std::cos(2 * M_PI * n / nphi);
+    sinv[n] = std::sin(2 * M_PI * n / nphi);
+  }
+
+  // charge in each f-bin, indexed [r][z][phi]
+  std::vector<double> charge(static_cast<size_t>(nr) * nz * nphi);
+  for (int ir = 0; ir < nr; ir++)
+  {
+    for (int iz = 0; iz < nz; iz++)
+    {
+      for (int iphi = 0; iphi < nphi; iphi++)
+      {
+        charge[((static_cast<size_t>(ir) * nz + iz) * nphi) + iphi] = q->GetChargeInBin(ir, iphi, iz);
+      }
+    }
+  }
+
+  // spectra of the charge along phi, indexed [ir][iz][k]
+  std::vector<double> qre(static_cast<size_t>(nr) * nz * nk);
+  std::vector<double> qim(qre.size());
+#pragma omp parallel for num_threads(GetNThreads())
+  for (int ir = 0; ir < nr; ir++)
+  {
+    for (int iz = 0; iz < nz; iz++)
+    {
+      size_t out = ((static_cast<size_t>(ir) * nz) + iz) * nk;
+      const double *slice = &charge[((static_cast<size_t>(ir) * nz) + iz) * nphi];
+      for (int k = 0; k < nk; k++)
+      {
+        double re = 0;
+        double im = 0;
+        for (int n = 0; n < nphi; n++)
         {
-          std::cout << std::format("populate_fieldmap {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
+          double val = slice[n];
+          int w = (k * n) % nphi;
+          re += val * cosv[w];
+          im -= val * sinv[w];
+        }
+        qre[out + k] = re;
+        qim[out + k] = im;
+      }
+    }
+  }
 
-          std::cout << std::format("sum_field_at (ir={}, iphi={}, iz={}) gives ({:E},{:E},{:E})", ir, iphi, iz, localF.X(), localF.Y(), localF.Z()) << std::endl;
+  std::cout << std::format("populating phislice fieldmap for ({}x{}x{}) grid with {} phi frequencies", nr_roi, nphi_roi, nz_roi, nk) << std::endl;
+#pragma omp parallel for collapse(2) schedule(dynamic) num_threads(GetNThreads())
+  for (int irel = 0; irel < nr_roi; irel++)
+  {
+    for (int izrel = 0; izrel < nz_roi; izrel++)
+    {
+      std::vector<double> cre[3];
+      std::vector<double> cim[3];
+      for (int c = 0; c < 3; c++)
+      {
+        cre[c].assign(nk, 0);
+        cim[c].assign(nk, 0);
+      }
+      for (int ir = 0; ir < nr; ir++)
+      {
+        for (int iz = 0; iz < nz; iz++)
+        {
+          size_t src = ((((static_cast<size_t>(irel) * nz_roi + izrel) * nr + ir) * nz) + iz) * nk;
+          size_t qsrc = ((static_cast<size_t>(ir) * nz) + iz) * nk;
+          for (int c = 0; c < 3; c++)
+          {
+            const float *ere = &t.re[c][src];
+            const float *eim = &t.im[c][src];
+            double *sre = cre[c].data();
+            double *sim = cim[c].data();
+#pragma omp simd
+            for (int k = 0; k < nk; k++)
+            {
+              // Q * conj(E), since the lookup enters the sum as a correlation:
+              sre[k] += (qre[qsrc + k] * ere[k]) + (qim[qsrc + k] * eim[k]);
+              sim[k] += (qim[qsrc + k] * ere[k]) - (qre[qsrc + k] * eim[k]);
+            }
+          }
         }
-        el++;
+      }
+
+      TVector3 slicepos = GetRoiCellCenter(irel, 0, izrel);
+      for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+      {
+        double f[3];
+        for (int c = 0; c < 3; c++)
+        {
+          double val = cre[c][0];
+          for (int k = 1; k < nk; k++)
+          {
+            double weight = (2 * k == nphi) ? 1 : 2;  // the nyquist term has no mirror partner
+            int w = (k * iphi) % nphi;
+            val += weight * (cre[c][k] * cosv[w] - cim[c][k] * sinv[w]);
+          }
+          f[c] = val / nphi;
+        }
+        TVector3 sum(f[0], f[1], f[2]);
+        TVector3 pos = GetRoiCellCenter(irel, iphi - phimin_roi, izrel);
+        sum.RotateZ(pos.Phi() - slicepos.Phi());  // same rotation as sum_phislice_field_at
+        sum += Eexternal->Get(irel, iphi - phimin_roi, izrel);
+        Efield->Set(irel, iphi - phimin_roi, izrel, sum);
+      }
+    }
+  }
+  return;
+}
 
-        Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
-                                                                               // if (localF.Mag()>1e-9)
-                                                                               // if(debugFlag()) print_need_cout("%d: AnnularFieldSim::populate_fieldmap fieldmap@ (%d,%d,%d) mag=%f\n",__LINE__,ir,iphi,iz,localF.Mag());
+void AnnularFieldSim::build_phislice_spectra()
+{
+  if (!phislice_spectra)
+  {
+    phislice_spectra = std::make_shared<PhiSliceSpectra>();
+  }
+  PhiSliceSpectra &t = *phislice_spectra;
+  if (t.nk > 0)
+  {
+    return;
+  }
+  const int nk = nphi / 2 + 1;
+  std::cout << std::format("transforming phislice lookup along phi ({} frequencies)", nk) << std::endl;
+  std::vector<double> cosv(nphi);
+  std::vector<double> sinv(nphi);
+  for (int n = 0; n < nphi; n++)
+  {
+    cosv[n] = std::cos(2 * M_PI * n / nphi);
+    sinv[n] = std::sin(2 * M_PI * n / nphi);
+  }
+  size_t length = static_cast<size_t>(nr_roi) * nz_roi * nr * nz * nk;
+  for (int c = 0; c < 3; c++)
+  {
+    t.re[c].resize(length);
+    t.im[c].resize(length);
+  }
+#pragma omp parallel for collapse(2) schedule(dynamic) num_threads(GetNThreads())
+  for (int irel = 0; irel < nr_roi; irel++)
+  {
+    for (int izrel = 0; izrel < nz_roi; izrel++)
+    {
+      for (int ir = 0; ir < nr; ir++)
+      {
+        for (int iz = 0; iz < nz; iz++)
+        {
+          bool isSelf = (ir == irel + rmin_roi && iz == izrel + zmin_roi);
+          size_t out = ((((static_cast<size_t>(irel) * nz_roi + izrel) * nr + ir) * nz) + iz) * nk;
+          for (int k = 0; k < nk; k++)
+          {
+            double re[3] = {0, 0, 0};
+            double im[3] = {0, 0, 0};
+            for (int n = 0; n < nphi; n++)
+            {
+              if (isSelf && n == 0)
+              {
+                continue;  // self-to-self is skipped in the sum.
+              }
+              const TVector3 *v = Epartial_phislice->GetPtr(irel, 0, izrel, ir, n, iz);
+              int w = (k * n) % nphi;
+              for (int c = 0; c < 3; c++)
+              {
+                re[c] += (*v)[c] * cosv[w];
+                im[c] -= (*v)[c] * sinv[w];
+              }
+            }
+            for (int c = 0; c < 3; c++)
+            {
+              t.re[c][out + k] = re[c];
+              t.im[c][out + k] = im[c];
+            }
+          }
+        }
       }
     }
   }
+  t.nk = nk;
   return;
 }
 
+int AnnularFieldSim::GetNThreads() const
+{
+  return (nthreads > 0) ? nthreads : omp_get_max_threads();
+}
+
 void AnnularFieldSim::populate_lookup()
 {
   // with 'f' being the position the field is being measured at, and 'o' being the position of the charge generating the field.
@@ -1664,46 +1870,54 @@ void AnnularFieldSim::populate_full3d_lookup()
   totalelements *= nz;  // breaking up this multiplication prevents a 32bit math overflow
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
-  {
-    for (int ifphi = phimin_roi; ifphi < phimax_roi; ifphi++)
+  // every destination cell fills its own slice of the lookup, so they can be computed in parallel.
+  // the Rossegger green's functions keep state in fortran common blocks, so they must run serially.
+  unsigned long long el = 0;
+  unsigned long long nsources = static_cast<unsigned long long>(nr) * nphi * nz;
+  int nphi_dest = phimax_roi - phimin_roi;
+  int nz_dest = zmax_roi - zmin_roi;
+  long long ndest = static_cast<long long>(rmax_roi - rmin_roi) * nphi_dest * nz_dest;
+#pragma omp parallel for schedule(dynamic) num_threads(GetNThreads()) if (green == nullptr)
+  for (long long idest = 0; idest < ndest; idest++)
+  {
+    int ifr = rmin_roi + idest / (nphi_dest * nz_dest);
+    int ifphi = phimin_roi + (idest / nz_dest) % nphi_dest;
+    int ifz = zmin_roi + idest % nz_dest;
+    TVector3 at = GetCellCenter(ifr, ifphi, ifz);
+    for (int ior = 0; ior < nr; ior++)
     {
-      for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+      for (int iophi = 0; iophi < nphi; iophi++)
       {
-        at = GetCellCenter(ifr, ifphi, ifz);
-        for (int ior = 0; ior < nr; ior++)
+        for (int ioz = 0; ioz < nz; ioz++)
         {
-          for (int iophi = 0; iophi < nphi; iophi++)
-          {
-            for (int ioz = 0; ioz < nz; ioz++)
-            {
-              el++;
-              if (!(el % percent))
-              {
-                std::cout << std::format("populate_full3d_lookup {}%", static_cast<uint64_t>(debug_npercent) * el / percent) << std::endl;
-              }
-              from = GetCellCenter(ior, iophi, ioz);
+          TVector3 from = GetCellCenter(ior, iophi, ioz);
 
-              //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-              // print_need_cout("calc_unit_field...\n");
-              if (ifr == ior && ifphi == iophi && ifz == ioz)
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, zero);
-              }
-              else
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, calc_unit_field(at, from));
-              }
-            }
+          //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
+          // print_need_cout("calc_unit_field...\n");
+          if (ifr == ior && ifphi == iophi && ifz == ioz)
+          {
+            Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, zero);
+          }
+          else
+          {
+            Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, calc_unit_field(at, from));
           }
         }
       }
     }
+    unsigned long long before;
+#pragma omp atomic capture
+    {
+      before = el;
+      el += nsources;
+    }
+    if (percent > 0 && (before / percent) != ((before + nsources) / percent))
+    {
+#pragma omp critical
+      std::cout << std::format("populate_full3d_lookup {}%", static_cast<uint64_t>(debug_npercent) * (before + nsources) / percent) << std::endl;
+    }
   }
   return;
 }
@@ -1886,53 +2100,44 @@ void AnnularFieldSim::populate_highres_lookup()
 
 void AnnularFieldSim::populate_lowres_lookup()
 {
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
-  int fphi_low;
-  int fphi_high;
-  int fz_low;
-  int fz_high;  // edges of the outer l-bin
-  int r_low;
-  int r_high;
-  int phi_low;
-  int phi_high;
-  int z_low;
-  int z_high;  // edges of the inner l-bin
 
   // todo:  add in handling if roi_low is wrap-around in phi
+  // every destination l-bin fills its own slice of the lookup, so they can be computed in parallel.
+  // the Rossegger green's functions keep state in fortran common blocks, so they must run serially.
+#pragma omp parallel for collapse(3) schedule(dynamic) num_threads(GetNThreads()) if (green == nullptr)
   for (int ifr = rmin_roi_low; ifr < rmax_roi_low; ifr++)
   {
-    int fr_low = ifr * r_spacing;
-    int fr_high = fr_low + r_spacing - 1;
-    if (fr_high >= nr)
-    {
-      fr_high = nr - 1;
-    }
     for (int ifphi = phimin_roi_low; ifphi < phimax_roi_low; ifphi++)
     {
-      fphi_low = ifphi * phi_spacing;
-      fphi_high = fphi_low + phi_spacing - 1;
-      if (fphi_high >= nphi)
-      {
-        fphi_high = nphi - 1;  // if our phi l-bins aren't evenly spaced, we need to catch that here.
-      }
       for (int ifz = zmin_roi_low; ifz < zmax_roi_low; ifz++)
       {
-        fz_low = ifz * z_spacing;
-        fz_high = fz_low + z_spacing - 1;
+        int fr_low = ifr * r_spacing;
+        int fr_high = fr_low + r_spacing - 1;
+        if (fr_high >= nr)
+        {
+          fr_high = nr - 1;
+        }
+        int fphi_low = ifphi * phi_spacing;
+        int fphi_high = fphi_low + phi_spacing - 1;
+        if (fphi_high >= nphi)
+        {
+          fphi_high = nphi - 1;  // if our phi l-bins aren't evenly spaced, we need to catch that here.
+        }
+        int fz_low = ifz * z_spacing;
+        int fz_high = fz_low + z_spacing - 1;
         if (fz_high >= nz)
         {
           fz_high = nz - 1;
         }
-        at = GetGroupCellCenter(fr_low, fr_high, fphi_low, fphi_high, fz_low, fz_high);
+        TVector3 at = GetGroupCellCenter(fr_low, fr_high, fphi_low, fphi_high, fz_low, fz_high);
         // print_need_cout("ifr=%d, rlow=%d,rhigh=%d,r_spacing=%d\n",ifr,r_low,r_high,r_spacing);
         // if(debugFlag())	  print_need_cout("%d: AnnularFieldSim::populate_lowres_lookup icell=(%d,%d,%d)\n",__LINE__,ifr,ifphi,ifz);
 
         for (int ior = 0; ior < nr_low; ior++)
         {
-          r_low = ior * r_spacing;
-          r_high = r_low + r_spacing - 1;
+          int r_low = ior * r_spacing;
+          int r_high = r_low + r_spacing - 1;
           int ir_rel = ifr - rmin_roi_low;
 
           if (r_high >= nr)
@@ -1941,8 +2146,8 @@ void AnnularFieldSim::populate_lowres_lookup()
           }
           for (int iophi = 0; iophi < nphi_low; iophi++)
           {
-            phi_low = iophi * phi_spacing;
-            phi_high = phi_low + phi_spacing - 1;
+            int phi_low = iophi * phi_spacing;
+            int phi_high = phi_low + phi_spacing - 1;
             if (phi_high >= nphi)
             {
               phi_high = nphi - 1;
@@ -1950,14 +2155,14 @@ void AnnularFieldSim::populate_lowres_lookup()
             int iphi_rel = ifphi - phimin_roi_low;
             for (int ioz = 0; ioz < nz_low; ioz++)
             {
-              z_low = ioz * z_spacing;
-              z_high = z_low + z_spacing - 1;
+              int z_low = ioz * z_spacing;
+              int z_high = z_low + z_spacing - 1;
               if (z_high >= nz)
               {
                 z_high = nz - 1;
               }
               int iz_rel = ifz - zmin_roi_low;
-              from = GetGroupCellCenter(r_low, r_high, phi_low, phi_high, z_low, z_high);
+              TVector3 from = GetGroupCellCenter(r_low, r_high, phi_low, phi_high, z_low, z_high);
 
               if (ifr == ior && ifphi == iophi && ifz == ioz)
               {
@@ -1986,6 +2191,7 @@ void AnnularFieldSim::populate_phislice_lookup()
   // remember the 'f' part of Epartial uses relative indices.
   //   TVector3 (*f)[fx][fy][fz][ox][oy][oz]=field_;
   std::cout << std::format("populating phislice lookup for ({}x{}x{})x({}x{}x{}) grid", nr_roi, 1, nz_roi, nr, nphi, nz) << std::endl;
+  phislice_spectra = std::make_shared<PhiSliceSpectra>();  // spectra are rebuilt from the new lookup on first use
   unsigned long long totalelements = nr;  // nr*nphi*nz*nr_roi*nz_roi
   totalelements *= nphi;
   totalelements *= nz;
@@ -1993,16 +2199,19 @@ void AnnularFieldSim::populate_phislice_lookup()
   totalelements *= nz_roi;  // breaking up this multiplication prevents a 32bit math overflow
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
-  int el = 0;
+  // every destination cell fills its own slice of the lookup, so they can be computed in parallel.
+  // the element counter is computed from the indices, so the progress printout reports the same elements as a serial run.
+  // the Rossegger green's functions keep state in fortran common blocks, so they must run serially.
+  unsigned long long nsources = static_cast<unsigned long long>(nr) * nphi * nz;
+#pragma omp parallel for collapse(2) schedule(dynamic) num_threads(GetNThreads()) if (green == nullptr)
   for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
   {
     for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
     {
-      at = GetCellCenter(ifr, 0, ifz);
+      TVector3 at = GetCellCenter(ifr, 0, ifz);
+      unsigned long long el = ((static_cast<unsigned long long>(ifr - rmin_roi) * nz_roi) + (ifz - zmin_roi)) * nsources;
       for (int ior = 0; ior < nr; ior++)
       {
         for (int iophi = 0; iophi < nphi; iophi++)
@@ -2010,27 +2219,30 @@ void AnnularFieldSim::populate_phislice_lookup()
           for (int ioz = 0; ioz < nz; ioz++)
           {
             el++;
-            from = GetCellCenter(ior, iophi, ioz);
+            TVector3 from = GetCellCenter(ior, iophi, ioz);
             //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
             // print_need_cout("calc_unit_field...\n");
             if (ifr == ior && 0 == iophi && ifz == ioz)
             {
-              if (!(el % percent))
+              if (percent > 0 && !(el % percent))
               {
-                std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
+#pragma omp critical
+                {
+                  std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
 
-                std::cout << std::format("self-to-self is zero (ir={}, iphi={}, iz={}) to (or={}, ophi=0, oz={}) gives ({:E},{:E},{:E})",
-                                         ior, iophi, ioz, ifr, ifz, zero.X(), zero.Y(), zero.Z())
-                          << std::endl;
+                  std::cout << std::format("self-to-self is zero (ir={}, iphi={}, iz={}) to (or={}, ophi=0, oz={}) gives ({:E},{:E},{:E})",
+                                           ior, iophi, ioz, ifr, ifz, zero.X(), zero.Y(), zero.Z())
+                            << std::endl;
+                }
               }
               Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, zero);
             }
             else
             {
               TVector3 unitf = calc_unit_field(at, from);
-              if (true)
+              if (percent > 0 && !(el % percent))
               {
-                if (!(el % percent))
+#pragma omp critical
                 {
                   std::cout << std::format("populate_phislice_lookup {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
 
@@ -2055,6 +2267,7 @@ void AnnularFieldSim::load_phislice_lookup(const std::string &sourcefile)
   std::cout << std::format("loading phislice lookup for ({}x{}x{})x({}x{}x{}) grid from {}",
                            nr_roi, 1, nz_roi, nr, nphi, nz, sourcefile)
             << std::endl;
+  phislice_spectra = std::make_shared<PhiSliceSpectra>();  // spectra are rebuilt from the new lookup on first use
   unsigned long long totalelements = nr;  // nr*nphi*nz*nr_roi*nz_roi
   totalelements *= nphi;
   totalelements *= nz;
@@ -2684,50 +2897,37 @@ TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z)
 {
   // sum the E field over all nr by ny by nz cells of sources, at the specific position r,phi,z.
   // note the specific position in Epartial is in relative coordinates.
-  // print_need_cout("AnnularFieldSim::sum_field_at(r=%d,phi=%d, z=%d)\n",r,phi,z);
   TVector3 pos = GetRoiCellCenter(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
   TVector3 slicepos = GetRoiCellCenter(r - rmin_roi, 0, z - zmin_roi);
   float rotphi = pos.Phi() - slicepos.Phi();  // probably this is phi*step.Phi();
 
-  // caution:  if you print progress of each of these, it will print a great deal of data, since this is called per-bin
-  // unsigned long long totalelements=nr*nphi*nz;
-  //  unsigned long long percent=totalelements/100;
-
-  // unsigned long long el=0;
-
-  TVector3 sum(0, 0, 0);
-  TVector3 unrotatedField(0, 0, 0);
-  TVector3 unitField(0, 0, 0);
-  int phirel;
+  // the rotation is the same for every source, so we sum the unrotated unit fields and rotate once at the end.
+  // the lookup for this destination is contiguous, indexed [ir][iphi][iz]
+  const TVector3 *lookup = Epartial_phislice->GetPtr(r - rmin_roi, 0, z - zmin_roi, 0, 0, 0);
+  double sumx = 0;
+  double sumy = 0;
+  double sumz = 0;
   for (int ir = 0; ir < nr; ir++)
   {
     for (int iphi = 0; iphi < nphi; iphi++)
     {
+      int phirel = FilterPhiIndex(iphi - phi);
+      const TVector3 *unitField = &lookup[((static_cast<size_t>(ir) * nphi) + phirel) * nz];
       for (int iz = 0; iz < nz; iz++)
       {
-        // sum+=*partial[x][phi][z][ix][iphi][iz] * *q[ix][iphi][iz];
         if (r == ir && phi == iphi && z == iz)
         {
           continue;  // dont' compute self-to-self field.
         }
-        phirel = FilterPhiIndex(iphi - phi);
-        unitField = Epartial_phislice->Get(r - rmin_roi, 0, z - zmin_roi, ir, phirel, iz);
-        unitField.RotateZ(rotphi);  // previously was rotate by the step.Phi()*phi.    //annoying that I can't rename this to 'rotated field' here without unnecessary overhead.
-
-        sum += unitField * q->GetChargeInBin(ir, iphi, iz);
-        ;
-
-        /*
-        if(!(el%percent)) {print_need_cout("summing phislices %d%%:  ",(int)(el/percent));
-          print_need_cout("unit field at (r=%d,p=%d,z=%d) from  (ir=%d,ip=%d,iz=%d) is (%E,%E,%E) (xyz), q=%E\n",
-                 r,phi,z,ir,iphi,iz,unitField.X(),unitField.Y(),unitField.Z(),q->GetChargeInBin(ir,iphi,iz));
-        }
-        el++;
-        */
+        double charge = q->GetChargeInBin(ir, iphi, iz);
+        sumx += unitField[iz].X() * charge;
+        sumy += unitField[iz].Y() * charge;
+        sumz += unitField[iz].Z() * charge;
       }
     }
   }
-  // print_need_cout("summed field at (%d,%d,%d)=(%f,%f,%f)\n",x,y,z,sum.X(),sum.Y(),sum.Z());
+  TVector3 sum(sumx, sumy, sumz);
+  sum.RotateZ(rotphi);
   return sum;
 }
 
@@ -3342,6 +3542,57 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
   //  normal.
 
   // note that we apply the adjustment to the particle position (inpart) and not the plotted position (partR etc)
+  // the drift of each sampled point is independent of all others, so we compute them all up front in parallel,
+  // and fill the histograms and tree afterwards in the original order.  The RdeltaR histogram is filled inside
+  // GetTotalDistortion, so we only go parallel when that is switched off.
+  auto sampleIndex = [&](int jr, int jp, int jz, int side)
+  { return (((static_cast<size_t>(jr) * nph + jp) * nzh + jz) * nSides) + side; };
+  size_t nsamples = static_cast<size_t>(nrh) * nph * nzh * nSides;
+  std::vector<TVector3> distortSample(nsamples);
+  std::vector<int> validSample(nsamples, 0);
+  std::vector<int> successSample(nsamples, 0);
+  bool parallelSamples = !RdeltaRswitch && !(nSides > 1 && twin->RdeltaRswitch);
+#pragma omp parallel for collapse(2) schedule(dynamic) num_threads(GetNThreads()) if (parallelSamples)
+  for (int jr = 0; jr < nrh; jr++)
+  {
+    for (int jp = 0; jp < nph; jp++)
+    {
+      float sampleR = (jr + 0.5) * deltar + rih;
+      if (jr == 0)
+      {
+        sampleR += deltar;
+      }
+      else if (jr == nrh - 1)
+      {
+        sampleR -= deltar;
+      }
+      TVector3 samplepart(1, 0, 0);
+      samplepart.SetPerp(sampleR);
+      samplepart.SetPhi((jp + 0.5) * deltap + pih);
+      for (int jz = 0; jz < nzh; jz++)
+      {
+        float sampleZ = (jz) *deltaz + zih;
+        if (jz == 0)
+        {
+          sampleZ += deltaz;
+        }
+        else if (jz == nzh - 1)
+        {
+          sampleZ -= deltaz;
+        }
+        samplepart.SetZ(sampleZ);
+        size_t idx = sampleIndex(jr, jp, jz, 0);
+        distortSample[idx] = GetTotalDistortion(z_readout, samplepart, nSteps, true, &validSample[idx], &successSample[idx]);
+        if (nSides > 1)
+        {
+          samplepart.SetZ(-sampleZ);
+          idx = sampleIndex(jr, jp, jz, 1);
+          distortSample[idx] = twin->GetTotalDistortion(-z_readout, samplepart, nSteps, true, &validSample[idx], &successSample[idx]);
+        }
+      }
+    }
+  }
+
   inpart.SetXYZ(1, 0, 0);
   for (ir = 0; ir < nrh; ir++)
   {
@@ -3384,7 +3635,7 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
           if (localside == 0)
           {
             diffdistort = zero_vector;  // GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
+            // distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
           }
           else
           {
@@ -3393,8 +3644,12 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
             partZ *= -1;                   // position to place in histogram
             inpart.SetZ(-1 * inpart.Z());  // position to seek in sim
             diffdistort = zero_vector;     // twin->GetTotalDistortion(inpart.Z() - deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = twin->GetTotalDistortion(-z_readout, inpart, nSteps, true, &validToStep, &successCheck);
+            // distort = twin->GetTotalDistortion(-z_readout, inpart, nSteps, true, &validToStep, &successCheck);
           }
+          size_t sample = sampleIndex(ir, ip, iz, localside);
+          distort = distortSample[sample];
+          validToStep = validSample[sample];
+          successCheck = successSample[sample];
 
           diffdistort.RotateZ(-inpart.Phi());  // rotate so that distortion components are wrt the x axis
           diffdistP = diffdistort.Y();         // the phi component is now the y component.
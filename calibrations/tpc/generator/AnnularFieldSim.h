@@ -4,7 +4,9 @@
 
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 class AnalyticFieldModel;
 class ChargeMapReader;
@@ -94,6 +96,16 @@ class AnnularFieldSim
     truncation_length = x;
     return;
   }
+  void SetNThreads(int n)
+  {
+    nthreads = n;
+    return;
+  };  // number of OpenMP threads used to build lookups, field maps and distortion maps.  values <1 use the OpenMP default.
+  void UsePhiSliceDFT(bool b)
+  {
+    usePhiSliceDFT = b;
+    return;
+  };  // in PhiSlice mode, sum the fieldmap as a convolution along phi in fourier space (direct DFT) instead of cell by cell.
 
   // getters for internal states:
   std::string GetLookupString();
@@ -166,6 +178,7 @@ class AnnularFieldSim
   void borrow_epartial_from(AnnularFieldSim *sim, float zshift)
   {
     Epartial_phislice = sim->Epartial_phislice;
+    phislice_spectra = sim->phislice_spectra;
     green_shift = zshift;
     printf("AnnularFieldSim::borrow_epartial_from:  borrowed Epartial_phislice table with zshift %f\n", zshift);
     return;
@@ -219,6 +232,10 @@ class AnnularFieldSim
   TVector3 GetTotalDistortion(float zdest, const TVector3 &start, int nsteps, bool interpolate = true, int *goodToStep = 0, int *success = 0);
 
  private:
+  int GetNThreads() const;
+  void build_phislice_spectra();
+  void populate_phislice_fieldmap_dft();
+
   BoundsCase GetRindexAndCheckBounds(float pos, int *r);
   BoundsCase GetPhiIndexAndCheckBounds(float pos, int *phi);
   BoundsCase GetZindexAndCheckBounds(float pos, int *z);
@@ -349,4 +366,17 @@ class AnnularFieldSim
   MultiArray<double> *q_local;   // temporary holder of space charge in each f-bin and summed bin of the high-res region.
   MultiArray<double> *q_lowres;  // space charge in each l-bin. = sums over sets of f-bins.
   TH2 *hRdeltaRComponent{nullptr};
+
+  // threading and summing options:
+  int nthreads{1};
+  bool usePhiSliceDFT{false};
+
+  // fourier transforms of Epartial_phislice along phi for the DFT summing.  built on first use, and shared with whoever borrows our Epartial.
+  struct PhiSliceSpectra
+  {
+    int nk{0};                 // number of phi frequencies, 0 until the spectra are built.
+    std::vector<float> re[3];  // x,y,z components, indexed [r_roi][z_roi][ir][iz][k], self-to-self excluded.
+    std::vector<float> im[3];
+  };
+  std::shared_ptr<PhiSliceSpectra> phislice_spectra;
 };
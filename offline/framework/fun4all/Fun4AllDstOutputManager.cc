@@ -9,6 +9,7 @@
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 #include <phool/recoConsts.h>
 
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <cstdlib>
@@ -91,6 +92,14 @@ void Fun4AllDstOutputManager::Print(const std::string &what) const
         std::cout << Name() << ": Node " << nodename << " is written out" << std::endl;
       }
     }
+    if (m_AsyncMaxInFlight > 0)
+    {
+      std::cout << Name() << ": asynchronous writing, max " << m_AsyncMaxInFlight << " events in flight" << std::endl;
+    }
+    if (m_CompressionThreads > 0)
+    {
+      std::cout << Name() << ": " << m_CompressionThreads << " compression threads" << std::endl;
+    }
   }
   // base class print method
   Fun4AllOutputManager::Print(what);
@@ -337,6 +346,11 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
     m_CurrentSegment++;
   }
   m_UsedOutFileName = OutFileName() + std::string("?reproducible=") + std::string(p.filename());
+  // the tree picks up the implicit multi-threading setting when it is created
+  if (m_CompressionThreads > 0 && !ROOT::IsImplicitMTEnabled())
+  {
+    ROOT::EnableImplicitMT(m_CompressionThreads);
+  }
   dstOut = new PHNodeIOManager(UsedOutFileName(), PHWrite);
   if (SplitLevel() != std::numeric_limits<int>::min())
   {
@@ -355,6 +369,7 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
   }
 
   dstOut->SetCompressionSetting(m_CompressionSetting);
+  dstOut->AsyncWrite(m_AsyncMaxInFlight);
   return 0;
 }
 
@@ -36,13 +36,22 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   const std::string &UsedOutFileName() const { return m_UsedOutFileName; }
   void CompressionSetting(const int i) override { m_CompressionSetting = i; }
   void InitializeLastEvent(int eventnumber) override;
-  
+
+  //! snapshot the nodes in Write() and fill/compress them in a background thread
+  //! with at most maxinflight events buffered, 0 (default) writes synchronously
+  void AsyncWrite(const unsigned int maxinflight) { m_AsyncMaxInFlight = maxinflight; }
+  //! compress baskets in parallel using ROOT implicit multi-threading with nthreads threads
+  //! (this enables ROOT implicit multi-threading for the whole process)
+  void CompressionThreads(const unsigned int nthreads) { m_CompressionThreads = nthreads; }
+
  private:
   int outfile_open_first_write();
   PHNodeIOManager *dstOut{nullptr};
   int m_SaveRunNodeFlag{1};
   int m_SaveDstNodeFlag{1};
   int m_CompressionSetting{505};
+  unsigned int m_AsyncMaxInFlight{0};
+  unsigned int m_CompressionThreads{0};
   bool m_LastEventInitialized{false};
   std::string m_FileNameStem;
   std::string m_UsedOutFileName;
@@ -0,0 +1,620 @@
+#include "Fun4AllHistoDump.h"
+
+#include <TArray.h>
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <TBufferFile.h>
+#include <TH1.h>
+#include <THashList.h>
+#include <TList.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+  constexpr std::array<char, 8> magic = {'F', '4', 'A', 'H', 'D', 'U', 'M', 'P'};
+
+  //! profiles bin entries, per cell
+  double get_binentries(const TH1 *h, int cell)
+  {
+    if (const auto *p1 = dynamic_cast<const TProfile *>(h))
+    {
+      return p1->GetBinEntries(cell);
+    }
+    if (const auto *p2 = dynamic_cast<const TProfile2D *>(h))
+    {
+      return p2->GetBinEntries(cell);
+    }
+    if (const auto *p3 = dynamic_cast<const TProfile3D *>(h))
+    {
+      return p3->GetBinEntries(cell);
+    }
+    return 0;
+  }
+
+  void set_binentries(TH1 *h, int cell, double value)
+  {
+    if (auto *p1 = dynamic_cast<TProfile *>(h))
+    {
+      p1->SetBinEntries(cell, value);
+    }
+    else if (auto *p2 = dynamic_cast<TProfile2D *>(h))
+    {
+      p2->SetBinEntries(cell, value);
+    }
+    else if (auto *p3 = dynamic_cast<TProfile3D *>(h))
+    {
+      p3->SetBinEntries(cell, value);
+    }
+  }
+
+  //! profiles sum of weights squared of bin entries, if any
+  TArrayD *get_binsumw2(TH1 *h)
+  {
+    TArrayD *binsumw2 = nullptr;
+    if (auto *p1 = dynamic_cast<TProfile *>(h))
+    {
+      binsumw2 = p1->GetBinSumw2();
+    }
+    else if (auto *p2 = dynamic_cast<TProfile2D *>(h))
+    {
+      binsumw2 = p2->GetBinSumw2();
+    }
+    else if (auto *p3 = dynamic_cast<TProfile3D *>(h))
+    {
+      binsumw2 = p3->GetBinSumw2();
+    }
+    return (binsumw2 && binsumw2->fN > 0) ? binsumw2 : nullptr;
+  }
+
+  bool is_profile(const TH1 *h)
+  {
+    return dynamic_cast<const TProfile *>(h) || dynamic_cast<const TProfile2D *>(h) || dynamic_cast<const TProfile3D *>(h);
+  }
+
+  //! read/write helpers
+  template <class T>
+  void put(std::ostream &out, const T &value)
+  {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <class T>
+  void put(std::ostream &out, const std::vector<T> &values)
+  {
+    out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+  }
+
+  //! axis definitions: number of bins, range, variable bin edges, extension flag and labels
+  std::vector<char> axis_signature(const TH1 *h)
+  {
+    std::ostringstream out;
+    for (const TAxis *axis : {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()})
+    {
+      put(out, axis->GetNbins());
+      put(out, axis->GetXmin());
+      put(out, axis->GetXmax());
+      put(out, axis->CanExtend());
+      const TArrayD *edges = axis->GetXbins();
+      put(out, edges->fN);
+      out.write(reinterpret_cast<const char *>(edges->GetArray()), edges->fN * sizeof(double));
+
+      // labels are attached to their bin through their unique id, their order in the list does not matter
+      std::vector<std::pair<uint32_t, std::string>> labels;
+      if (const THashList *list = axis->GetLabels())
+      {
+        for (const TObject *label : *list)
+        {
+          labels.emplace_back(label->GetUniqueID(), label->GetName());
+        }
+      }
+      std::sort(labels.begin(), labels.end());
+      put(out, static_cast<uint32_t>(labels.size()));
+      for (const auto &[bin, label] : labels)
+      {
+        put(out, bin);
+        put(out, static_cast<uint32_t>(label.size()));
+        out.write(label.data(), label.size());
+      }
+    }
+    const std::string signature = out.str();
+    return {signature.begin(), signature.end()};
+  }
+
+  //! bounds checked reader over a memory buffer
+  class Reader
+  {
+   public:
+    explicit Reader(const std::vector<char> &buffer)
+      : m_buffer(buffer)
+    {
+    }
+
+    template <class T>
+    bool get(T &value)
+    {
+      if (m_offset + sizeof(T) > m_buffer.size())
+      {
+        return false;
+      }
+      std::memcpy(&value, m_buffer.data() + m_offset, sizeof(T));
+      m_offset += sizeof(T);
+      return true;
+    }
+
+    template <class T>
+    bool get(std::vector<T> &values, size_t n)
+    {
+      if (n > (m_buffer.size() - m_offset) / sizeof(T))
+      {
+        return false;
+      }
+      values.resize(n);
+      std::memcpy(values.data(), m_buffer.data() + m_offset, n * sizeof(T));
+      m_offset += n * sizeof(T);
+      return true;
+    }
+
+   private:
+    const std::vector<char> &m_buffer;
+    size_t m_offset = 0;
+  };
+
+  //! add the sum of weights squared columns a record is missing, so that it can be merged with one which has them
+  /**
+   * ROOT enables Sumw2 automatically on the first weighted fill, so the same histogram
+   * can come with or without it from different jobs. Without it all fills had unit weight:
+   * the sum of weights squared is the bin content, or the bin entries for the profile bin sumw2.
+   * Returns false if the missing columns cannot be derived
+   */
+  bool add_missing_columns(Fun4AllHistoDump::Record &record, uint32_t columns)
+  {
+    const uint32_t missing = columns & ~record.columns;
+    if (missing == 0)
+    {
+      return true;
+    }
+    const bool profile = record.columns & Fun4AllHistoDump::BINENTRIES;
+    if ((missing & ~(Fun4AllHistoDump::SUMW2 | Fun4AllHistoDump::BINSUMW2)) ||
+        ((missing & Fun4AllHistoDump::SUMW2) && profile) ||
+        ((missing & Fun4AllHistoDump::BINSUMW2) && !profile))
+    {
+      return false;
+    }
+
+    const size_t old_ncolumns = record.ncolumns();
+    std::vector<double> values;
+    values.reserve(record.cells.size() * std::popcount(columns));
+    for (size_t i = 0; i < record.cells.size(); ++i)
+    {
+      // columns are stored in increasing bit order
+      const double *old_values = &record.values[i * old_ncolumns];
+      size_t ivalue = 0;
+      const double content = old_values[ivalue++];
+      values.push_back(content);
+      if (columns & Fun4AllHistoDump::SUMW2)
+      {
+        values.push_back((record.columns & Fun4AllHistoDump::SUMW2) ? old_values[ivalue++] : content);
+      }
+      if (profile)
+      {
+        const double binentries = old_values[ivalue++];
+        values.push_back(binentries);
+        if (columns & Fun4AllHistoDump::BINSUMW2)
+        {
+          values.push_back((record.columns & Fun4AllHistoDump::BINSUMW2) ? old_values[ivalue++] : binentries);
+        }
+      }
+    }
+    record.values = std::move(values);
+    record.columns = columns;
+    return true;
+  }
+}  // namespace
+
+//_____________________________________________________________________________
+uint32_t Fun4AllHistoDump::Record::ncolumns() const
+{
+  return std::popcount(columns);
+}
+
+//_____________________________________________________________________________
+bool Fun4AllHistoDump::add(const std::string &name, const TH1 *source)
+{
+  if (!m_records.empty() && !(m_records.back().name < name))
+  {
+    std::cout << "Fun4AllHistoDump::add - histograms must be added once, in increasing name order: " << name << std::endl;
+    return false;
+  }
+
+  Record record;
+  if (!make_record(record, name, const_cast<TH1 *>(source)))
+  {
+    return false;
+  }
+  m_records.push_back(std::move(record));
+  return true;
+}
+
+//_____________________________________________________________________________
+bool Fun4AllHistoDump::make_record(Record &record, const std::string &name, TH1 *h)
+{
+  const auto *content = dynamic_cast<const TArray *>(h);
+  if (!content)
+  {
+    return false;
+  }
+
+  // histograms with automatic binning keep their first entries in a buffer
+  if (h->GetBuffer())
+  {
+    h->BufferEmpty();
+  }
+  if (content->fN != h->GetNcells())
+  {
+    return false;
+  }
+
+  record.name = name;
+  record.ncells = h->GetNcells();
+  record.entries = h->GetEntries();
+  h->GetStats(record.stats.data());
+
+  const TArrayD *sumw2 = h->GetSumw2N() ? h->GetSumw2() : nullptr;
+  const bool profile = is_profile(h);
+  const TArrayD *binsumw2 = profile ? get_binsumw2(h) : nullptr;
+  record.columns = CONTENT | (sumw2 ? SUMW2 : 0U) | (profile ? BINENTRIES : 0U) | (binsumw2 ? BINSUMW2 : 0U);
+
+  // sparse copy of the non empty cells
+  std::array<double, 4> values{};
+  for (uint32_t cell = 0; cell < record.ncells; ++cell)
+  {
+    size_t ivalue = 0;
+    values[ivalue++] = content->GetAt(cell);
+    if (sumw2)
+    {
+      values[ivalue++] = sumw2->fArray[cell];
+    }
+    if (profile)
+    {
+      values[ivalue++] = get_binentries(h, cell);
+    }
+    if (binsumw2)
+    {
+      values[ivalue++] = binsumw2->fArray[cell];
+    }
+    if (std::any_of(values.begin(), values.begin() + ivalue, [](double value)
+                    { return value != 0; }))
+    {
+      record.cells.push_back(cell);
+      record.values.insert(record.values.end(), values.begin(), values.begin() + ivalue);
+    }
+  }
+
+  // empty clone, for binning and all other histogram properties
+  std::unique_ptr<TH1> clone(static_cast<TH1 *>(h->Clone()));  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+  clone->SetDirectory(nullptr);
+  clone->Reset();
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(clone.get());
+  record.clone.assign(buffer.Buffer(), buffer.Buffer() + buffer.Length());
+  record.binning = axis_signature(h);
+  return true;
+}
+
+//_____________________________________________________________________________
+bool Fun4AllHistoDump::read(const std::string &filename)
+{
+  m_records.clear();
+
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  if (!in)
+  {
+    std::cout << "Fun4AllHistoDump::read - could not open " << filename << std::endl;
+    return false;
+  }
+  std::vector<char> buffer(in.tellg());
+  in.seekg(0);
+  in.read(buffer.data(), buffer.size());
+
+  Reader reader(buffer);
+  std::array<char, 8> file_magic{};
+  uint32_t version = 0;
+  uint32_t nrecords = 0;
+  if (!reader.get(file_magic) || file_magic != magic || !reader.get(version) || version != format_version || !reader.get(nrecords) || nrecords > buffer.size())
+  {
+    std::cout << "Fun4AllHistoDump::read - " << filename << " is not a histogram dump (version " << format_version << ")" << std::endl;
+    return false;
+  }
+
+  m_records.resize(nrecords);
+  for (auto &record : m_records)
+  {
+    uint32_t name_size = 0;
+    uint32_t clone_size = 0;
+    uint32_t binning_size = 0;
+    uint32_t ncells = 0;
+    std::vector<char> name;
+    bool ok = reader.get(name_size) && reader.get(name, name_size) &&
+              reader.get(clone_size) && reader.get(record.clone, clone_size) &&
+              reader.get(binning_size) && reader.get(record.binning, binning_size) &&
+              reader.get(record.ncells) && reader.get(record.columns) && reader.get(ncells) &&
+              reader.get(record.entries) && reader.get(record.stats) &&
+              reader.get(record.cells, ncells) && reader.get(record.values, size_t(ncells) * record.ncolumns());
+    if (!ok)
+    {
+      std::cout << "Fun4AllHistoDump::read - " << filename << " is truncated" << std::endl;
+      m_records.clear();
+      return false;
+    }
+    record.name.assign(name.begin(), name.end());
+  }
+
+  std::sort(m_records.begin(), m_records.end(), [](const Record &lhs, const Record &rhs)
+            { return lhs.name < rhs.name; });
+  return true;
+}
+
+//_____________________________________________________________________________
+bool Fun4AllHistoDump::write(const std::string &filename) const
+{
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "Fun4AllHistoDump::write - could not open " << filename << std::endl;
+    return false;
+  }
+
+  put(out, magic);
+  put(out, format_version);
+  put(out, static_cast<uint32_t>(m_records.size()));
+  for (const auto &record : m_records)
+  {
+    put(out, static_cast<uint32_t>(record.name.size()));
+    out.write(record.name.data(), record.name.size());
+    put(out, static_cast<uint32_t>(record.clone.size()));
+    put(out, record.clone);
+    put(out, static_cast<uint32_t>(record.binning.size()));
+    put(out, record.binning);
+    put(out, record.ncells);
+    put(out, record.columns);
+    put(out, static_cast<uint32_t>(record.cells.size()));
+    put(out, record.entries);
+    put(out, record.stats);
+    put(out, record.cells);
+    put(out, record.values);
+  }
+
+  if (!out)
+  {
+    std::cout << "Fun4AllHistoDump::write - error writing " << filename << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//_____________________________________________________________________________
+bool Fun4AllHistoDump::merge(const Fun4AllHistoDump &other)
+{
+  bool status = true;
+  std::vector<Record> merged;
+  merged.reserve(m_records.size() + other.m_records.size());
+
+  auto iter = m_records.begin();
+  auto other_iter = other.m_records.begin();
+  while (iter != m_records.end() || other_iter != other.m_records.end())
+  {
+    // histograms present on one side only are copied
+    if (other_iter == other.m_records.end() || (iter != m_records.end() && iter->name < other_iter->name))
+    {
+      merged.push_back(std::move(*iter++));
+      continue;
+    }
+    if (iter == m_records.end() || other_iter->name < iter->name)
+    {
+      merged.push_back(*other_iter++);
+      continue;
+    }
+
+    auto &lhs = *iter++;
+    const Record *rhs_ptr = &*other_iter++;
+    if (lhs.ncells != rhs_ptr->ncells || lhs.binning != rhs_ptr->binning)
+    {
+      // different ranges, typically from automatic binning, or different labels. Let ROOT merge them
+      if (!merge_histograms(lhs, *rhs_ptr))
+      {
+        std::cout << "Fun4AllHistoDump::merge - binning mismatch for " << lhs.name << ", not merged" << std::endl;
+        status = false;
+      }
+      merged.push_back(std::move(lhs));
+      continue;
+    }
+
+    // sumw2 present on one side only
+    Record rhs_copy;
+    if (lhs.columns != rhs_ptr->columns)
+    {
+      const uint32_t columns = lhs.columns | rhs_ptr->columns;
+      bool added = add_missing_columns(lhs, columns);
+      if (added && rhs_ptr->columns != columns)
+      {
+        rhs_copy = *rhs_ptr;
+        added = add_missing_columns(rhs_copy, columns);
+        rhs_ptr = &rhs_copy;
+      }
+      if (!added)
+      {
+        std::cout << "Fun4AllHistoDump::merge - histogram type mismatch for " << lhs.name << ", not merged" << std::endl;
+        merged.push_back(std::move(lhs));
+        status = false;
+        continue;
+      }
+    }
+    const auto &rhs = *rhs_ptr;
+
+    // merge the sorted non empty cells
+    const size_t ncolumns = lhs.ncolumns();
+    Record result;
+    result.name = std::move(lhs.name);
+    result.clone = std::move(lhs.clone);
+    result.ncells = lhs.ncells;
+    result.columns = lhs.columns;
+    result.entries = lhs.entries + rhs.entries;
+    for (size_t i = 0; i < nstat; ++i)
+    {
+      result.stats[i] = lhs.stats[i] + rhs.stats[i];
+    }
+    result.cells.reserve(std::max(lhs.cells.size(), rhs.cells.size()));
+    result.values.reserve(std::max(lhs.values.size(), rhs.values.size()));
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < lhs.cells.size() || j < rhs.cells.size())
+    {
+      if (j == rhs.cells.size() || (i < lhs.cells.size() && lhs.cells[i] < rhs.cells[j]))
+      {
+        result.cells.push_back(lhs.cells[i]);
+        result.values.insert(result.values.end(), lhs.values.begin() + i * ncolumns, lhs.values.begin() + (i + 1) * ncolumns);
+        ++i;
+      }
+      else if (i == lhs.cells.size() || rhs.cells[j] < lhs.cells[i])
+      {
+        result.cells.push_back(rhs.cells[j]);
+        result.values.insert(result.values.end(), rhs.values.begin() + j * ncolumns, rhs.values.begin() + (j + 1) * ncolumns);
+        ++j;
+      }
+      else
+      {
+        result.cells.push_back(lhs.cells[i]);
+        for (size_t column = 0; column < ncolumns; ++column)
+        {
+          result.values.push_back(lhs.values[i * ncolumns + column] + rhs.values[j * ncolumns + column]);
+        }
+        ++i;
+        ++j;
+      }
+    }
+    merged.push_back(std::move(result));
+  }
+
+  m_records = std::move(merged);
+  return status;
+}
+
+//_____________________________________________________________________________
+bool Fun4AllHistoDump::merge_histograms(Record &lhs, const Record &rhs)
+{
+  std::unique_ptr<TH1> h(make_histogram(lhs));
+  std::unique_ptr<TH1> other(make_histogram(rhs));
+  if (!h || !other)
+  {
+    return false;
+  }
+  TList list;
+  list.Add(other.get());
+  if (h->Merge(&list) < 0)
+  {
+    return false;
+  }
+  Record result;
+  if (!make_record(result, lhs.name, h.get()))
+  {
+    return false;
+  }
+  lhs = std::move(result);
+  return true;
+}
+
+//_____________________________________________________________________________
+TH1 *Fun4AllHistoDump::make_histogram(const Record &record)
+{
+  TBufferFile buffer(TBuffer::kRead, record.clone.size(), const_cast<char *>(record.clone.data()), false);
+  auto *h = dynamic_cast<TH1 *>(buffer.ReadObject(TH1::Class()));
+  if (!h)
+  {
+    std::cout << "Fun4AllHistoDump::make_histogram - could not read " << record.name << std::endl;
+    return nullptr;
+  }
+  h->SetDirectory(nullptr);
+
+  auto *content = dynamic_cast<TArray *>(h);
+  if (!content || static_cast<uint32_t>(h->GetNcells()) != record.ncells)
+  {
+    std::cout << "Fun4AllHistoDump::make_histogram - inconsistent binning for " << record.name << std::endl;
+    delete h;
+    return nullptr;
+  }
+
+  if ((record.columns & SUMW2) && h->GetSumw2N() == 0)
+  {
+    h->Sumw2();
+  }
+  TArrayD *sumw2 = h->GetSumw2N() ? h->GetSumw2() : nullptr;
+  TArrayD *binsumw2 = nullptr;
+  if (record.columns & BINSUMW2)
+  {
+    binsumw2 = get_binsumw2(h);
+    if (!binsumw2)
+    {
+      // bin entries errors are enabled together with Sumw2 for profiles
+      h->Sumw2();
+      binsumw2 = get_binsumw2(h);
+    }
+  }
+
+  const size_t ncolumns = record.ncolumns();
+  for (size_t i = 0; i < record.cells.size(); ++i)
+  {
+    const int cell = record.cells[i];
+    const double *values = &record.values[i * ncolumns];
+    size_t ivalue = 0;
+    content->SetAt(values[ivalue++], cell);
+    if (record.columns & SUMW2)
+    {
+      const double value = values[ivalue++];
+      if (sumw2)
+      {
+        sumw2->fArray[cell] = value;
+      }
+    }
+    if (record.columns & BINENTRIES)
+    {
+      set_binentries(h, cell, values[ivalue++]);
+    }
+    if (record.columns & BINSUMW2)
+    {
+      const double value = values[ivalue++];
+      if (binsumw2)
+      {
+        binsumw2->fArray[cell] = value;
+      }
+    }
+  }
+
+  // statistics last, setting bin content resets them
+  h->SetEntries(record.entries);
+  auto stats = record.stats;
+  h->PutStats(stats.data());
+  return h;
+}
+
+//_____________________________________________________________________________
+size_t Fun4AllHistoDump::size() const
+{
+  size_t result = 0;
+  for (const auto &record : m_records)
+  {
+    result += sizeof(Record) + record.name.size() + record.clone.size() + record.binning.size() + record.cells.size() * sizeof(uint32_t) + record.values.size() * sizeof(double);
+  }
+  return result;
+}
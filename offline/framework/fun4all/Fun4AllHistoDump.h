@@ -0,0 +1,104 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLHISTODUMP_H
+#define FUN4ALL_FUN4ALLHISTODUMP_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TH1;
+
+/*!
+ * compact binary dump of histograms, written by Fun4AllHistoManager::UseSparseDump
+ * and merged by the fun4all_histomerge tool.
+ *
+ * Each histogram is stored as its streamed, empty clone (binning, titles, axis labels)
+ * followed by the raw content of the non empty cells only:
+ * bin content, sum of weights squared and, for profiles, bin entries and their sum of weights squared.
+ * Merging adds cells and statistics without creating the histograms, as long as their axes are identical.
+ * They are otherwise recreated from the empty clone and merged by ROOT.
+ * TTrees and histograms which are not TH1 derived are not supported.
+ */
+class Fun4AllHistoDump
+{
+ public:
+  static constexpr uint32_t format_version = 2;
+
+  //! file extension of dumps
+  static constexpr const char *file_extension = ".hdump";
+
+  //! size of the statistics array (TH1::GetStats), up to TProfile3D
+  static constexpr size_t nstat = 13;
+
+  //! per cell stored quantities
+  enum Column : uint32_t
+  {
+    CONTENT = 1U << 0U,
+    SUMW2 = 1U << 1U,
+    BINENTRIES = 1U << 2U,
+    BINSUMW2 = 1U << 3U
+  };
+
+  struct Record
+  {
+    //! name under which the histogram is registered, including its directory if any
+    std::string name;
+
+    //! streamed empty clone
+    std::vector<char> clone;
+
+    //! axis definitions, cells are only added when they match
+    std::vector<char> binning;
+
+    uint32_t ncells = 0;
+    uint32_t columns = 0;
+    double entries = 0;
+    std::array<double, nstat> stats{};
+
+    //! sorted indices of non empty cells
+    std::vector<uint32_t> cells;
+
+    //! ncolumns values per non empty cell
+    std::vector<double> values;
+
+    uint32_t ncolumns() const;
+  };
+
+  //! add histogram, must be called in increasing name order. Returns false if not supported
+  bool add(const std::string &name, const TH1 *);
+
+  //! read dump from file, returns false on failure
+  bool read(const std::string &filename);
+
+  //! write dump to file, returns false on failure
+  bool write(const std::string &filename) const;
+
+  //! add content of other dump, histograms are matched by name
+  /**
+   * histograms with identical axes are merged cell by cell. Otherwise (e.g. automatic binning)
+   * they are recreated and merged with TH1::Merge. Returns false if some could not be merged
+   */
+  bool merge(const Fun4AllHistoDump &);
+
+  //! recreate histogram from record. Ownership is passed to the caller
+  static TH1 *make_histogram(const Record &);
+
+  const std::vector<Record> &records() const { return m_records; }
+
+  //! memory used by the dump content, in bytes
+  size_t size() const;
+
+ private:
+  //! fill record from histogram, returns false if not supported
+  static bool make_record(Record &, const std::string &name, TH1 *);
+
+  //! merge two records with different axes through TH1::Merge, returns false on failure
+  static bool merge_histograms(Record &, const Record &);
+
+  //! records, sorted by name
+  std::vector<Record> m_records;
+};
+
+#endif
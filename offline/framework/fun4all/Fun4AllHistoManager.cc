@@ -1,5 +1,6 @@
 #include "Fun4AllHistoManager.h"
 
+#include "Fun4AllHistoDump.h"
 #include "Fun4AllOutputManager.h"
 #include "TDirectoryHelper.h"
 
@@ -117,6 +118,10 @@ int Fun4AllHistoManager::dumpHistos(const std::string &filename, const std::stri
     m_CurrentSegment++;
   }
   m_LastClosedFileName = theoutfile;
+  if (m_SparseDumpFlag)
+  {
+    return dumpSparse(theoutfile);
+  }
   std::filesystem::path pout = theoutfile;
   theoutfile = theoutfile + std::string("?reproducible=") + std::string(pout.filename());
   std::cout << "Fun4AllHistoManager::dump() Writing root file: " <<  m_LastClosedFileName << std::endl;
@@ -194,6 +199,32 @@ int Fun4AllHistoManager::dumpHistos(const std::string &filename, const std::stri
   return iret;
 }
 
+int Fun4AllHistoManager::dumpSparse(const std::string &filename)
+{
+  // the dump is not a ROOT file, it gets its own extension
+  std::filesystem::path dumpfile = filename;
+  dumpfile.replace_extension(Fun4AllHistoDump::file_extension);
+  m_LastClosedFileName = dumpfile.string();
+  std::cout << "Fun4AllHistoManager::dump() Writing histogram dump: " << m_LastClosedFileName << std::endl;
+  int iret = 0;
+  Fun4AllHistoDump dump;
+  for (const auto &[hname, hptr] : Histo)
+  {
+    TH1 *h = dynamic_cast<TH1 *>(hptr);
+    if (!h || !dump.add(hname, h))
+    {
+      std::cout << PHWHERE << " " << hname << " is not a histogram supported by the histogram dump. Won't be saved." << std::endl;
+      iret = -2;
+    }
+  }
+  if (!dump.write(m_LastClosedFileName))
+  {
+    return -1;
+  }
+  RunAfterClosing();
+  return iret;
+}
+
 bool Fun4AllHistoManager::registerHisto(TNamed *h1d, const int replace)
 {
   return registerHisto(h1d->GetName(), h1d, replace);
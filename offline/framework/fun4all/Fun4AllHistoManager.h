@@ -63,9 +63,17 @@ class Fun4AllHistoManager : public Fun4AllBase
   const std::string &LastClosedFileName() const { return m_LastClosedFileName; }
   bool isEmpty() const;
 
+  //! write histograms to a compact binary dump (see Fun4AllHistoDump) instead of a ROOT file
+  //! the output file extension is replaced by .hdump
+  //! dumps are merged with fun4all_histomerge. TTrees are not supported and are not saved
+  void UseSparseDump(bool b = true) { m_SparseDumpFlag = b; }
+
 private:
+  int dumpSparse(const std::string &filename);
+
   bool m_LastEventInitializedFlag{false};
   bool m_UseFileRuleFlag{false};
+  bool m_SparseDumpFlag{false};
   int m_CurrentSegment{0};
   int m_EventRollover{0};
   int m_LastEventNumber{std::numeric_limits<int>::max()};
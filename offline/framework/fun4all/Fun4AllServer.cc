@@ -12,6 +12,7 @@
 #include "SubsysReco.h"
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHEventArena.h>
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHNodeReset.h>
@@ -576,7 +577,9 @@ int Fun4AllServer::process_event()
       ffamemtracker->Start(timer_name, "SubsysReco");
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
+      PHEventArena::SetScope(Subsystem.first->Name());
       int retcode = Subsystem.first->process_event(Subsystem.second);
+      PHEventArena::SetScope("");
       std::cout.copyfmt(m_saved_cout_state); // restore cout to default formatting
 #ifdef FFAMEMTRACKER
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
@@ -824,6 +827,8 @@ int Fun4AllServer::ResetNodeTree()
       }
     }
   }
+  // all per event objects are gone, the event arena can be reused
+  PHEventArena::Reset();
   return 0;  // anything except 0 would abort the event loop in pmonitor
 }
 
@@ -1206,6 +1211,7 @@ int Fun4AllServer::End()
     std::cout << "*******************************************************************************" << std::endl;
     std::cout << "*******************************************************************************" << std::endl;
   }
+  PHEventArena::Print();
 
   return i;
 }
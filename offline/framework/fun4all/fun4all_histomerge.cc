@@ -0,0 +1,249 @@
+// merge histogram dumps written by Fun4AllHistoManager::UseSparseDump
+// by parallel tree reduction, into a ROOT file or another dump
+//
+// fun4all_histomerge [-j nthreads] -o output.root input1.hdump input2.hdump ...
+// fun4all_histomerge [-j nthreads] -o output.hdump @list_of_inputs.txt
+
+#include "Fun4AllHistoDump.h"
+#include "TDirectoryHelper.h"
+
+#include <TFile.h>
+#include <TH1.h>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  void usage()
+  {
+    std::cout << "usage: fun4all_histomerge [-j nthreads] -o <output.root|output.hdump> <inputs|@filelist>" << std::endl;
+  }
+
+  //! peak resident memory, in MB
+  double peak_memory()
+  {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.;
+  }
+
+  //! work queue of the tree reduction
+  class Reduction
+  {
+   public:
+    explicit Reduction(const std::vector<std::string> &files)
+      : m_files(files.begin(), files.end())
+    {
+    }
+
+    void run(unsigned int nthreads)
+    {
+      std::vector<std::thread> threads;
+      for (unsigned int i = 0; i < nthreads; ++i)
+      {
+        threads.emplace_back([this]()
+                             { work(); });
+      }
+      for (auto &thread : threads)
+      {
+        thread.join();
+      }
+    }
+
+    std::unique_ptr<Fun4AllHistoDump> result()
+    {
+      if (!m_partial.empty())
+      {
+        return std::move(m_partial.front());
+      }
+      return m_files.empty() ? std::make_unique<Fun4AllHistoDump>() : load(m_files.front());
+    }
+
+    int errors() const { return m_errors; }
+
+   private:
+    std::unique_ptr<Fun4AllHistoDump> load(const std::string &filename)
+    {
+      auto dump = std::make_unique<Fun4AllHistoDump>();
+      if (!dump->read(filename))
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_errors;
+      }
+      return dump;
+    }
+
+    //! take one item, merged dumps first to limit memory
+    std::unique_ptr<Fun4AllHistoDump> pop(std::string &filename)
+    {
+      if (!m_partial.empty())
+      {
+        auto dump = std::move(m_partial.back());
+        m_partial.pop_back();
+        return dump;
+      }
+      filename = m_files.front();
+      m_files.pop_front();
+      return nullptr;
+    }
+
+    void work()
+    {
+      while (true)
+      {
+        std::string first_file;
+        std::string second_file;
+        std::unique_ptr<Fun4AllHistoDump> first;
+        std::unique_ptr<Fun4AllHistoDump> second;
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_condition.wait(lock, [this]()
+                           { return m_files.size() + m_partial.size() >= 2 || m_busy == 0; });
+          if (m_files.size() + m_partial.size() < 2)
+          {
+            // nothing left to pair, and nobody will produce anything
+            m_condition.notify_all();
+            return;
+          }
+          first = pop(first_file);
+          second = pop(second_file);
+          ++m_busy;
+        }
+
+        // file reading and merging are done outside of the lock
+        if (!first)
+        {
+          first = load(first_file);
+        }
+        if (!second)
+        {
+          second = load(second_file);
+        }
+        const bool ok = first->merge(*second);
+        second.reset();
+
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if (!ok)
+          {
+            ++m_errors;
+          }
+          m_partial.push_back(std::move(first));
+          --m_busy;
+        }
+        m_condition.notify_all();
+      }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::string> m_files;
+    std::vector<std::unique_ptr<Fun4AllHistoDump>> m_partial;
+    int m_busy = 0;
+    int m_errors = 0;
+  };
+
+  //! write histograms to a ROOT file, in their directories
+  bool write_root(const Fun4AllHistoDump &dump, const std::string &filename)
+  {
+    TFile out(filename.c_str(), "RECREATE");
+    if (!out.IsOpen())
+    {
+      std::cout << "fun4all_histomerge - could not open " << filename << std::endl;
+      return false;
+    }
+    out.SetCompressionSettings(505);
+
+    bool status = true;
+    for (const auto &record : dump.records())
+    {
+      std::unique_ptr<TH1> h(Fun4AllHistoDump::make_histogram(record));
+      if (!h)
+      {
+        status = false;
+        continue;
+      }
+      out.cd();
+      const auto pos = record.name.find_last_of('/');
+      if (pos != std::string::npos)
+      {
+        const std::string dirname = record.name.substr(0, pos);
+        TDirectoryHelper::mkdir(&out, dirname);
+        out.cd(dirname.c_str());
+      }
+      h->Write();
+    }
+    out.Close();
+    return status;
+  }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  unsigned int nthreads = std::max(1U, std::thread::hardware_concurrency());
+  std::string output;
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "-j" && i + 1 < argc)
+    {
+      nthreads = std::max(1, std::atoi(argv[++i]));
+    }
+    else if (arg == "-o" && i + 1 < argc)
+    {
+      output = argv[++i];
+    }
+    else if (arg.starts_with('@'))
+    {
+      std::ifstream list(arg.substr(1));
+      std::string filename;
+      while (list >> filename)
+      {
+        inputs.push_back(filename);
+      }
+    }
+    else
+    {
+      inputs.push_back(arg);
+    }
+  }
+  if (output.empty() || inputs.empty())
+  {
+    usage();
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  Reduction reduction(inputs);
+  reduction.run(nthreads);
+  const auto merged = reduction.result();
+  const auto merge_end = std::chrono::steady_clock::now();
+
+  const bool ok = output.ends_with(".root") ? write_root(*merged, output) : merged->write(output);
+  const auto end = std::chrono::steady_clock::now();
+
+  std::cout << "fun4all_histomerge - merged " << inputs.size() << " dumps, "
+            << merged->records().size() << " histograms with " << nthreads << " threads" << std::endl;
+  std::cout << "fun4all_histomerge - merge time: " << std::chrono::duration<double>(merge_end - start).count() << " s"
+            << ", write time: " << std::chrono::duration<double>(end - merge_end).count() << " s"
+            << ", peak memory: " << peak_memory() << " MB" << std::endl;
+  if (reduction.errors())
+  {
+    std::cout << "fun4all_histomerge - " << reduction.errors() << " errors" << std::endl;
+  }
+  return (ok && !reduction.errors()) ? 0 : 1;
+}
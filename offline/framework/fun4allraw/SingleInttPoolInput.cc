@@ -174,7 +174,9 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
       auto packet_id = pool->getIdentifier();
       if (pool->depth_ok())
       {
-        int num_hits = pool->iValue(0, "NR_HITS");
+        // decoded hits, BCOs and FEEs are read directly from the pool
+        const auto &hits = pool->get_hits();
+        int num_hits = hits.size();
         if (Verbosity() > 1)
         {
           std::cout << "Number of Hits: " << num_hits << " for packet "
@@ -191,13 +193,11 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
             std::cout << "INTT Pool with GL1 BCO " << std::endl;
           }
         }
-        int numBCOs = pool->iValue(0, "NR_BCOS");
         uint64_t largest_bco = 0;
         bool skipthis{true};
 
-        for (int j = 0; j < numBCOs; j++)
+        for (uint64_t bco : pool->get_bco_list())
         {
-          uint64_t bco = pool->lValue(j, "BCOLIST");
           largest_bco = std::max(largest_bco, bco);
           if (bco < minBCO)
           {
@@ -212,14 +212,10 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
           m_BclkStackPacketMap[packet_id].insert(bco);
         }
 
-        int nFEEs = pool->iValue(0, "UNIQUE_FEES");
-        for (int j = 0; j < nFEEs; j++)
+        for (const auto &[fee, bcos] : pool->get_bcos_by_fee())
         {
-          int fee = pool->iValue(j, "FEE_ID");
-          int nbcos = pool->iValue(fee, "FEE_BCOS");
-          for (int k = 0; k < nbcos; k++)
+          for (uint64_t bco : bcos)
           {
-            uint64_t bco = pool->lValue(fee, k, "BCOVAL");
             if (bco < minBCO)
             {
               continue;
@@ -243,7 +239,8 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
         {
           for (int j = 0; j < num_hits; j++)
           {
-            uint64_t gtm_bco = pool->lValue(j, "BCO");
+            const auto &hit = hits[j];
+            uint64_t gtm_bco = hit.bco;
 
             bool found{false};
             static uint64_t const header = 0xcadead;
@@ -288,19 +285,19 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
               continue;
             }
             auto newhit = std::make_unique<InttRawHitv2>();
-            int FEE = pool->iValue(j, "FEE");
+            int FEE = hit.fee;
             newhit->set_packetid(pool->getIdentifier());
             newhit->set_fee(FEE);
             newhit->set_bco(gtm_bco);
-            newhit->set_adc(pool->iValue(j, "ADC"));
-            newhit->set_amplitude(pool->iValue(j, "AMPLITUDE"));
-            newhit->set_chip_id(pool->iValue(j, "CHIP_ID"));
-            newhit->set_channel_id(pool->iValue(j, "CHANNEL_ID"));
-            newhit->set_word(pool->iValue(j, "DATAWORD"));
-            newhit->set_FPHX_BCO(pool->iValue(j, "FPHX_BCO"));
-            newhit->set_full_FPHX(pool->iValue(j, "FULL_FPHX"));
-            newhit->set_full_ROC(pool->iValue(j, "FULL_ROC"));
-            newhit->set_event_counter(pool->iValue(j, "EVENT_COUNTER"));
+            newhit->set_adc(hit.adc);
+            newhit->set_amplitude(hit.amplitude);
+            newhit->set_chip_id(hit.chip_id);
+            newhit->set_channel_id(hit.channel_id);
+            newhit->set_word(hit.word);
+            newhit->set_FPHX_BCO(hit.FPHX_BCO);
+            newhit->set_full_FPHX(hit.full_FPHX);
+            newhit->set_full_ROC(hit.full_ROC);
+            newhit->set_event_counter(hit.event_counter);
             gtm_bco += m_Rollover[FEE];
 
             if (gtm_bco < m_PreviousClock[FEE])
@@ -18,6 +18,7 @@
 
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <ranges>
@@ -26,6 +27,43 @@
 #include <utility>  // for pair
 #include <vector>
 
+namespace
+{
+  //! most frequent FEM clock of a packet, the smallest clock wins ties
+  /**
+   * returns the number of modules carrying this clock, 0 if the packet has no module.
+   * A packet has only a handful of FEMs, sorting them is much cheaper than filling a map
+   */
+  int majority_femclk(Packet* pkt, uint16_t& majority_clk)
+  {
+    const int nmod = pkt->iValue(0, "NRMODULES");
+    if (nmod <= 0)
+    {
+      return 0;
+    }
+    std::vector<uint16_t> clocks(nmod);
+    for (int j = 0; j < nmod; ++j)
+    {
+      clocks[j] = static_cast<uint16_t>(pkt->iValue(j, "FEMCLOCK"));
+    }
+    std::sort(clocks.begin(), clocks.end());
+
+    int majority_count = 0;
+    for (auto iter = clocks.begin(); iter != clocks.end();)
+    {
+      const auto next = std::upper_bound(iter, clocks.end(), *iter);
+      const int count = static_cast<int>(next - iter);
+      if (count > majority_count)
+      {
+        majority_count = count;
+        majority_clk = *iter;
+      }
+      iter = next;
+    }
+    return majority_count;
+  }
+}  // namespace
+
 SingleTriggeredInput::SingleTriggeredInput(const std::string& name)
   : Fun4AllBase(name)
 {
@@ -75,20 +113,9 @@ bool SingleTriggeredInput::CheckFemDiffIdx(int pid, size_t index, const std::deq
 
   auto get_majority_femclk = [](Packet* pkt) -> uint16_t
   {
-    int nmod = pkt->iValue(0, "NRMODULES");
-    std::map<uint16_t, int> counts;
-    for (int j = 0; j < nmod; ++j)
-    {
-      uint16_t clk = static_cast<uint16_t>(pkt->iValue(j, "FEMCLOCK"));
-      counts[clk]++;
-    }
-    if (counts.empty())
-    {
-      return std::numeric_limits<uint16_t>::max();
-    }
-    return std::max_element(counts.begin(), counts.end(), [](const auto& a, const auto& b)
-                            { return a.second < b.second; })
-        ->first;
+    uint16_t clk = std::numeric_limits<uint16_t>::max();
+    majority_femclk(pkt, clk);
+    return clk;
   };
 
   uint16_t clk_prev = get_majority_femclk(pkt_prev);
@@ -1025,6 +1052,7 @@ void SingleTriggeredInput::CreateDSTNodes(Event* evt)
         detNode->addNode(newNode);
       }
     }
+    m_CaloPacketMap[packet_id] = calopacket;
     m_PacketShiftOffset.try_emplace(packet_id, 0);
     delete piter;
   }
@@ -1049,29 +1077,17 @@ bool SingleTriggeredInput::FemClockAlignment(int pid, const std::deque<Event*>&
       continue;
     }
 
-    int nmod = pkt->iValue(0, "NRMODULES");
-    std::map<int, int> clk_count;
-
-    for (int j = 0; j < nmod; ++j)
-    {
-      int femclk = static_cast<uint16_t>(pkt->iValue(j, "FEMCLOCK"));
-      clk_count[femclk]++;
-    }
-
+    uint16_t femclk = 0;
+    int majority_count = majority_femclk(pkt, femclk);
     delete pkt;
 
-    if (clk_count.empty())
+    if (majority_count == 0)
     {
       continue;
     }
 
-    int majority_clk = std::max_element(
-                           clk_count.begin(), clk_count.end(),
-                           [](const auto& a, const auto& b)
-                           { return a.second < b.second; })
-                           ->first;
-
-    if (clk_count[majority_clk] < 2)
+    int majority_clk = femclk;
+    if (majority_count < 2)
     {
       std::cout << Name() << ": FemClockAlignment — no majority FEM clocks for packet " << pid << " at pool index " << i << std::endl;
       return false;
@@ -1104,6 +1120,27 @@ int SingleTriggeredInput::FemEventNrClockCheck(OfflinePacket* pkt)
   }
   // make sure all clocks of the FEM are fine,
   int nrModules = calopkt->iValue(0, "NRMODULES");
+  if (nrModules <= 0)
+  {
+    return 0;
+  }
+  // this runs for every packet of every event, handle the common case
+  // of identical event numbers without building the set
+  int femevtnr = calopkt->iValue(0, "FEMEVTNR");
+  bool unique_femevtnr = true;
+  for (int j = 1; j < nrModules; j++)
+  {
+    if (calopkt->iValue(j, "FEMEVTNR") != femevtnr)
+    {
+      unique_femevtnr = false;
+      break;
+    }
+  }
+  if (unique_femevtnr)
+  {
+    m_FEMEventNrSet.insert(femevtnr);
+    return 0;
+  }
   std::set<int> EventNoSet;
   for (int j = 0; j < nrModules; j++)
   {
@@ -1262,7 +1299,8 @@ int SingleTriggeredInput::ReadEvent()
       return -1;
     }
 
-    CaloPacket* newhit = findNode::getClass<CaloPacket>(m_topNode, packet_id);
+    auto calopacketiter = m_CaloPacketMap.find(packet_id);
+    CaloPacket* newhit = (calopacketiter != m_CaloPacketMap.end()) ? calopacketiter->second : findNode::getClass<CaloPacket>(m_topNode, packet_id);
     newhit->Reset();
     if (m_DitchPackets.contains(packet_id) && m_DitchPackets[packet_id].contains(0))
     {
@@ -1346,6 +1384,10 @@ int SingleTriggeredInput::ReadEvent()
 
   for (auto& [pid, idx_set] : m_DitchPackets)
   {
+    if (idx_set.empty())
+    {
+      continue;
+    }
     std::set<int> new_set;
     for (int idx : idx_set)
     {
@@ -20,6 +20,7 @@
 #include <unordered_set>
 #include <vector>
 
+class CaloPacket;
 class Event;
 class Eventiterator;
 class OfflinePacket;
@@ -106,6 +107,7 @@ class SingleTriggeredInput : public Fun4AllBase, public InputFileHandler
   bool m_KeepPacketsFlag{false};
   bool m_packetclk_copy_runs{false};
   int64_t eventcounter{0};
+  std::map<int, CaloPacket *> m_CaloPacketMap;  // packet nodes, saves the node tree search for every packet of every event
   std::set<int> m_CorrectCopiedClockPackets;
   std::map<int, std::set<int>> m_DitchPackets;
   std::set<int> m_FEMEventNrSet;
@@ -75,6 +75,7 @@ int intt_pool::addPacket(Packet *p)
   
 
   int nw;
+  reserve(p->getDataLength());
 //  int status  = p->fillIntArray( (int *) &packetData[writeindex], p->getDataLength(), &nw,  "DATA");
   p->fillIntArray( (int *) &packetData[writeindex], p->getDataLength(), &nw,  "DATA");
 
@@ -85,6 +86,51 @@ int intt_pool::addPacket(Packet *p)
   return 0;
 }
 
+void intt_pool::reserve(const int nwords)
+{
+  if (writeindex + nwords <= _allocated_size)
+  {
+    return;
+  }
+
+  // drop the data already decoded. This is only done when space is needed, rather than at every next()
+  if (currentpos > 0)
+  {
+    memmove(packetData, &packetData[currentpos], (writeindex - currentpos) * sizeof(unsigned int));
+    writeindex -= currentpos;
+    currentpos = 0;
+  }
+
+  // grow the buffer if still needed
+  if (writeindex + nwords > _allocated_size)
+  {
+    const int size = std::max(2 * _allocated_size, writeindex + nwords);
+    unsigned int *newData = new unsigned int[size];
+    memcpy(newData, packetData, writeindex * sizeof(unsigned int));
+    delete[] packetData;
+    packetData = newData;
+    _allocated_size = size;
+  }
+}
+
+const std::vector<intt_pool::intt_hit> &intt_pool::get_hits()
+{
+  intt_decode();
+  return intt_hits;
+}
+
+const std::set<unsigned long long> &intt_pool::get_bco_list()
+{
+  intt_decode();
+  return BCO_List;
+}
+
+const std::map<unsigned int, std::set<unsigned long long>> &intt_pool::get_bcos_by_fee()
+{
+  intt_decode();
+  return BCOs_by_FEE;
+}
+
 unsigned int intt_pool::rawValue(const int fee, const int index)
 {
   if (fee < 0 || fee >= MAX_FEECOUNT)
@@ -282,7 +328,7 @@ long long intt_pool::lValue(const int hit, const int field)
   switch (field)
   {
   case F_BCO:
-    return intt_hits[hit]->bco;
+    return intt_hits[hit].bco;
     break;
 
   default:
@@ -358,43 +404,43 @@ int intt_pool::iValue(const int hit, const int field)
   switch (field)
   {
   case F_FEE:
-    return intt_hits[hit]->fee;
+    return intt_hits[hit].fee;
     break;
 
   case F_CHANNEL_ID:
-    return intt_hits[hit]->channel_id;
+    return intt_hits[hit].channel_id;
     break;
 
   case F_CHIP_ID:
-    return intt_hits[hit]->chip_id;
+    return intt_hits[hit].chip_id;
     break;
 
   case F_ADC:
-    return intt_hits[hit]->adc;
+    return intt_hits[hit].adc;
     break;
 
   case F_FPHX_BCO:
-    return intt_hits[hit]->FPHX_BCO;
+    return intt_hits[hit].FPHX_BCO;
     break;
 
   case F_FULL_FPHX:
-    return intt_hits[hit]->full_FPHX;
+    return intt_hits[hit].full_FPHX;
     break;
 
   case F_FULL_ROC:
-    return intt_hits[hit]->full_ROC;
+    return intt_hits[hit].full_ROC;
     break;
 
   case F_AMPLITUDE:
-    return intt_hits[hit]->amplitude;
+    return intt_hits[hit].amplitude;
     break;
 
   case F_EVENT_COUNTER:
-    return intt_hits[hit]->event_counter;
+    return intt_hits[hit].event_counter;
     break;
 
   case F_DATAWORD:
-    return intt_hits[hit]->word;
+    return intt_hits[hit].word;
     break;
 
   default:
@@ -429,16 +475,6 @@ int intt_pool::next()
 
 
 
-  std::vector<intt_hit *>::const_iterator hit_itr;
-
-  //  coutfl << "deleting " << intt_hits.size() << " hits"  << std::endl;
-
-  for (hit_itr = intt_hits.begin(); hit_itr != intt_hits.end(); ++hit_itr)
-  {
-    //      coutfl << "deleting 0x" << std::hex << (*hit_itr)->bco << std::dec << std::endl;
-    delete (*hit_itr);
-  }
-
   intt_hits.clear();
   BCO_List.clear();
 
@@ -454,15 +490,8 @@ int intt_pool::next()
   FEEs_by_BCO.clear();
   BCOs_by_FEE.clear();
 
-  // now move the remaining stuff to the start of the array
-  //coutfl << " current_pos: " << currentpos << " writeindex " << writeindex << std::endl;
-
-  unsigned int l = (writeindex - currentpos) * sizeof(unsigned int);
-  memcpy(packetData, &packetData[currentpos], l);
-  writeindex -= currentpos;
-  currentpos = 0;
-
-  //coutfl << " current_pos: " << currentpos << " writeindex " << writeindex << std::endl;
+  // the remaining data stays in place. It is moved to the start of the array
+  // only when room is needed for new packets, in reserve()
 
   return 0;
 }
@@ -484,7 +513,8 @@ int intt_pool::intt_decode ()
   unsigned int index = currentpos;
   
 
-  unsigned int *buffer =   &packetData[currentpos];
+  // index runs from currentpos, since packetData is not shifted at every next()
+  unsigned int *buffer =   packetData;
 
   while ( index < payload_length -1)
     {
@@ -509,11 +539,8 @@ int intt_pool::intt_decode ()
 
 
 
-      for ( int i = 0; i < len ; i++)
-	{
-	  //coutfl << "adding to ladder " << fee << "  " << std::hex << buffer[index] << std::dec << std::endl;
-	  fee_data[fee].push_back(buffer[index++]);
-	}
+      fee_data[fee].insert(fee_data[fee].end(), &buffer[index], &buffer[index + len]);
+      index += len;
 
       if ( payload_length - index < 100  && buffer[index-1] == 0xcafeff80 )
 	{
@@ -579,8 +606,10 @@ int intt_pool::intt_decode ()
 
       //      int go_on = 0;
       int header_found = 0;
-      
-      std::vector<unsigned int> hitlist;
+
+      // hitlists are decoded in place, from the first word of the current one
+      const unsigned int *data = fee_data[fee].data();
+      int hitlist_start = 0;
       int j = 0;
       
 
@@ -588,7 +617,7 @@ int intt_pool::intt_decode ()
 	{
 	  
 	  //skip until we have found the first header
-	  if (! header_found &&  (fee_data[fee][j] & 0xff00ffff )!= 0xad00cade )
+	  if (! header_found &&  (data[j] & 0xff00ffff )!= 0xad00cade )
 	    {
 	      j++;
 	      continue;
@@ -596,12 +625,12 @@ int intt_pool::intt_decode ()
 	  header_found = 1;
 
 	  // here j points to a "cade" word
+	  hitlist_start = j;
 
-	  // push back the cdae word, the BCO, and event counter
+	  // skip the cdae word, the BCO, and event counter
 	  if ( end_here -j >=3 )
 	    {
-	      for ( int k = 0; k < 3; k++) { hitlist.push_back(fee_data[fee][j++]);
-}
+	      j += 3;
 	    }
 	  else
 	    {
@@ -614,35 +643,32 @@ int intt_pool::intt_decode ()
 	    {
 	      
 	      // we break here if find the next header or a footer
-	      if ( ( fee_data[fee][j] & 0xff00ffff ) == 0xad00cade )
+	      if ( ( data[j] & 0xff00ffff ) == 0xad00cade )
 		{
 		  header_found  = 0;
+		  // we have a full hitlist here
+		  if (verbosity > 1)
+		    {
+		      coutfl << "calling decode for FEE " << fee << " with size " << j - hitlist_start << std::endl;
+		    }
+		  intt_decode_hitlist (&data[hitlist_start], j - hitlist_start, fee);
 		  j--;
-		  // we have a full hitlist in the vector here
-		  coutfl << "calling decode for FEE " << fee << " with size " << hitlist.size() << std::endl;
-		  intt_decode_hitlist (hitlist, fee);
-		  hitlist.clear();
 		  break;
 		}
 	      
 	      
-	      if ( fee_data[fee][j] == 0xcafeff80 )
+	      if ( data[j] == 0xcafeff80 )
 		{
-		  // we have a full hitlist in the vector here
-		  //		  coutfl << "calling decode for FEE " << fee << " with size " << hitlist.size() << std::endl;
-		  intt_decode_hitlist (hitlist, fee);
-		  hitlist.clear();
+		  // we have a full hitlist here
+		  intt_decode_hitlist (&data[hitlist_start], j - hitlist_start, fee);
 		  j++;
 		  break;
 		}
 	      
-	      hitlist.push_back(fee_data[fee][j]);
-
 	      j++;
 	    }
 	}
 
-      hitlist.clear();
       //coutfl << " end of fee_data for FEE " << fee << " size: " << fee_data[fee].size() << " position : " << j << std::endl;
 
       fee_data[fee].erase(fee_data[fee].begin(), fee_data[fee].begin() + j);
@@ -671,7 +697,7 @@ unsigned long long intt_pool::calcBCO(const unsigned int *hitlist) const
 }
 
 
-int intt_pool::intt_decode_hitlist(std::vector<unsigned int> &hitlist, const int fee)
+int intt_pool::intt_decode_hitlist(const unsigned int *hitlist, const size_t size, const int fee)
 {
    //  coutfl << " next hitlist, size " << hitlist.size() << " :" << std::endl;
 
@@ -681,7 +707,7 @@ int intt_pool::intt_decode_hitlist(std::vector<unsigned int> &hitlist, const int
    //   }
    // std::cout << std::endl;
 
-  if (hitlist.size() < 3)
+  if (size < 3)
   {
     coutfl << "hitlist too short " << std::endl;
     return 1;
@@ -707,10 +733,10 @@ int intt_pool::intt_decode_hitlist(std::vector<unsigned int> &hitlist, const int
   BCOs_by_FEE[fee].insert(BCO);
 
 //  int count = 0;
-  for (unsigned int i = 3; i < hitlist.size(); i++)
+  for (size_t i = 3; i < size; i++)
   {
     unsigned int x = hitlist[i];
-    intt_hit *hit = new intt_hit;
+    intt_hit *hit = &intt_hits.emplace_back();
     hit->event_counter = event_counter;
     hit->fee = fee;
     hit->bco = BCO;
@@ -739,7 +765,6 @@ int intt_pool::intt_decode_hitlist(std::vector<unsigned int> &hitlist, const int
 
 
     //    coutfl << "count " << count << "  " << hit->bco << std::endl;  
-    intt_hits.push_back(hit);
 //    count++;
   }
   // coutfl << "pushed back " << count  << " hits for FEE " << fee << " with BCO 0x" << std::hex << BCO << std::dec
@@ -52,11 +52,35 @@ public:
   void Name(const std::string &n) {name = n;}
   const std::string &Name() const {return name;}
 
+  struct intt_hit
+  {
+    uint64_t bco;
+    uint16_t fee;
+    uint16_t channel_id;
+    uint16_t chip_id;
+    uint16_t adc;
+    uint16_t FPHX_BCO;
+    uint16_t full_FPHX;
+    uint16_t full_ROC;
+    uint16_t amplitude;
+    uint16_t full_fphx;
+    uint32_t event_counter;
+    uint32_t word;
+  };
+
+  // direct access to the decoded data, valid until next()
+  const std::vector<intt_hit> &get_hits();
+  const std::set<unsigned long long> &get_bco_list();
+  const std::map<unsigned int, std::set<unsigned long long>> &get_bcos_by_fee();
+
 
 protected:
   int intt_decode ();
 
-  int intt_decode_hitlist (std::vector<unsigned int> & /*hitlist*/ , const int /*fee*/);
+  int intt_decode_hitlist (const unsigned int * /*hitlist*/, const size_t /*size*/, const int /*fee*/);
+
+  // move the data not yet decoded to the start of packetData, and make room for nwords more
+  void reserve(const int nwords);
 
   unsigned long long calcBCO(const unsigned int *hitlist) const;
 
@@ -72,29 +96,12 @@ protected:
   int currentpos {0};
   int writeindex {0};
 
-  struct intt_hit
-  {
-    uint64_t bco;
-    uint16_t fee;
-    uint16_t channel_id;
-    uint16_t chip_id;
-    uint16_t adc;
-    uint16_t FPHX_BCO;
-    uint16_t full_FPHX;
-    uint16_t full_ROC;
-    uint16_t amplitude;
-    uint16_t full_fphx;
-    uint32_t event_counter;
-    uint32_t word;
-  };
-
-    
   //std::vector<unsigned int> packetData;
   unsigned int * packetData;
   int _allocated_size{0};
 
   std::vector<unsigned int> fee_data[MAX_FEECOUNT];
-  std::vector<intt_hit *> intt_hits;
+  std::vector<intt_hit> intt_hits;
 
   std::array<unsigned int,MAX_FEECOUNT> last_index{};
   std::map<unsigned int, uint64_t> last_bco;
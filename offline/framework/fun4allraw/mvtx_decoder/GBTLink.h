@@ -17,6 +17,7 @@
 #include "InteractionRecord.h"
 #include "StrobeData.h"
 
+#include <bit>
 #include <iostream>
 #include <memory>
 #include <iomanip>
@@ -116,13 +117,11 @@ struct GBTLink
 
   void addHit(const uint8_t laneId, const uint8_t bc, uint8_t reg, const uint16_t addr)
   {
-    auto* hit = new mvtx_hit();
+    auto& hit = mTrgData.back().hit_vector.emplace_back();
 
-    hit->chip_id = laneId;
-    hit->bunchcounter = bc;
-    getRowCol(reg, addr, hit->row_pos, hit->col_pos);
-
-    mTrgData.back().hit_vector.push_back(hit);
+    hit.chip_id = laneId;
+    hit.bunchcounter = bc;
+    getRowCol(reg, addr, hit.row_pos, hit.col_pos);
   }
 
   void check_APE(const uint8_t& chipId, const uint8_t& dataC)
@@ -321,7 +320,18 @@ inline GBTLink::CollectedDataStatus GBTLink::collectROFCableData(/*const Mapping
       for (int i = 0; i < n_gbt_cnt; ++i)
       {
         auto &gbtWord = gbtWords[i];
-        if (gbtWord.isIHW()) // ITS HEADER WORD
+        if (gbtWord.isData()) //IS IB DATA, tested first since it is by far the most frequent word
+        {
+          if (! header_found )
+          {
+            log_error << "Trigger header not found before chip data. skipping data" << std::endl;
+            clearCableData();
+            continue;
+          }
+          auto lane = (gbtWord.data8[9] & 0x1F) % 3;
+          cableData[lane].add(gbtWord.getW8(), 9);
+        }
+        else if (gbtWord.isIHW()) // ITS HEADER WORD
         {
           //TODO assert first word after RDH and active lanes
           if (! ((!gbtWord.activeLanes) ||
@@ -400,17 +410,6 @@ inline GBTLink::CollectedDataStatus GBTLink::collectROFCableData(/*const Mapping
             std::cout << " lane_error_id: " << gbtWord.lane_error_id;
             std::cout << " diasnotic_data: 0x" << std::hex << gbtWord.diagnostic_data << std::endl;
         }
-        else if (gbtWord.isData()) //IS IB DATA
-        {
-          if (! header_found )
-          {
-            log_error << "Trigger header not found before chip data. skipping data" << std::endl;
-            clearCableData();
-            continue;
-          }
-          auto lane = (gbtWord.data8[9] & 0x1F) % 3;
-          cableData[lane].add(gbtWord.getW8(), 9);
-        }
 
         if (prev_evt_complete)
         {
@@ -555,14 +554,11 @@ inline int GBTLink::decode_lane(const uint8_t chipId, PayLoadCont& buffer)
             continue;
           }
           addHit(laneId, bc, reg, addr);
+          // bit i of the hit map flags a hit at addr + i + 1. Only loop over bits set
           while(hit_map != 0x00)
           {
-            ++addr;
-            if (hit_map & 0x1)
-            {
-              addHit(laneId, bc, reg, addr);
-            }
-            hit_map >>= 1;
+            addHit(laneId, bc, reg, addr + 1 + std::countr_zero(hit_map));
+            hit_map &= (hit_map - 1);
           }
         }
         else if ((dataC & 0xF0) == 0xB0) // CHIP TRAILER
@@ -28,7 +28,7 @@ namespace mvtx
     GBTCalibDataWord calWord = {};
     uint32_t detectorField = 0;
 
-    std::vector<mvtx_hit *> hit_vector = {};
+    std::vector<mvtx_hit> hit_vector = {};
   };
 
 } // namespace mvtx
@@ -348,7 +348,7 @@ long long int mvtx_pool::get_TRG_IR_BCO(const uint16_t iLnk, const uint32_t inde
 }
 
 //_________________________________________________
-std::vector<mvtx::mvtx_hit *>& mvtx_pool::get_hits(const int feeId, const int i_strb)
+const std::vector<mvtx::mvtx_hit>& mvtx_pool::get_hits(const int feeId, const int i_strb)
 {
   return mGBTLinks[mFeeId2LinkID[feeId].entry].mTrgData[i_strb].hit_vector;
 }
@@ -449,22 +449,22 @@ int mvtx_pool::iValue(const int i_feeid, const int i_trg, const int i_hit, const
   if ( strcmp(what, "HIT_CHIP_ID") == 0 )
   {
     return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->chip_id : -1;
+                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit].chip_id : -1;
   }
   if ( strcmp(what, "HIT_BC") == 0 )
   {
     return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->bunchcounter : -1;
+                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit].bunchcounter : -1;
   }
   if ( strcmp(what, "HIT_ROW") == 0 )
   {
     return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->row_pos : -1;
+                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit].row_pos : -1;
   }
   if ( strcmp(what, "HIT_COL") == 0 )
   {
     return ( (i_hit >= 0) && (hit < mGBTLinks[lnkId].mTrgData[trg].hit_vector.size()) ) ? \
-                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit]->col_pos : -1;
+                     mGBTLinks[lnkId].mTrgData[trg].hit_vector[hit].col_pos : -1;
   }
   
       std::cout << "Unknow option " << what << std::endl;
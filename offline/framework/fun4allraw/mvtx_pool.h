@@ -42,8 +42,8 @@ class mvtx_pool {
 
   long long int lValue(const int, const int, const char* what);
 
-  std::vector<mvtx::mvtx_hit*>& get_hits(const int feeId,
-                                         const int i_strb);
+  const std::vector<mvtx::mvtx_hit>& get_hits(const int feeId,
+                                              const int i_strb);
 
   void set_verbosity(const int val) { verbosity = val; }
   int  get_verbosity() { return verbosity; }
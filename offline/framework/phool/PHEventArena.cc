@@ -0,0 +1,228 @@
+#include "PHEventArena.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <new>
+#include <thread>
+
+char *PHEventArena::m_base = nullptr;
+size_t PHEventArena::m_capacity = 0;
+unsigned int PHEventArena::m_max_pinned_events = PHEventArena::default_max_pinned_events;
+int PHEventArena::verbose = 0;
+
+namespace
+{
+  // allocations are aligned to 16 bytes, like malloc
+  constexpr size_t alignment = 16;
+
+  // arena state, only modified by the owner thread except for the live counter
+  std::thread::id owner;
+  size_t offset = 0;
+  size_t high_water = 0;
+  std::atomic<long> live{0};
+  bool full_warning = true;
+  unsigned long skipped_resets = 0;
+
+  // consecutive events the arena could not be rewound, and whether it is bypassed because of it
+  unsigned int pinned_events = 0;
+  bool pinned = false;
+
+  //! allocation statistics of one module
+  struct Counters
+  {
+    unsigned long arena = 0;
+    unsigned long heap = 0;
+  };
+
+  bool count_allocations = false;
+  std::map<std::string, Counters> counters;
+  Counters *current = nullptr;
+  std::atomic<unsigned long> other_threads{0};
+
+  bool is_owner()
+  {
+    return std::this_thread::get_id() == owner;
+  }
+}  // namespace
+
+//_________________________________________________________________
+bool PHEventArena::Enable(size_t capacity)
+{
+  if (m_base)
+  {
+    std::cout << "PHEventArena::Enable - already enabled" << std::endl;
+    return true;
+  }
+
+  // reserve address space only, pages are committed on first use
+  void *mapped = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mapped == MAP_FAILED)
+  {
+    std::cout << "PHEventArena::Enable - could not reserve " << capacity << " bytes, using the heap" << std::endl;
+    return false;
+  }
+  m_base = static_cast<char *>(mapped);
+  m_capacity = capacity;
+  owner = std::this_thread::get_id();
+  offset = 0;
+  if (verbose > 0)
+  {
+    std::cout << "PHEventArena::Enable - reserved " << (capacity >> 20U) << " MB" << std::endl;
+  }
+  return true;
+}
+
+//_________________________________________________________________
+void *PHEventArena::Allocate(size_t size)
+{
+  if (!is_owner())
+  {
+    if (count_allocations)
+    {
+      ++other_threads;
+    }
+    return ::operator new(size);
+  }
+
+  if (m_base && !pinned)
+  {
+    const size_t aligned = (size + alignment - 1) & ~(alignment - 1);
+    if (offset + aligned <= m_capacity)
+    {
+      void *ptr = m_base + offset;
+      offset += aligned;
+      ++live;
+      if (current)
+      {
+        ++current->arena;
+      }
+      return ptr;
+    }
+
+    if (full_warning)
+    {
+      std::cout << "PHEventArena::Allocate - arena full (" << (m_capacity >> 20U) << " MB), using the heap" << std::endl;
+      full_warning = false;
+    }
+  }
+
+  if (current)
+  {
+    ++current->heap;
+  }
+  return ::operator new(size);
+}
+
+//_________________________________________________________________
+void PHEventArena::Deallocate(void *ptr, size_t size)
+{
+  const char *address = static_cast<const char *>(ptr);
+  if (m_base && address >= m_base && address < m_base + m_capacity)
+  {
+    --live;
+    return;
+  }
+  ::operator delete(ptr, size);
+}
+
+//_________________________________________________________________
+void PHEventArena::Reset()
+{
+  if (!m_base || !is_owner())
+  {
+    return;
+  }
+
+  high_water = std::max(high_water, offset);
+  if (live == 0)
+  {
+    if (pinned)
+    {
+      std::cout << "PHEventArena::Reset - all arena objects are gone, using the arena again" << std::endl;
+    }
+    offset = 0;
+    pinned_events = 0;
+    pinned = false;
+    return;
+  }
+
+  ++skipped_resets;
+  ++pinned_events;
+  if (verbose > 0)
+  {
+    std::cout << "PHEventArena::Reset - " << live << " objects still alive, arena not rewound (" << (offset >> 20U) << " MB used)" << std::endl;
+  }
+
+  // objects kept across events (leaked, or created outside the event loop) would otherwise make the arena grow every event
+  if (!pinned && pinned_events >= m_max_pinned_events)
+  {
+    std::cout << "PHEventArena::Reset - " << live << " objects kept the arena from being rewound for "
+              << pinned_events << " events (" << (offset >> 20U) << " MB used), using the heap until they are deleted" << std::endl;
+    pinned = true;
+  }
+}
+
+//_________________________________________________________________
+void PHEventArena::CountAllocations(bool value)
+{
+  if (value && !m_base)
+  {
+    // no arena, but the statistics are still collected on this thread
+    owner = std::this_thread::get_id();
+  }
+  count_allocations = value;
+  current = value ? &counters[""] : nullptr;
+}
+
+//_________________________________________________________________
+void PHEventArena::SetScope(const std::string &name)
+{
+  if (count_allocations)
+  {
+    current = &counters[name];
+  }
+}
+
+//_________________________________________________________________
+void PHEventArena::Print(std::ostream &os)
+{
+  if (!m_base && !count_allocations)
+  {
+    return;
+  }
+
+  os << "PHEventArena - " << (m_base ? "enabled" : "disabled");
+  if (m_base)
+  {
+    os << ", high water mark: " << (std::max(high_water, offset) >> 10U) << " kB"
+       << ", events not rewound: " << skipped_resets;
+    if (pinned)
+    {
+      os << ", bypassed: " << live << " objects alive";
+    }
+  }
+  os << std::endl;
+
+  if (!count_allocations)
+  {
+    return;
+  }
+
+  os << std::setw(40) << std::left << "module" << std::right
+     << std::setw(16) << "arena" << std::setw(16) << "heap" << std::endl;
+  for (const auto &[name, counter] : counters)
+  {
+    if (counter.arena == 0 && counter.heap == 0)
+    {
+      continue;
+    }
+    os << std::setw(40) << std::left << (name.empty() ? "(outside modules)" : name) << std::right
+       << std::setw(16) << counter.arena << std::setw(16) << counter.heap << std::endl;
+  }
+  os << std::setw(40) << std::left << "(other threads)" << std::right
+     << std::setw(16) << 0 << std::setw(16) << other_threads << std::endl;
+}
@@ -0,0 +1,79 @@
+#ifndef PHOOL_PHEVENTARENA_H
+#define PHOOL_PHEVENTARENA_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+//! opt-in per event memory arena for small, short lived objects (hits, clusters, seeds, track states)
+//! Objects are carved out of a single reserved address range with a bump pointer,
+//! delete is a no-op and the whole range is rewound by Fun4AllServer::ResetNodeTree
+//! once all objects allocated in the event are gone.
+//! If some arena objects survive the event (e.g. they are kept on a node which is not reset)
+//! the arena is not rewound. After max_pinned_events such events in a row new objects are taken from the heap,
+//! the arena is used again once all its objects are gone.
+//! Only the thread which enabled the arena allocates from it, other threads use the heap.
+//!
+//! Classes opt in with PHEVENTARENA_OPERATORS in their public section,
+//! the ROOT streaming is unchanged.
+//!
+//! Usage, in the macro, before any reconstruction module is registered:
+//! `PHEventArena::Enable();`
+//! `PHEventArena::CountAllocations();` // optional, per module statistics printed at the End
+class PHEventArena
+{
+ public:
+  //! default reserved address space. Pages are only committed when used
+  static constexpr size_t default_capacity = size_t(256) << 20U;
+
+  //! default number of events in a row the arena may stay pinned by live objects before falling back to the heap
+  static constexpr unsigned int default_max_pinned_events = 5;
+
+  //! reserve address space and start allocating from the arena
+  static bool Enable(size_t capacity = default_capacity);
+  static bool IsEnabled() { return m_base != nullptr; }
+
+  //! allocate memory for an object, from the arena if enabled
+  static void *Allocate(size_t size);
+
+  //! release memory. No-op for arena memory
+  static void Deallocate(void *ptr, size_t size);
+
+  //! end of event. Rewind the arena if no arena object is left
+  static void Reset();
+
+  //! number of events in a row the arena may stay pinned before new objects are taken from the heap
+  static void SetMaxPinnedEvents(unsigned int n) { m_max_pinned_events = n; }
+
+  //!@name instrumentation
+  //@{
+
+  //! count allocations per module, printed with Print
+  static void CountAllocations(bool value = true);
+
+  //! set module name allocations are attributed to. Empty for allocations outside modules
+  static void SetScope(const std::string &name);
+
+  //! print arena usage and allocation statistics, if enabled. Called by Fun4AllServer::End
+  static void Print(std::ostream &os = std::cout);
+  //@}
+
+  static void Verbosity(const int iverb) { verbose = iverb; }
+  static int Verbosity() { return verbose; }
+
+ private:
+  static char *m_base;
+  static size_t m_capacity;
+  static unsigned int m_max_pinned_events;
+
+  static int verbose;
+};
+
+//! class level operators to allocate objects of a given class from the event arena
+#define PHEVENTARENA_OPERATORS                                                                                  \
+  static void *operator new(size_t size) { return PHEventArena::Allocate(size); }                              \
+  static void *operator new(size_t /*size*/, void *ptr) { return ptr; }                                         \
+  static void operator delete(void *ptr, size_t size) { PHEventArena::Deallocate(ptr, size); }                 \
+  static void operator delete(void * /*ptr*/, void * /*place*/) {}
+
+#endif
@@ -10,6 +10,7 @@
 #include <TBranch.h>  // for TBranch
 #include <TBranchElement.h>
 #include <TBranchObject.h>
+#include <TBufferFile.h>
 #include <TClass.h>
 #include <TDirectory.h>  // for TDirectory
 #include <TFile.h>
@@ -63,6 +64,7 @@ PHNodeIOManager::~PHNodeIOManager()
 
 void PHNodeIOManager::closeFile()
 {
+  StopWriter();
   if (file)
   {
     if (accessMode == PHWrite || accessMode == PHUpdate)
@@ -71,6 +73,12 @@ void PHNodeIOManager::closeFile()
     }
     file->Close();
   }
+  // the tree is gone with the file, the writer branch addresses can be deleted now
+  for (auto& iter : m_WriterObjects)
+  {
+    delete iter.second;
+  }
+  m_WriterObjects.clear();
 }
 
 bool PHNodeIOManager::setFile(const std::string& f, const std::string& title,
@@ -147,7 +155,26 @@ bool PHNodeIOManager::write(PHCompositeNode* topNode)
   // be filled.
   if (file && tree)
   {
-    tree->Fill();
+    if (m_MaxInFlight > 0)
+    {
+      std::unique_lock<std::mutex> lock(m_WriterMutex);
+      if (!m_Writer.joinable())
+      {
+        // the event thread keeps using ROOT while the writer fills the tree
+        ROOT::EnableThreadSafety();
+        m_StopWriter = false;
+        m_Writer = std::thread(&PHNodeIOManager::WriterLoop, this);
+      }
+      m_EventWritten.wait(lock, [this]
+                          { return m_EventQueue.size() + (m_WriterBusy ? 1 : 0) < m_MaxInFlight; });
+      m_EventQueue.push_back(std::move(m_CurrentEvent));
+      m_CurrentEvent.clear();
+      m_EventQueued.notify_one();
+    }
+    else
+    {
+      tree->Fill();
+    }
     eventNumber++;
     return true;
   }
@@ -159,22 +186,37 @@ bool PHNodeIOManager::write(TObject** data, const std::string& path, int nodebuf
 {
   if (file && tree)
   {
+    int use_splitlevel = splitlevel;
+    int use_buffersize = buffersize;
+    // the buffersize and splitlevel are set on the first call
+    // when the branch is created, the values come from the caller
+    // which is the node which writes itself
+    if (splitlevel == std::numeric_limits<int>::min())
+    {
+      use_splitlevel = nodesplitlevel;
+    }
+    if (buffersize == std::numeric_limits<int>::min())
+    {
+      use_buffersize = nodebuffersize;
+    }
+    if (m_MaxInFlight > 0)
+    {
+      // snapshot the object, the node is free to be reset once we return
+      // this is what TObject::Clone does, without the read back
+      NodeSnapshot snapshot;
+      snapshot.path = path;
+      snapshot.objclass = (*data)->IsA();
+      snapshot.buffer = std::make_unique<TBufferFile>(TBuffer::kWrite);
+      snapshot.buffer->MapObject(*data);
+      (*data)->Streamer(*snapshot.buffer);
+      snapshot.buffersize = use_buffersize;
+      snapshot.splitlevel = use_splitlevel;
+      m_CurrentEvent.push_back(std::move(snapshot));
+      return true;
+    }
     TBranch* thisBranch = tree->GetBranch(path.c_str());
     if (!thisBranch)
     {
-      int use_splitlevel = splitlevel;
-      int use_buffersize = buffersize;
-      // the buffersize and splitlevel are set on the first call
-      // when the branch is created, the values come from the caller
-      // which is the node which writes itself
-      if (splitlevel == std::numeric_limits<int>::min())
-      {
-        use_splitlevel = nodesplitlevel;
-      }
-      if (buffersize == std::numeric_limits<int>::min())
-      {
-        use_buffersize = nodebuffersize;
-      }
       tree->Branch(path.c_str(), (*data)->ClassName(),
                    data, use_buffersize, use_splitlevel);
     }
@@ -546,9 +588,81 @@ bool PHNodeIOManager::SetCompressionSetting(const int level)
   return true;
 }
 
+void PHNodeIOManager::Flush()
+{
+  std::unique_lock<std::mutex> lock(m_WriterMutex);
+  m_EventWritten.wait(lock, [this]
+                      { return m_EventQueue.empty() && !m_WriterBusy; });
+}
+
+void PHNodeIOManager::StopWriter()
+{
+  if (!m_Writer.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_WriterMutex);
+    m_StopWriter = true;
+  }
+  m_EventQueued.notify_one();
+  // the writer empties the queue before it exits
+  m_Writer.join();
+}
+
+void PHNodeIOManager::WriterLoop()
+{
+  while (true)
+  {
+    EventSnapshot event;
+    {
+      std::unique_lock<std::mutex> lock(m_WriterMutex);
+      m_EventQueued.wait(lock, [this]
+                         { return m_StopWriter || !m_EventQueue.empty(); });
+      if (m_EventQueue.empty())
+      {
+        return;
+      }
+      event = std::move(m_EventQueue.front());
+      m_EventQueue.pop_front();
+      m_WriterBusy = true;
+    }
+    FillSnapshot(event);
+    {
+      std::lock_guard<std::mutex> lock(m_WriterMutex);
+      m_WriterBusy = false;
+    }
+    m_EventWritten.notify_all();
+  }
+}
+
+void PHNodeIOManager::FillSnapshot(EventSnapshot& event)
+{
+  for (auto& snapshot : event)
+  {
+    // every branch has its own object which the snapshot is streamed back into,
+    // nodes which are not written in this event keep their previous content
+    // like in the synchronous mode
+    TObject*& obj = m_WriterObjects[snapshot.path];
+    if (!obj)
+    {
+      obj = static_cast<TObject*>(snapshot.objclass->New());
+      tree->Branch(snapshot.path.c_str(), snapshot.objclass->GetName(),
+                   &obj, snapshot.buffersize, snapshot.splitlevel);
+    }
+    snapshot.buffer->SetReadMode();
+    snapshot.buffer->ResetMap();
+    snapshot.buffer->SetBufferOffset(0);
+    snapshot.buffer->MapObject(obj);
+    obj->Streamer(*snapshot.buffer);
+  }
+  tree->Fill();
+}
+
 uint64_t
 PHNodeIOManager::GetBytesWritten()
 {
+  Flush();
   if (file)
   {
     return file->GetBytesWritten();
@@ -559,6 +673,7 @@ PHNodeIOManager::GetBytesWritten()
 uint64_t
 PHNodeIOManager::GetFileSize()
 {
+  Flush();
   if (file)
   {
     return file->GetSize();
@@ -9,14 +9,22 @@
 
 #include "phool.h"
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 class PHCompositeNode;
 class TBranch;
+class TBufferFile;
+class TClass;
 class TFile;
 class TObject;
 class TTree;
@@ -59,7 +67,32 @@ class PHNodeIOManager : public PHIOManager
   
   void DisableReadCache();
 
+  //! asynchronous writing: the node contents are streamed into memory buffers
+  //! when write() is called, filling the tree (serialization and compression)
+  //! is done by a background thread. At most maxinflight events are buffered,
+  //! write() blocks when this limit is reached. 0 (default) writes synchronously
+  void AsyncWrite(const unsigned int maxinflight) { m_MaxInFlight = maxinflight; }
+  unsigned int AsyncWrite() const { return m_MaxInFlight; }
+
+  //! wait until all buffered events are in the tree
+  void Flush();
+
 private:
+  //! snapshot of one node, streamed on the event thread
+  struct NodeSnapshot
+  {
+    std::string path;
+    TClass *objclass{nullptr};
+    std::unique_ptr<TBufferFile> buffer;
+    int buffersize{0};
+    int splitlevel{0};
+  };
+  using EventSnapshot = std::vector<NodeSnapshot>;
+
+  void WriterLoop();
+  void FillSnapshot(EventSnapshot &event);
+  void StopWriter();
+
   int FillBranchMap();
   PHCompositeNode *reconstructNodeTree(PHCompositeNode *);
   bool readEventFromFile(size_t requestedEvent);
@@ -76,6 +109,18 @@ private:
   int splitlevel{std::numeric_limits<int>::min()};
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
+
+  // asynchronous writing
+  unsigned int m_MaxInFlight{0};
+  EventSnapshot m_CurrentEvent;
+  std::deque<EventSnapshot> m_EventQueue;
+  std::map<std::string, TObject *> m_WriterObjects;  // branch addresses used by the writer thread
+  std::thread m_Writer;
+  std::mutex m_WriterMutex;
+  std::condition_variable m_EventQueued;
+  std::condition_variable m_EventWritten;
+  bool m_WriterBusy{false};
+  bool m_StopWriter{false};
 };
 
 #endif
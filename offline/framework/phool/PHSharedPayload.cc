@@ -0,0 +1,157 @@
+#include "PHSharedPayload.h"
+#include "recoConsts.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+int PHSharedPayload::verbose(0);
+
+PHSharedPayload::~PHSharedPayload()
+{
+  if (m_mapped)
+  {
+    munmap(m_mapped, m_mapped_size);
+  }
+}
+
+std::unique_ptr<PHSharedPayload> PHSharedPayload::Get(const std::string &key, const Builder &builder)
+{
+  std::string storedir;
+  recoConsts *rc = recoConsts::instance();
+  if (rc->FlagExist("PAYLOAD_STORE_DIR"))
+  {
+    storedir = rc->get_StringFlag("PAYLOAD_STORE_DIR");
+  }
+
+  // no store, keep payload in process memory
+  if (storedir.empty())
+  {
+    return Build(builder);
+  }
+
+  std::unique_ptr<PHSharedPayload> payload(new PHSharedPayload);
+  std::error_code ec;
+  std::filesystem::create_directories(storedir, ec);
+  const std::string filename = storedir + "/" + key;
+  if (payload->attach(filename))
+  {
+    return payload;
+  }
+
+  // serialize builders on this node, so that only the first process materializes the payload
+  // and the others wait for it to be available
+  int lockfd = open((filename + ".lock").c_str(), O_RDWR | O_CREAT, 0666);
+  if (lockfd >= 0)
+  {
+    flock(lockfd, LOCK_EX);
+  }
+
+  if (!payload->attach(filename))
+  {
+    if (verbose)
+    {
+      std::cout << "PHSharedPayload::Get - building " << filename << std::endl;
+    }
+    payload->m_buffer = builder();
+
+    // write to temporary file and rename, so that readers never see a partially written file
+    const std::string tmpname = filename + ".tmp." + std::to_string(getpid());
+    bool written = false;
+    {
+      std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+      if (out)
+      {
+        out.write(payload->m_buffer.data(), payload->m_buffer.size());
+        written = out.good();
+      }
+    }
+    if (written && std::rename(tmpname.c_str(), filename.c_str()) == 0 && payload->attach(filename))
+    {
+      // drop the private copy, use the shared pages from now on
+      std::vector<char>().swap(payload->m_buffer);
+    }
+    else
+    {
+      std::cout << "PHSharedPayload::Get - could not write " << filename << ", using process memory" << std::endl;
+      std::remove(tmpname.c_str());
+      payload->m_data = payload->m_buffer.data();
+      payload->m_size = payload->m_buffer.size();
+    }
+  }
+
+  if (lockfd >= 0)
+  {
+    flock(lockfd, LOCK_UN);
+    close(lockfd);
+  }
+  return payload;
+}
+
+std::unique_ptr<PHSharedPayload> PHSharedPayload::Build(const Builder &builder)
+{
+  std::unique_ptr<PHSharedPayload> payload(new PHSharedPayload);
+  payload->m_buffer = builder();
+  payload->m_data = payload->m_buffer.data();
+  payload->m_size = payload->m_buffer.size();
+  return payload;
+}
+
+bool PHSharedPayload::attach(const std::string &filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat st
+  {
+  };
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+  void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    return false;
+  }
+  m_mapped = mapped;
+  m_mapped_size = st.st_size;
+  m_data = static_cast<const char *>(mapped);
+  m_size = st.st_size;
+  if (verbose)
+  {
+    std::cout << "PHSharedPayload::attach - attached " << filename << " (" << m_size << " bytes)" << std::endl;
+  }
+  return true;
+}
+
+std::string PHSharedPayload::MakeKey(const std::string &name, const std::string &inputfile)
+{
+  // include size and modification time, so that a modified input file gets a new entry
+  std::ostringstream keystring;
+  keystring << name << ":" << inputfile;
+  struct stat st
+  {
+  };
+  if (stat(inputfile.c_str(), &st) == 0)
+  {
+    keystring << ":" << st.st_size << ":" << st.st_mtime;
+  }
+
+  std::ostringstream out;
+  out << std::hex << std::hash<std::string>{}(keystring.str());
+  return std::filesystem::path(inputfile).stem().string() + "_" + out.str() + ".payload";
+}
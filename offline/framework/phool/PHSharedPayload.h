@@ -0,0 +1,70 @@
+#ifndef PHOOL_PHSHAREDPAYLOAD_H
+#define PHOOL_PHSHAREDPAYLOAD_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! node local store for large read-only run level payloads (field maps, ...)
+//! The payload is kept as a position independent binary blob in a memory mapped file.
+//! The first process which asks for a given key builds the blob and writes it to the store,
+//! all other processes on the node attach to the same pages read-only.
+//! The store is enabled by setting the recoConsts string flag PAYLOAD_STORE_DIR
+//! to a node local directory (e.g. /dev/shm/sphenix), otherwise the blob is kept in process memory.
+//!
+//! `auto payload = PHSharedPayload::Get(key, [&]() { return build_blob(); });`
+class PHSharedPayload
+{
+ public:
+  using Builder = std::function<std::vector<char>()>;
+
+  ~PHSharedPayload();
+
+  PHSharedPayload(const PHSharedPayload &) = delete;
+  PHSharedPayload &operator=(const PHSharedPayload &) = delete;
+
+  //! get payload for given key, calling builder if it is not found in the store
+  //! the key must uniquely identify the content (input file, parameters, format version)
+  static std::unique_ptr<PHSharedPayload> Get(const std::string &key, const Builder &builder);
+
+  //! build payload in process memory, bypassing the store
+  //! used as fallback when the payload found in the store does not validate
+  static std::unique_ptr<PHSharedPayload> Build(const Builder &builder);
+
+  //! start of payload
+  const char *data() const { return m_data; }
+
+  //! payload size in bytes
+  size_t size() const { return m_size; }
+
+  //! true if the payload is attached from the node local store
+  bool is_shared() const { return m_mapped != nullptr; }
+
+  //! key hash used as file name in the store, combining the key with size and modification time of input file
+  static std::string MakeKey(const std::string &name, const std::string &inputfile);
+
+  static void Verbosity(const int iverb) { verbose = iverb; }
+  static int Verbosity() { return verbose; }
+
+ private:
+  PHSharedPayload() = default;
+
+  //! attach store file read-only, returns false if not available
+  bool attach(const std::string &filename);
+
+  //! payload owned by this process, if not shared
+  std::vector<char> m_buffer;
+
+  //! mapped file, if shared
+  void *m_mapped = nullptr;
+  size_t m_mapped_size = 0;
+
+  const char *m_data = nullptr;
+  size_t m_size = 0;
+
+  static int verbose;
+};
+
+#endif
@@ -46,6 +46,17 @@ static const std::map<CaloTowerDefs::DetectorSystem, std::string> nodemap{
     {CaloTowerDefs::HCALOUT, "HCALPackets"},
     {CaloTowerDefs::ZDC, "ZDCPackets"},
     {CaloTowerDefs::SEPD, "SEPDPackets"}};
+
+namespace
+{
+  // CaloPacket has typed accessors, which skip the string comparisons of iValue(n, "what")
+  bool is_suppressed(CaloPacket *packet, int channel) { return packet->getSuppressed(channel); }
+  bool is_suppressed(Packet *packet, int channel) { return packet->iValue(channel, "SUPPRESSED"); }
+  int get_pre(CaloPacket *packet, int channel) { return static_cast<int>(packet->getPre(channel)); }
+  int get_pre(Packet *packet, int channel) { return packet->iValue(channel, "PRE"); }
+  int get_post(CaloPacket *packet, int channel) { return static_cast<int>(packet->getPost(channel)); }
+  int get_post(Packet *packet, int channel) { return packet->iValue(channel, "POST"); }
+}  // namespace
 //____________________________________________________________________________..
 CaloTowerBuilder::CaloTowerBuilder(const std::string &name)
   : SubsysReco(name)
@@ -184,12 +195,13 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
 int CaloTowerBuilder::process_sim()
 {
   std::vector<std::vector<float>> waveforms;
+  waveforms.reserve(m_CalowaveformContainer->size());
 
   for (int ich = 0; ich < (int) m_CalowaveformContainer->size(); ich++)
   {
     TowerInfo *towerinfo = m_CalowaveformContainer->get_tower_at_channel(ich);
-    std::vector<float> waveform;
-    waveform.reserve(m_nsamples);
+    // filled in place, no copy into the waveform vector
+    std::vector<float> &waveform = waveforms.emplace_back();
     bool fillwaveform = true;
     // get key
     if (m_dotbtszs)
@@ -209,13 +221,12 @@ int CaloTowerBuilder::process_sim()
     }
     if (fillwaveform)
     {
+      waveform.reserve(m_nsamples);
       for (int samp = 0; samp < m_nsamples; samp++)
       {
         waveform.push_back(towerinfo->get_waveform_value(samp));
       }
     }
-    waveforms.push_back(waveform);
-    waveform.clear();
   }
 
   std::vector<std::vector<float>> processed_waveforms = WaveformProcessing->process_waveform(waveforms);
@@ -226,13 +237,15 @@ int CaloTowerBuilder::process_sim()
     TowerInfo *towerwaveform = m_CalowaveformContainer->get_tower_at_channel(i);
     TowerInfo *towerinfo = m_CaloInfoContainer->get_tower_at_channel(i);
     towerinfo->copy_tower(towerwaveform);
-    towerinfo->set_time(processed_waveforms.at(i).at(1));
-    towerinfo->set_energy(processed_waveforms.at(i).at(0));
-    towerinfo->set_time(processed_waveforms.at(i).at(1));
-    towerinfo->set_pedestal(processed_waveforms.at(i).at(2));
-    towerinfo->set_chi2(processed_waveforms.at(i).at(3));
-    bool SZS = isSZS(processed_waveforms.at(i).at(1), processed_waveforms.at(i).at(3));
-    if (processed_waveforms.at(i).at(4) == 0)
+    const std::vector<float> &result = processed_waveforms.at(i);
+    const std::vector<float> &waveform = waveforms.at(i);
+    towerinfo->set_time(result.at(1));
+    towerinfo->set_energy(result.at(0));
+    towerinfo->set_time(result.at(1));
+    towerinfo->set_pedestal(result.at(2));
+    towerinfo->set_chi2(result.at(3));
+    bool SZS = isSZS(result.at(1), result.at(3));
+    if (result.at(4) == 0)
     {
       towerinfo->set_isRecovered(false);
     }
@@ -240,16 +253,16 @@ int CaloTowerBuilder::process_sim()
     {
       towerinfo->set_isRecovered(true);
     }
-    towerinfo->set_FitStatus(static_cast<bool>(processed_waveforms.at(i).at(5)));
-    int n_samples = waveforms.at(i).size();
+    towerinfo->set_FitStatus(static_cast<bool>(result.at(5)));
+    int n_samples = waveform.size();
     if (n_samples == m_nzerosuppsamples || SZS)
     {
       towerinfo->set_isZS(true);
     }
     for (int j = 0; j < n_samples; j++)
     {
-      towerinfo->set_waveform_value(j, waveforms.at(i).at(j));
-      if (std::round(waveforms.at(i).at(j)) >= m_saturation)
+      towerinfo->set_waveform_value(j, waveform[j]);
+      if (std::round(waveform[j]) >= m_saturation)
       {
         towerinfo->set_isSaturated(true);
       }
@@ -316,13 +329,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
           {
             continue;
           }
-          std::vector<float> waveform;
-          waveform.reserve(m_nzerosuppsamples);
-          for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-          {
-            waveform.push_back(-1);
-          }
-          waveforms.push_back(waveform);
+          waveforms.emplace_back(m_nzerosuppsamples, -1);
         }
         return Fun4AllReturnCodes::EVENT_OK;
       }
@@ -357,36 +364,28 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
               for (int iskip = 0; iskip < 64; iskip++)
               {
                 n_pad_skip_mask++;
-                std::vector<float> waveform;
-                waveform.reserve(m_nsamples);
-
-                for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-                {
-                  waveform.push_back(0);
-                }
-                waveforms.push_back(waveform);
-                waveform.clear();
+                waveforms.emplace_back(m_nzerosuppsamples, 0);
               }
             }
           }
         }
 
-        std::vector<float> waveform;
-        waveform.reserve(m_nsamples);
-        if (packet->iValue(channel, "SUPPRESSED"))
+        // filled in place, no copy into the waveform vector
+        std::vector<float> &waveform = waveforms.emplace_back();
+        if (is_suppressed(packet, channel))
         {
-          waveform.push_back(packet->iValue(channel, "PRE"));
-          waveform.push_back(packet->iValue(channel, "POST"));
+          waveform.reserve(2);
+          waveform.push_back(get_pre(packet, channel));
+          waveform.push_back(get_post(packet, channel));
         }
         else
         {
+          waveform.resize(m_nsamples);
           for (int samp = 0; samp < m_nsamples; samp++)
           {
-            waveform.push_back(packet->iValue(samp, channel));
+            waveform[samp] = packet->iValue(samp, channel);
           }
         }
-        waveforms.push_back(waveform);
-        waveform.clear();
       }
 
       int nch_padded = nchannels;
@@ -402,15 +401,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
           {
             continue;
           }
-          std::vector<float> waveform;
-          waveform.reserve(m_nsamples);
-
-          for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-          {
-            waveform.push_back(0);
-          }
-          waveforms.push_back(waveform);
-          waveform.clear();
+          waveforms.emplace_back(m_nzerosuppsamples, 0);
         }
       }
     }
@@ -422,19 +413,16 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
         {
           continue;
         }
-        std::vector<float> waveform;
-        waveform.reserve(2);
-        for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-        {
-          waveform.push_back(-1);  // push back -1 for missing packets
-        }
-        waveforms.push_back(waveform);
-        waveform.clear();
+        waveforms.emplace_back(m_nzerosuppsamples, -1);  // push back -1 for missing packets
       }
     }
     return Fun4AllReturnCodes::EVENT_OK;
   };
 
+  if (m_packet_high >= m_packet_low)
+  {
+    waveforms.reserve(static_cast<size_t>(m_packet_high - m_packet_low + 1) * m_nchannels);
+  }
   for (int pid = m_packet_low; pid <= m_packet_high; pid++)
   {
     if (!m_PacketNodesFlag)
@@ -498,14 +486,16 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
       idx = cdbttree_sepd_map->GetIntValue(i, m_fieldname);
     }
     TowerInfo *towerinfo = m_CaloInfoContainer->get_tower_at_channel(i);
-    towerinfo->set_time(processed_waveforms.at(idx).at(1));
-    towerinfo->set_energy(processed_waveforms.at(idx).at(0));
-    towerinfo->set_time(processed_waveforms.at(idx).at(1));
-    towerinfo->set_pedestal(processed_waveforms.at(idx).at(2));
-    towerinfo->set_chi2(processed_waveforms.at(idx).at(3));
-    bool SZS = isSZS(processed_waveforms.at(idx).at(1), processed_waveforms.at(idx).at(3));
-
-    if (processed_waveforms.at(idx).at(4) == 0)
+    const std::vector<float> &result = processed_waveforms.at(idx);
+    const std::vector<float> &waveform = waveforms.at(idx);
+    towerinfo->set_time(result.at(1));
+    towerinfo->set_energy(result.at(0));
+    towerinfo->set_time(result.at(1));
+    towerinfo->set_pedestal(result.at(2));
+    towerinfo->set_chi2(result.at(3));
+    bool SZS = isSZS(result.at(1), result.at(3));
+
+    if (result.at(4) == 0)
     {
       towerinfo->set_isRecovered(false);
     }
@@ -513,11 +503,11 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
     {
       towerinfo->set_isRecovered(true);
     }
-    towerinfo->set_FitStatus(static_cast<bool>(processed_waveforms.at(idx).at(5)));
-    int n_samples = waveforms.at(idx).size();
+    towerinfo->set_FitStatus(static_cast<bool>(result.at(5)));
+    int n_samples = waveform.size();
     if (n_samples == m_nzerosuppsamples || SZS)
     {
-      if (waveforms.at(idx).at(0) == -1)
+      if (waveform.at(0) == -1)
       {
         towerinfo->set_isNotInstr(true);
       }
@@ -529,11 +519,11 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
 
     for (int j = 0; j < n_samples; j++)
     {
-      if (std::round(waveforms.at(idx).at(j)) >= m_saturation)
+      if (std::round(waveform[j]) >= m_saturation)
       {
         towerinfo->set_isSaturated(true);
       }
-      towerinfo->set_waveform_value(j, waveforms.at(idx).at(j));
+      towerinfo->set_waveform_value(j, waveform[j]);
     }
   }
   waveforms.clear();
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <utility>
 
 static ROOT::TThreadExecutor *t = new ROOT::TThreadExecutor(1);  // NOLINT(misc-use-anonymous-namespace)
 double CaloWaveformFitting::template_function(double *x, double *par)
@@ -56,7 +57,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vecto
   {
     waveformvector.at(i).push_back(i);
   }
-  fitresults = calo_processing_templatefit(waveformvector);
+  fitresults = calo_processing_templatefit(std::move(waveformvector));
   return fitresults;
 }
 
@@ -12,6 +12,7 @@
 #include <limits>
 #include <memory>  // for allocator_traits<>::value_type
 #include <string>
+#include <utility>
 
 namespace
 {
@@ -80,17 +81,25 @@ void CaloWaveformProcessing::initialize_processing()
   }
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::vector<std::vector<float>> waveformvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(const std::vector<std::vector<float>> &waveformvector)
 {
   unsigned int size1 = waveformvector.size();
   std::vector<std::vector<float>> fitresults;
   if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
   {
+    // the template fit works in place on its input, it gets the only copy of the waveforms.
+    // Room is reserved for the channel index and the 6 fit results appended to each waveform
+    std::vector<std::vector<float>> chnlvector;
+    chnlvector.reserve(size1);
     for (unsigned int i = 0; i < size1; i++)
     {
-      waveformvector.at(i).push_back((float) i);
+      const std::vector<float> &v = waveformvector.at(i);
+      std::vector<float> &vfit = chnlvector.emplace_back();
+      vfit.reserve(v.size() + 7);
+      vfit.assign(v.begin(), v.end());
+      vfit.push_back((float) i);
     }
-    fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
+    fitresults = m_Fitter->calo_processing_templatefit(std::move(chnlvector));
   }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
@@ -96,7 +96,7 @@ class CaloWaveformProcessing : public SubsysReco
     _doubleexp_ratio = ratio;
   }
 
-  std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
   std::vector<std::vector<float>> calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector);
 
   void initialize_processing();
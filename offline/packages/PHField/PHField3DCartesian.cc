@@ -1,5 +1,6 @@
 #include "PHField3DCartesian.h"
 
+#include <phool/PHSharedPayload.h>
 #include <phool/phool.h>
 
 #include <TDirectory.h>  // for TDirectory, gDirectory
@@ -11,13 +12,61 @@
 
 #include <boost/stacktrace.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <set>
+#include <sstream>
 #include <utility>
+#include <vector>
+
+namespace
+{
+  // layout of the field map payload:
+  // header, x[nx], y[ny], z[nz], then bx, by, bz for nx*ny*nz grid points
+  struct payload_header
+  {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t nx = 0;
+    uint32_t ny = 0;
+    uint32_t nz = 0;
+    uint32_t reserved = 0;
+  };
+
+  constexpr uint32_t payload_magic = 0x50484633;  // "PHF3"
+  constexpr uint32_t payload_version = 1;
+
+  //! read and validate the payload header against the payload size
+  //! a stale, truncated or foreign payload from the store must not be used
+  bool read_payload_header(const PHSharedPayload &payload, payload_header &header)
+  {
+    if (payload.size() < sizeof(payload_header))
+    {
+      return false;
+    }
+    std::memcpy(&header, payload.data(), sizeof(header));
+    if (header.magic != payload_magic || header.version != payload_version || header.nx == 0 || header.ny == 0 || header.nz == 0)
+    {
+      return false;
+    }
+    // compare in number of floats, guarding against overflow of the grid size
+    const uint64_t nfloats = (payload.size() - sizeof(payload_header)) / sizeof(float);
+    const uint64_t nxy = static_cast<uint64_t>(header.nx) * header.ny;
+    if (nxy > nfloats / header.nz)
+    {
+      return false;
+    }
+    const uint64_t expected = sizeof(payload_header) + (static_cast<uint64_t>(header.nx) + header.ny + header.nz + 3 * nxy * header.nz) * sizeof(float);
+    return payload.size() == expected;
+  }
+}  // namespace
 
 PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
   : filename(fname)
@@ -42,60 +91,134 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
             << "\n      Magnetic field Module - Verbosity:"
             << "\n-----------------------------------------------------------";
 
-  // open file
-  TFile *rootinput = TFile::Open(filename.c_str());
-  if (!rootinput)
+  // the builder reads the ntuple and converts it to the flat layout
+  // it is only called if the payload is not already available in the node local store
+  auto builder = [&]()
   {
-    std::cout << "\n could not open " << filename << " exiting now" << std::endl;
-    gSystem->Exit(1);
-    exit(1);
+    // open file
+    TFile *rootinput = TFile::Open(filename.c_str());
+    if (!rootinput)
+    {
+      std::cout << "\n could not open " << filename << " exiting now" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    std::cout << "\n ---> "
+                 "Reading the field grid from "
+              << filename << " ... " << std::endl;
+
+    //  get root NTuple objects
+    TNtuple *field_map = nullptr;
+    rootinput->GetObject("fieldmap", field_map);
+    if (field_map == nullptr)
+    {
+      std::cout << PHWHERE << " Could not load fieldmap ntuple from "
+                << filename << " exiting now" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    Float_t ROOT_X;
+    Float_t ROOT_Y;
+    Float_t ROOT_Z;
+    Float_t ROOT_BX;
+    Float_t ROOT_BY;
+    Float_t ROOT_BZ;
+    field_map->SetBranchAddress("x", &ROOT_X);
+    field_map->SetBranchAddress("y", &ROOT_Y);
+    field_map->SetBranchAddress("z", &ROOT_Z);
+    field_map->SetBranchAddress("bx", &ROOT_BX);
+    field_map->SetBranchAddress("by", &ROOT_BY);
+    field_map->SetBranchAddress("bz", &ROOT_BZ);
+
+    std::set<float> xset;
+    std::set<float> yset;
+    std::set<float> zset;
+    std::vector<std::array<float, 6>> entries;
+    for (int i = 0; i < field_map->GetEntries(); i++)
+    {
+      field_map->GetEntry(i);
+      xset.insert(ROOT_X * cm);
+      yset.insert(ROOT_Y * cm);
+      zset.insert(ROOT_Z * cm);
+      if ((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
+           std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
+          std::abs(ROOT_Z * cm) > size_z)
+      {
+        entries.push_back({static_cast<float>(ROOT_X * cm), static_cast<float>(ROOT_Y * cm), static_cast<float>(ROOT_Z * cm),
+                           static_cast<float>(ROOT_BX * tesla * magfield_rescale), static_cast<float>(ROOT_BY * tesla * magfield_rescale), static_cast<float>(ROOT_BZ * tesla * magfield_rescale)});
+      }
+    }
+    delete field_map;
+    delete rootinput;
+
+    // fill flat layout
+    const std::vector<float> xgrid(xset.begin(), xset.end());
+    const std::vector<float> ygrid(yset.begin(), yset.end());
+    const std::vector<float> zgrid(zset.begin(), zset.end());
+    const size_t npoints = xgrid.size() * ygrid.size() * zgrid.size();
+    std::vector<char> blob(sizeof(payload_header) + (xgrid.size() + ygrid.size() + zgrid.size() + 3 * npoints) * sizeof(float));
+
+    payload_header header;
+    header.magic = payload_magic;
+    header.version = payload_version;
+    header.nx = xgrid.size();
+    header.ny = ygrid.size();
+    header.nz = zgrid.size();
+    std::memcpy(blob.data(), &header, sizeof(header));
+
+    float *out = reinterpret_cast<float *>(blob.data() + sizeof(payload_header));
+    out = std::copy(xgrid.begin(), xgrid.end(), out);
+    out = std::copy(ygrid.begin(), ygrid.end(), out);
+    out = std::copy(zgrid.begin(), zgrid.end(), out);
+    std::fill(out, out + 3 * npoints, std::numeric_limits<float>::quiet_NaN());
+    for (const auto &entry : entries)
+    {
+      const size_t ix = std::lower_bound(xgrid.begin(), xgrid.end(), entry[0]) - xgrid.begin();
+      const size_t iy = std::lower_bound(ygrid.begin(), ygrid.end(), entry[1]) - ygrid.begin();
+      const size_t iz = std::lower_bound(zgrid.begin(), zgrid.end(), entry[2]) - zgrid.begin();
+      std::copy(entry.begin() + 3, entry.end(), out + 3 * ((ix * ygrid.size() + iy) * zgrid.size() + iz));
+    }
+    return blob;
+  };
+
+  // the key must change whenever the content does
+  std::ostringstream keyname;
+  keyname << "PHField3DCartesian:" << payload_version << ":" << magfield_rescale << ":" << innerradius << ":" << outerradius << ":" << size_z;
+  m_payload = PHSharedPayload::Get(PHSharedPayload::MakeKey(keyname.str(), filename), builder);
+  if (m_payload->is_shared())
+  {
+    std::cout << "\n ---> "
+                 "Using field grid from node local payload store"
+              << std::endl;
   }
-  std::cout << "\n ---> "
-               "Reading the field grid from "
-            << filename << " ... " << std::endl;
-
-  //  get root NTuple objects
-  TNtuple *field_map = nullptr;
-  rootinput->GetObject("fieldmap", field_map);
-  if (field_map == nullptr)
+
+  payload_header header;
+  if (m_payload->is_shared() && !read_payload_header(*m_payload, header))
   {
-    std::cout << PHWHERE << " Could not load fieldmap ntuple from "
-              << filename << " exiting now" << std::endl;
-    gSystem->Exit(1);
-    exit(1);
+    std::cout << "\n ---> "
+                 "Invalid field grid in node local payload store, rebuilding it in process memory"
+              << std::endl;
+    m_payload = PHSharedPayload::Build(builder);
   }
-  Float_t ROOT_X;
-  Float_t ROOT_Y;
-  Float_t ROOT_Z;
-  Float_t ROOT_BX;
-  Float_t ROOT_BY;
-  Float_t ROOT_BZ;
-  field_map->SetBranchAddress("x", &ROOT_X);
-  field_map->SetBranchAddress("y", &ROOT_Y);
-  field_map->SetBranchAddress("z", &ROOT_Z);
-  field_map->SetBranchAddress("bx", &ROOT_BX);
-  field_map->SetBranchAddress("by", &ROOT_BY);
-  field_map->SetBranchAddress("bz", &ROOT_BZ);
-  for (int i = 0; i < field_map->GetEntries(); i++)
+  if (!read_payload_header(*m_payload, header))
   {
-    field_map->GetEntry(i);
-    trio coord_key(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm);
-    trio field_val(ROOT_BX * tesla * magfield_rescale, ROOT_BY * tesla * magfield_rescale, ROOT_BZ * tesla * magfield_rescale);
-    xvals.insert(ROOT_X * cm);
-    yvals.insert(ROOT_Y * cm);
-    zvals.insert(ROOT_Z * cm);
-    if ((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
-         std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
-        std::abs(ROOT_Z * cm) > size_z)
-    {
-      fieldmap[coord_key] = field_val;
-    }
+    std::cout << PHWHERE << " invalid field map payload for " << filename << " exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
   }
-  xmin = *(xvals.begin());
-  xmax = *(xvals.rbegin());
-
-  ymin = *(yvals.begin());
-  ymax = *(yvals.rbegin());
+  nx = header.nx;
+  ny = header.ny;
+  nz = header.nz;
+  xvals = reinterpret_cast<const float *>(m_payload->data() + sizeof(payload_header));
+  yvals = xvals + nx;
+  zvals = yvals + ny;
+  bvals = zvals + nz;
+
+  xmin = xvals[0];
+  xmax = xvals[nx - 1];
+
+  ymin = yvals[0];
+  ymax = yvals[ny - 1];
   if (ymin != xmin || ymax != xmax)
   {
     std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
@@ -103,15 +226,13 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
     exit(1);
   }
 
-  zmin = *(zvals.begin());
-  zmax = *(zvals.rbegin());
+  zmin = zvals[0];
+  zmax = zvals[nz - 1];
 
-  xstepsize = (xmax - xmin) / (xvals.size() - 1);
-  ystepsize = (ymax - ymin) / (yvals.size() - 1);
-  zstepsize = (zmax - zmin) / (zvals.size() - 1);
+  xstepsize = (xmax - xmin) / (nx - 1);
+  ystepsize = (ymax - ymin) / (ny - 1);
+  zstepsize = (zmax - zmin) / (nz - 1);
 
-  delete field_map;
-  delete rootinput;
   std::cout << "\n================= End Construct Mag Field ======================\n"
             << std::endl;
 }
@@ -176,58 +297,28 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
     return;
   }
 
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
+  size_t ix[2];
+  if (!find_keys(xvals, nx, x, ix))
   {
-    --it;
-    xkey[1] = *it;
+    std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
+    return;
   }
+  const double xkey[2] = {xvals[ix[0]], xvals[ix[1]]};
 
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
+  size_t iy[2];
+  if (!find_keys(yvals, ny, y, iy))
   {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
+    std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
+    return;
   }
-  else
+  const double ykey[2] = {yvals[iy[0]], yvals[iy[1]]};
+  size_t iz[2];
+  if (!find_keys(zvals, nz, z, iz))
   {
-    --it;
-    zkey[1] = *it;
+    std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
+    return;
   }
+  const double zkey[2] = {zvals[iz[0]], zvals[iz[1]]};
 
   if (xkey_save != xkey[0] ||
       ykey_save != ykey[0] ||
@@ -238,17 +329,14 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
     ykey_save = ykey[0];
     zkey_save = zkey[0];
 
-    std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-    trio key;
     for (int i = 0; i < 2; i++)
     {
       for (int j = 0; j < 2; j++)
       {
         for (int k = 0; k < 2; k++)
         {
-          key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-          magval = fieldmap.find(key);
-          if (magval == fieldmap.end())
+          const float *magval = field_at(ix[i], iy[j], iz[k]);
+          if (std::isnan(magval[0]))
           {
             std::cout << PHWHERE << " could not locate key in " << filename
                       << " value: x: " << xkey[i] / cm
@@ -256,14 +344,14 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
                       << ", z: " << zkey[k] / cm << std::endl;
             return;
           }
-          bf[i][j][k][0] = std::get<0>(magval->second);
-          bf[i][j][k][1] = std::get<1>(magval->second);
-          bf[i][j][k][2] = std::get<2>(magval->second);
+          bf[i][j][k][0] = magval[0];
+          bf[i][j][k][1] = magval[1];
+          bf[i][j][k][2] = magval[2];
           if (Verbosity() > 0)
           {
-            const double x_loc = std::get<0>(magval->first);
-            const double y_loc = std::get<1>(magval->first);
-            const double z_loc = std::get<2>(magval->first);
+            const double x_loc = xkey[i];
+            const double y_loc = ykey[j];
+            const double z_loc = zkey[k];
 
             std::cout << "read x/y/z: " << x_loc / cm << "/"
               << y_loc / cm << "/"
@@ -342,73 +430,40 @@ void PHField3DCartesian::GetFieldValue_nocache(const double point[4], double *Bf
       point[2] < zmin || point[2] > zmax)
   { return; }
 
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
+  size_t ix[2];
+  if (!find_keys(xvals, nx, x, ix))
   {
-    --it;
-    xkey[1] = *it;
+    std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
+    return;
   }
+  const double xkey[2] = {xvals[ix[0]], xvals[ix[1]]};
 
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
+  size_t iy[2];
+  if (!find_keys(yvals, ny, y, iy))
   {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
+    std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
+    return;
   }
-  else
+  const double ykey[2] = {yvals[iy[0]], yvals[iy[1]]};
+  size_t iz[2];
+  if (!find_keys(zvals, nz, z, iz))
   {
-    --it;
-    zkey[1] = *it;
+    std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
+    return;
   }
+  const double zkey[2] = {zvals[iz[0]], zvals[iz[1]]};
 
   // local xyz and field
   double bf_loc[2][2][2][3]{};
 
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-  trio key;
   for (int i = 0; i < 2; i++)
   {
     for (int j = 0; j < 2; j++)
     {
       for (int k = 0; k < 2; k++)
       {
-        key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-        magval = fieldmap.find(key);
-        if (magval == fieldmap.end())
+        const float *magval = field_at(ix[i], iy[j], iz[k]);
+        if (std::isnan(magval[0]))
         {
           std::cout << PHWHERE << " could not locate key in " << filename
             << " value: x: " << xkey[i] / cm
@@ -417,15 +472,15 @@ void PHField3DCartesian::GetFieldValue_nocache(const double point[4], double *Bf
           return;
         }
 
-        bf_loc[i][j][k][0] = std::get<0>(magval->second);
-        bf_loc[i][j][k][1] = std::get<1>(magval->second);
-        bf_loc[i][j][k][2] = std::get<2>(magval->second);
+        bf_loc[i][j][k][0] = magval[0];
+        bf_loc[i][j][k][1] = magval[1];
+        bf_loc[i][j][k][2] = magval[2];
         if (Verbosity() > 0)
         {
 
-          const double x_loc = std::get<0>(magval->first);
-          const double y_loc = std::get<1>(magval->first);
-          const double z_loc = std::get<2>(magval->first);
+          const double x_loc = xkey[i];
+          const double y_loc = ykey[j];
+          const double z_loc = zkey[k];
 
           std::cout << "read x/y/z: " << x_loc / cm << "/"
             << y_loc / cm << "/"
@@ -479,3 +534,19 @@ void PHField3DCartesian::GetFieldValue_nocache(const double point[4], double *Bf
 
   return;
 }
+
+//_____________________________________________________________
+bool PHField3DCartesian::find_keys(const float *vals, size_t n, double v, size_t *index)
+{
+  // same convention as std::set<float>::lower_bound: index[0] is the first grid point not below v,
+  // index[1] the one before, if any
+  const float *it = std::lower_bound(vals, vals + n, static_cast<float>(v));
+  index[0] = it - vals;
+  if (it == vals)
+  {
+    index[1] = index[0];
+    return !(v < *it);
+  }
+  index[1] = index[0] - 1;
+  return true;
+}
@@ -3,11 +3,12 @@
 
 #include "PHField.h"
 
+#include <cstddef>
 #include <limits>
-#include <map>
-#include <set>
+#include <memory>
 #include <string>
-#include <tuple>
+
+class PHSharedPayload;
 
 class PHField3DCartesian : public PHField
 {
@@ -48,11 +49,29 @@ class PHField3DCartesian : public PHField
   mutable int cache_hits {0};
   mutable int cache_misses {0};
 
-  typedef std::tuple<float, float, float> trio;
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
-  std::set<float> xvals;
-  std::set<float> yvals;
-  std::set<float> zvals;
+  //! find the two grid points around v, returns false if v is below the grid
+  static bool find_keys(const float *vals, size_t n, double v, size_t *index);
+
+  //! field at given grid point, x index varies slowest
+  const float *field_at(size_t ix, size_t iy, size_t iz) const
+  {
+    return bvals + 3 * ((ix * ny + iy) * nz + iz);
+  }
+
+  // the field map is kept in a flat, position independent layout,
+  // which can be shared between the processes running on a node (see PHSharedPayload)
+  std::unique_ptr<PHSharedPayload> m_payload;
+  size_t nx {0};
+  size_t ny {0};
+  size_t nz {0};
+
+  //! sorted grid coordinates
+  const float *xvals {nullptr};
+  const float *yvals {nullptr};
+  const float *zvals {nullptr};
+
+  //! bx, by, bz for each grid point. NaN for points outside of the requested acceptance
+  const float *bvals {nullptr};
 };
 
 #endif
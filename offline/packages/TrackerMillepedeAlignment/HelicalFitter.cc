@@ -46,6 +46,8 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
+#include <algorithm>
+#include <atomic>
 #include <climits>  // for UINT_MAX
 #include <cmath>    // for std::abs, sqrt
 #include <fstream>
@@ -54,6 +56,7 @@
 #include <set>  // for _Rb_tree_const_iterator
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>  // for pair
 #include <vector>
@@ -110,6 +113,13 @@ int HelicalFitter::InitRun(PHCompositeNode* topNode)
     return ret;
   }
 
+  // track ntuples are filled from the track loop, which then cannot run in parallel
+  if (make_ntuple && m_nthreads > 1)
+  {
+    std::cout << "HelicalFitter::InitRun - ntuple output requested, tracks are processed serially" << std::endl;
+    m_nthreads = 1;
+  }
+
   // Instantiate Mille and open output data file
   if (test_output)
   {
@@ -549,15 +559,15 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
   }
   Acts::Vector3 averageVertex(xsum / accepted_tracks, ysum / accepted_tracks, zsum / accepted_tracks);
 
-  for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
+  // compute residuals and derivatives for a given accepted track, and add the measurements to mille
+  // returns false if the vertex derivatives are invalid, in which case the track record is dropped
+  const auto process_track = [&](unsigned int trackid, Mille& mille, SvtxTrack_v4& newTrack, SvtxAlignmentStateMap::StateVec& statevec) -> bool
   {
     const auto& global_vec = cumulative_global_vec[trackid];
     const auto& cluskey_vec = cumulative_cluskey_vec[trackid];
     auto fitpars = cumulative_fitpars_vec[trackid];
     auto fitpars_mvtx_half = cumulative_fitpars_mvtx_half_vec[trackid];
     const auto& someseed = cumulative_someseed[trackid];
-    auto newTrack = cumulative_newTrack[trackid];
-    SvtxAlignmentStateMap::StateVec statevec;
 
     // get the residuals and derivatives for all clusters
     for (unsigned int ivec = 0; ivec < global_vec.size(); ++ivec)
@@ -872,7 +882,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
           std::cerr << "glbl_derivativeX is NaN" << std::endl;
           continue;
         }
-        _mille->mille(AlignmentDefs::NLC, lcl_derivativeX, AlignmentDefs::NGL, glbl_derivativeX, glbl_label, residual(0), errinf * clus_sigma(0));
+        mille.mille(AlignmentDefs::NLC, lcl_derivativeX, AlignmentDefs::NGL, glbl_derivativeX, glbl_label, residual(0), errinf * clus_sigma(0));
       }
 
       if (!isnan(residual(1)) && clus_sigma(1) < 1.0)
@@ -887,19 +897,15 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
           std::cerr << "glbl_derivativeY is NaN" << std::endl;
           continue;
         }
-        _mille->mille(AlignmentDefs::NLC, lcl_derivativeY, AlignmentDefs::NGL, glbl_derivativeY, glbl_label, residual(1), errinf * clus_sigma(1));
+        mille.mille(AlignmentDefs::NLC, lcl_derivativeY, AlignmentDefs::NGL, glbl_derivativeY, glbl_label, residual(1), errinf * clus_sigma(1));
       }
     }
 
-    m_alignmentmap->insertWithKey(trackid, statevec);
-    m_trackmap->insertWithKey(&newTrack, trackid);
-
     // if cosmics, end here, if collision track, continue with vtx
     //   skip the common vertex requirement for this track unless there are 3 tracks in the event
     if (accepted_tracks < 3)
     {
-      _mille->end();
-      continue;
+      return true;
     }
     // calculate vertex residual with perigee surface
     //-------------------------------------------------------
@@ -910,22 +916,18 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
     {
       for (const auto& [vtxkey, vertex] : *m_vertexmap)
       {
+        // tracks are stored in m_trackmap with their accepted track index as key, their id is the seed index
         for (auto trackiter = vertex->begin_tracks(); trackiter != vertex->end_tracks(); ++trackiter)
         {
-          SvtxTrack* vtxtrack = m_trackmap->get(*trackiter);
-          if (vtxtrack)
+          if (*trackiter < accepted_tracks && cumulative_newTrack[*trackiter].get_id() == trackid)
           {
-            unsigned int const vtxtrackid = vtxtrack->get_id();
-            if (trackid == vtxtrackid)
+            event_vtx(0) = vertex->get_x();
+            event_vtx(1) = vertex->get_y();
+            event_vtx(2) = vertex->get_z();
+            if (Verbosity() > 0)
             {
-              event_vtx(0) = vertex->get_x();
-              event_vtx(1) = vertex->get_y();
-              event_vtx(2) = vertex->get_z();
-              if (Verbosity() > 0)
-              {
-                std::cout << "     setting event_vertex for trackid " << trackid << " to vtxid " << vtxkey
-                          << " vtx " << event_vtx(0) << "  " << event_vtx(1) << "  " << event_vtx(2) << std::endl;
-              }
+              std::cout << "     setting event_vertex for trackid " << trackid << " to vtxid " << vtxkey
+                        << " vtx " << event_vtx(0) << "  " << event_vtx(1) << "  " << event_vtx(2) << std::endl;
             }
           }
         }
@@ -1010,28 +1012,28 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
         if (arr_has_nan(lclvtx_derivativeX))
         {
           std::cerr << "lclvtx_derivativeX is NaN" << std::endl;
-          continue;
+          return false;
         }
         if (arr_has_nan(glblvtx_derivativeX))
         {
           std::cerr << "glblvtx_derivativeX is NaN" << std::endl;
-          continue;
+          return false;
         }
-        _mille->mille(AlignmentDefs::NLC, lclvtx_derivativeX, AlignmentDefs::NGLVTX, glblvtx_derivativeX, AlignmentDefs::glbl_vtx_label, vtx_residual(0), vtx_sigma(0));
+        mille.mille(AlignmentDefs::NLC, lclvtx_derivativeX, AlignmentDefs::NGLVTX, glblvtx_derivativeX, AlignmentDefs::glbl_vtx_label, vtx_residual(0), vtx_sigma(0));
       }
       if (!isnan(vtx_residual(1)))
       {
         if (arr_has_nan(lclvtx_derivativeY))
         {
           std::cerr << "lclvtx_derivativeY is NaN" << std::endl;
-          continue;
+          return false;
         }
         if (arr_has_nan(glblvtx_derivativeY))
         {
           std::cerr << "glblvtx_derivativeY is NaN" << std::endl;
-          continue;
+          return false;
         }
-        _mille->mille(AlignmentDefs::NLC, lclvtx_derivativeY, AlignmentDefs::NGLVTX, glblvtx_derivativeY, AlignmentDefs::glbl_vtx_label, vtx_residual(1), vtx_sigma(1));
+        mille.mille(AlignmentDefs::NLC, lclvtx_derivativeY, AlignmentDefs::NGLVTX, glblvtx_derivativeY, AlignmentDefs::glbl_vtx_label, vtx_residual(1), vtx_sigma(1));
       }
     }
 
@@ -1075,9 +1077,72 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
       std::cout << "track_x " << newTrack.get_x() << "track_y " << newTrack.get_y() << "track_z " << newTrack.get_z() << std::endl;
     }
     // close out this track
-    _mille->end();
+    return true;
+  };
+
+  const unsigned int nthreads = std::min(m_nthreads, accepted_tracks);
+  if (nthreads <= 1)
+  {
+    for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
+    {
+      auto& newTrack = cumulative_newTrack[trackid];
+      SvtxAlignmentStateMap::StateVec statevec;
+      const bool complete = process_track(trackid, *_mille, newTrack, statevec);
+
+      m_alignmentmap->insertWithKey(trackid, statevec);
+      m_trackmap->insertWithKey(&newTrack, trackid);
+      if (complete)
+      {
+        _mille->end();
+      }
+      else
+      {
+        // drop the derivatives of a track with invalid vertex derivatives
+        _mille->kill();
+      }
+    }  // end loop over tracks
+  }
+  else
+  {
+    // tracks are processed in parallel, each thread formats its records in memory
+    // records and track states are then stored in track order, so that the output does not depend on the number of threads
+    std::vector<SvtxAlignmentStateMap::StateVec> cumulative_statevec(accepted_tracks);
+    std::vector<std::string> cumulative_records(accepted_tracks);
+    std::atomic<unsigned int> next_track{0};
+    const auto process_tracks = [&]()
+    {
+      Mille mille(nullptr, !test_output);
+      for (unsigned int trackid = next_track++; trackid < accepted_tracks; trackid = next_track++)
+      {
+        if (process_track(trackid, mille, cumulative_newTrack[trackid], cumulative_statevec[trackid]))
+        {
+          mille.end();
+        }
+        else
+        {
+          mille.kill();
+        }
+        cumulative_records[trackid] = mille.takeRecords();
+      }
+    };
 
-  }  // end loop over tracks
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < nthreads; ++i)
+    {
+      threads.emplace_back(process_tracks);
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
+    {
+      m_alignmentmap->insertWithKey(trackid, cumulative_statevec[trackid]);
+      m_trackmap->insertWithKey(&cumulative_newTrack[trackid], trackid);
+      _mille->writeRecords(cumulative_records[trackid]);
+    }
+  }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -68,6 +68,9 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
   void set_tpc_grouping(int group) { tpc_grp = (AlignmentDefs::tpcGrp) group; }
   void set_mms_grouping(int group) { mms_grp = (AlignmentDefs::mmsGrp) group; }
   void set_test_output(bool test) { test_output = test; }
+  void set_make_ntuple(bool flag) { make_ntuple = flag; }
+  //! number of threads used to compute residuals and derivatives. Requires ntuple output to be disabled
+  void set_nthreads(unsigned int n) { m_nthreads = n; }
   void set_intt_layer_fixed(unsigned int layer);
   void set_mvtx_layer_fixed(unsigned int layer, unsigned int clamshell);
   void set_tpc_sector_fixed(unsigned int region, unsigned int sector, unsigned int side);
@@ -217,6 +220,7 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
   std::string _silicon_track_map_name{"SiliconTrackSeedContainer"};
 
   bool make_ntuple{true};
+  unsigned int m_nthreads{1};
   TNtuple* ntp{nullptr};
   TNtuple* track_ntp{nullptr};
   TFile* fout{nullptr};
@@ -31,19 +31,28 @@
 
 #include "Mille.h"
 
+#include <zlib.h>
+
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <utility>
 
 //___________________________________________________________________________
 
 /// Opens outFileName (by default as binary file).
 /**
- * \param[in] outFileName  file name
+ * Names ending with .gz are gzip compressed.
+ * Without file name, records are kept in memory, see takeRecords().
+ *
+ * \param[in] outFileName  file name, or nullptr
  * \param[in] asBinary     flag for binary
  * \param[in] writeZero    flag for keeping of zeros
  */
 Mille::Mille(const char *outFileName, bool asBinary, bool writeZero)
-  : myOutFile(outFileName, (asBinary ? (std::ios::binary | std::ios::out) : std::ios::out))
+  : myInMemory(outFileName == nullptr)
   , myAsBinary(asBinary)
   , myWriteZero(writeZero)
   , myBufferPos(-1)
@@ -54,6 +63,24 @@ Mille::Mille(const char *outFileName, bool asBinary, bool writeZero)
   myBufferInt[0] = 0;
   myBufferFloat[0] = 0.;
 
+  if (myInMemory)
+  {
+    return;
+  }
+
+  const std::string name(outFileName);
+  if (name.size() > 3 && name.compare(name.size() - 3, 3, ".gz") == 0)
+  {
+    myGzFile = gzopen(outFileName, "wb");
+    if (!myGzFile)
+    {
+      std::cerr << "Mille::Mille: Could not open " << outFileName
+                << " as compressed output file." << std::endl;
+    }
+    return;
+  }
+
+  myOutFile.open(outFileName, (asBinary ? (std::ios::binary | std::ios::out) : std::ios::out));
   if (!myOutFile.is_open())
   {
     std::cerr << "Mille::Mille: Could not open " << outFileName
@@ -65,6 +92,10 @@ Mille::Mille(const char *outFileName, bool asBinary, bool writeZero)
 /// Closes file.
 Mille::~Mille()
 {
+  if (myGzFile)
+  {
+    gzclose(myGzFile);
+  }
   myOutFile.close();
 }
 
@@ -207,27 +238,31 @@ void Mille::end()
 
     if (myAsBinary)
     {
-      myOutFile.write(reinterpret_cast<const char *>(&numWordsToWrite),
-                      sizeof(numWordsToWrite));
-      myOutFile.write(reinterpret_cast<char *>(myBufferFloat),
-                      (myBufferPos + 1) * sizeof(myBufferFloat[0]));
-      myOutFile.write(reinterpret_cast<char *>(myBufferInt),
-                      (myBufferPos + 1) * sizeof(myBufferInt[0]));
+      this->write(reinterpret_cast<const char *>(&numWordsToWrite),
+                  sizeof(numWordsToWrite));
+      this->write(reinterpret_cast<const char *>(myBufferFloat),
+                  (myBufferPos + 1) * sizeof(myBufferFloat[0]));
+      this->write(reinterpret_cast<const char *>(myBufferInt),
+                  (myBufferPos + 1) * sizeof(myBufferInt[0]));
     }
     else
     {
-      myOutFile << numWordsToWrite << "\n";
+      std::ostringstream out;
+      out << numWordsToWrite << "\n";
       for (int i = 0; i < myBufferPos + 1; ++i)
       {
-        myOutFile << myBufferFloat[i] << " ";
+        out << myBufferFloat[i] << " ";
       }
-      myOutFile << "\n";
+      out << "\n";
 
       for (int i = 0; i < myBufferPos + 1; ++i)
       {
-        myOutFile << myBufferInt[i] << " ";
+        out << myBufferInt[i] << " ";
       }
-      myOutFile << "\n";
+      out << "\n";
+
+      const std::string text = out.str();
+      this->write(text.data(), text.size());
     }
   }
   myBufferPos = -1;  // reset buffer for next set of derivatives
@@ -235,6 +270,67 @@ void Mille::end()
   //  std:: cout << " Mille::end() finished with myBufferPos " << myBufferPos << std::endl;
 }
 
+//___________________________________________________________________________
+/// Return records collected in memory since last call, and clear them.
+/**
+ * Only meaningful if no output file name was given to the constructor.
+ */
+std::string Mille::takeRecords()
+{
+  return std::exchange(myRecords, std::string());
+}
+
+//___________________________________________________________________________
+/// Write records collected by another Mille instance, see takeRecords().
+/**
+ * Both instances must use the same binary/text setting.
+ * \param[in]   records  formatted records
+ */
+void Mille::writeRecords(const std::string &records)
+{
+  this->write(records.data(), records.size());
+}
+
+//___________________________________________________________________________
+/// Write formatted data to the output file, or keep it in memory.
+/**
+ * \param[in]   data  formatted data
+ * \param[in]   size  number of bytes
+ */
+void Mille::write(const char *data, std::size_t size)
+{
+  if (size == 0)
+  {
+    return;
+  }
+  if (myInMemory)
+  {
+    myRecords.append(data, size);
+  }
+  else if (myGzFile)
+  {
+    // gzwrite takes an int sized count, larger buffers are written in pieces
+    while (size > 0)
+    {
+      const auto chunk = static_cast<unsigned int>(std::min<std::size_t>(size, std::numeric_limits<int>::max()));
+      const int written = gzwrite(myGzFile, data, chunk);
+      if (written != static_cast<int>(chunk))
+      {
+        int errnum = 0;
+        std::cerr << "Mille::write: short write to compressed output, " << std::max(written, 0)
+                  << " of " << chunk << " bytes written: " << gzerror(myGzFile, &errnum) << std::endl;
+        return;
+      }
+      data += chunk;
+      size -= chunk;
+    }
+  }
+  else
+  {
+    myOutFile.write(data, size);
+  }
+}
+
 //___________________________________________________________________________
 /// Initialize for new set of locals, e.g. new track.
 void Mille::newSet()
@@ -24,8 +24,13 @@
  */
 
 #include <climits>
+#include <cstddef>
 #include <fstream>
 #include <limits>
+#include <string>
+
+struct gzFile_s;
+
 /**
  * \class Mille
  *
@@ -40,6 +45,11 @@
  *  But note that **pede** will not be able to read text output and has not been tested with
  *  derivatives/labels ==0.
  *
+ *  File names ending with \c .gz are written gzip compressed, which **pede** reads directly
+ *  when built with zlib support.
+ *  Without file name, records are kept in memory and retrieved with \c takeRecords(),
+ *  so that they can be prepared in a worker thread and written with \c writeRecords().
+ *
  *  author    : Gero Flucke
  *  date      : October 2006
  *  $Revision: 1.3 $
@@ -51,22 +61,32 @@
 class Mille
 {
  public:
-  Mille(const char *outFileName, bool asBinary = true, bool writeZero = false);
+  Mille(const char *outFileName = nullptr, bool asBinary = true, bool writeZero = false);
   ~Mille();
 
+  Mille(const Mille &) = delete;
+  Mille &operator=(const Mille &) = delete;
+
   void mille(int NLC, const float *derLc, int NGL, const float *derGl,
              const int *label, float rMeas, float sigma);
   void special(int nSpecial, const float *floatings, const int *integers);
   void kill();
   void end();
 
+  std::string takeRecords();
+  void writeRecords(const std::string &records);
+
  private:
   void newSet();
   bool checkBufferSize(int nLocal, int nGlobal);
+  void write(const char *data, std::size_t size);
 
-  std::ofstream myOutFile;  ///< C-binary for output
-  bool myAsBinary;          ///< if false output as text
-  bool myWriteZero;         ///< if true also write out derivatives/labels ==0
+  std::ofstream myOutFile;      ///< C-binary for output
+  gzFile_s *myGzFile{nullptr};  ///< compressed output, if file name ends with .gz
+  bool myInMemory{false};       ///< if true, records are kept in myRecords
+  std::string myRecords;        ///< records not yet written, if no output file
+  bool myAsBinary;              ///< if false output as text
+  bool myWriteZero;             ///< if true also write out derivatives/labels ==0
   /// buffer size for ints and floats
   enum
   {
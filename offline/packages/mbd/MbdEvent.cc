@@ -222,6 +222,7 @@ int MbdEvent::InitRun()
         // std::cout << "SIZES0 " << _mbdcal->get_shape(ifeech).size() << std::endl;
         //  Should set template size automatically here
         _mbdsig[ifeech].SetTemplate(_mbdcal->get_shape(ifeech), _mbdcal->get_sherr(ifeech));
+        _mbdsig[ifeech].SetFastFit(_fastfit);
         _mbdsig[ifeech].SetMinMaxFitTime(_mbdcal->get_sampmax(ifeech) - 2 - 3, _mbdcal->get_sampmax(ifeech) - 2 + 3);
         //_mbdsig[ifeech].SetMinMaxFitTime( 0, 31 );
       }
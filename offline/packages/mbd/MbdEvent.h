@@ -55,6 +55,7 @@ class MbdEvent
   void SetSim(const int s) { _simflag = s; }
   void SetRawDstFlag(const int r) { _rawdstflag = r; }
   void SetFitsOnly(const int f) { _fitsonly = f; }
+  void SetFastFit(const int f) { _fastfit = f; }
 
   float get_bbcz() { return m_bbcz; }
   float get_bbczerr() { return m_bbczerr; }
@@ -126,6 +127,7 @@ class MbdEvent
   int _simflag{0};
   int _rawdstflag{0};  // reading from dst with raw container
   int _fitsonly{0};    // stop reco after waveform fits (for DST_CALOFIT pass)
+  int _fastfit{0};     // analytic template fit, see MbdSig::SetFastFit()
   int _nsamples{31};
   int _calib_done{0}; 
   unsigned int _no_sampmax{0};      //! sampmax calib doesn't exist
@@ -69,6 +69,7 @@ int MbdReco::InitRun(PHCompositeNode *topNode)
   m_mbdevent->SetSim(_simflag);
   m_mbdevent->SetRawDstFlag(_rawdstflag);
   m_mbdevent->SetFitsOnly(_fitsonly);
+  m_mbdevent->SetFastFit(_fastfit);
   m_mbdevent->set_doeval(_fiteval);
 
   ret = m_mbdevent->InitRun();
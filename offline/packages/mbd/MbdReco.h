@@ -39,6 +39,7 @@ class MbdReco : public SubsysReco
   void SetCalPass(const int calpass) { _calpass = calpass; }
   void SetProcChargeCh(const bool s) { _always_process_charge = s; }
   void SetMbdTrigOnly(const int m)   { _mbdonly = m; }
+  void SetFastFit(const int f)       { _fastfit = f; }  // 0=minuit, 1=analytic, 2=validate
 
   MbdEvent* GetMbdEvent() { return m_mbdevent.get(); }
 
@@ -52,6 +53,7 @@ class MbdReco : public SubsysReco
   int  _rawdstflag{0};  // dst with raw container
   int  _fitsonly{0};    // stop reco after waveform fits (for DST_CALOFIT pass)
   int  _fiteval{0};     // overload with segment+1
+  int  _fastfit{0};     // analytic template fit in MbdSig
 
   float m_tres = 0.05;
   std::unique_ptr<TF1> m_gaussian = nullptr;
@@ -15,11 +15,39 @@
 #include <TTree.h>
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <limits>
 
+namespace
+{
+  // running sums over the same range as the old evt-by-evt pedestal histogram
+  void AccumulatePed(const Double_t y, Double_t &sum, Double_t &sum2, int &n)
+  {
+    if (y >= -0.5 && y < 2999.5)
+    {
+      sum += y;
+      sum2 += y * y;
+      n++;
+    }
+  }
+
+  void PedMeanRMS(const Double_t sum, const Double_t sum2, const int n, float &mean, float &rms)
+  {
+    if (n == 0)
+    {
+      mean = 0.;
+      rms = 0.;
+      return;
+    }
+    Double_t m = sum / n;
+    mean = m;
+    rms = std::sqrt(std::max(sum2 / n - m * m, 0.));
+  }
+}  // namespace
+
 MbdSig::MbdSig(const int chnum, const int nsamp)
   : _ch{chnum}
   , _nsamples{nsamp}
@@ -61,9 +89,6 @@ void MbdSig::Init()
   name += _ch;
   hPed0 = new TH1F(name, name, 3000, -0.5, 2999.5);
   // hPed0 = new TH1F(name,name,10000,1,0); // automatically determine the range
-  name = "hPedEvt_";
-  name += _ch;
-  hPedEvt = new TH1F(name, name, 3000, -0.5, 2999.5);
   if ( _pedstudyflag )
   {
     gPedvsEvent = new TGraphErrors();
@@ -146,7 +171,6 @@ MbdSig::~MbdSig()
   delete gSubPulse;
   delete ped0stats;
   delete hPed0;
-  delete hPedEvt;
   delete h2Template;
   delete h2Residuals;
   delete hAmpl;
@@ -156,6 +180,8 @@ MbdSig::~MbdSig()
   delete ped_fcn;
   delete fit_pileup;
   delete h_chi2ndf;
+  delete h_fastfit_dampl;
+  delete h_fastfit_dtime;
   if ( _pedstudyflag )
   {
     delete gPedvsEvent;
@@ -401,7 +427,16 @@ void MbdSig::Remove_Pileup()
       template_fcn->SetParameters(ymax, x_at_max);
       template_fcn->SetRange(0, x_at_max+2.1);
 
-      if (_verbose == 0)
+      Double_t fast_ampl = ymax;
+      Double_t fast_time = x_at_max;
+      Double_t fast_chi2{0.};
+      Double_t fast_ndf{0.};
+      if ( _fastfit==1 && _verbose == 0 && FastTemplateFit(0, x_at_max+2.1, fast_ampl, fast_time, fast_chi2, fast_ndf) )
+      {
+        // only the template shape is needed for the subtraction below
+        template_fcn->SetParameters(fast_ampl, fast_time);
+      }
+      else if (_verbose == 0)
       {
         //std::cout << PHWHERE << std::endl;
         gSubPulse->Fit(template_fcn, "RNQ");
@@ -513,6 +548,11 @@ Double_t MbdSig::GetSplineAmpl()
 void MbdSig::WriteChi2Hist()
 {
   h_chi2ndf->Write();
+  if ( h_fastfit_dampl )
+  {
+    h_fastfit_dampl->Write();
+    h_fastfit_dtime->Write();
+  }
 }
 
 void MbdSig::WritePedHist()
@@ -586,24 +626,26 @@ void MbdSig::SetPed0(const Double_t mean, const Double_t rms)
 void MbdSig::CalcEventPed0(const Int_t minpedsamp, const Int_t maxpedsamp)
 {
   // if (_ch==8) std::cout << "In MbdSig::CalcEventPed0(int,int)" << std::endl;
-  hPedEvt->Reset();
-
   Double_t x;
   Double_t y;
+  Double_t sum{0.};
+  Double_t sum2{0.};
+  int nped{0};
   for (int isamp = minpedsamp; isamp <= maxpedsamp; isamp++)
   {
     gRawPulse->GetPoint(isamp, x, y);
 
     hPed0->Fill(y);
-    hPedEvt->Fill(y);
+    AccumulatePed(y, sum, sum2, nped);
     // ped0stats->Push( y );
     // if ( _ch==8 ) std::cout << "ped0stats " << isamp << "\t" << y << std::endl;
   }
 
   // use straight mean for pedestal
   // Could consider using fit to hPed0 to remove outliers
-  float mean = hPedEvt->GetMean();
-  float rms = hPedEvt->GetRMS();
+  float mean{0.};
+  float rms{0.};
+  PedMeanRMS(sum, sum2, nped, mean, rms);
 
   SetPed0(mean, rms);
   // if (_ch==8) std::cout << "ped0stats mean, rms " << mean << "\t" << rms << std::endl;
@@ -612,11 +654,12 @@ void MbdSig::CalcEventPed0(const Int_t minpedsamp, const Int_t maxpedsamp)
 // Get Event by Event Ped0 if requested
 void MbdSig::CalcEventPed0(const Double_t minpedx, const Double_t maxpedx)
 {
-  hPedEvt->Reset();
-
   Double_t x;
   Double_t y;
   Int_t n = gRawPulse->GetN();
+  Double_t sum{0.};
+  Double_t sum2{0.};
+  int nped{0};
 
   for (int isamp = 0; isamp < n; isamp++)
   {
@@ -625,14 +668,17 @@ void MbdSig::CalcEventPed0(const Double_t minpedx, const Double_t maxpedx)
     if (x >= minpedx && x <= maxpedx)
     {
       hPed0->Fill(y);
-      hPedEvt->Fill(y);
+      AccumulatePed(y, sum, sum2, nped);
       // ped0stats->Push( y );
     }
   }
 
   // use straight mean for pedestal
   // Could consider using fit to hPed0 to remove outliers
-  SetPed0(hPedEvt->GetMean(), hPedEvt->GetRMS());
+  float mean{0.};
+  float rms{0.};
+  PedMeanRMS(sum, sum2, nped, mean, rms);
+  SetPed0(mean, rms);
 }
 
 // Get Event by Event Ped0, num samples before peak
@@ -699,9 +745,51 @@ int MbdSig::CalcEventPed0_PreSamp(const int presample, const int nsamps)
   ped_fcn->SetRange(minsamp-0.1,maxsamp+0.1);
   ped_fcn->SetParameter(0,1500.);
 
-  gRawPulse->Fit( ped_fcn, "RNQ" );
-  double chi2 = ped_fcn->GetChisquare();
-  double ndf = ped_fcn->GetNDF();
+  // fit of a constant is the weighted mean, so solve it directly
+  // (zero errors are treated as 1, as in TGraph::Fit)
+  double chi2{0.};
+  double ndf{0.};
+  {
+    const Int_t npts = gRawPulse->GetN();
+    const Double_t *xpts = gRawPulse->GetX();
+    const Double_t *ypts = gRawPulse->GetY();
+    const Double_t *eypts = gRawPulse->GetEY();
+    const double xlow = minsamp - 0.1;
+    const double xhigh = maxsamp + 0.1;
+
+    double sumw{0.};
+    double sumwy{0.};
+    int nfit{0};
+    for (int ipt = 0; ipt < npts; ipt++)
+    {
+      if (xpts[ipt] < xlow || xpts[ipt] > xhigh)
+      {
+        continue;
+      }
+      double err = (eypts != nullptr && eypts[ipt] > 0.) ? eypts[ipt] : 1.;
+      double w = 1.0 / (err * err);
+      sumw += w;
+      sumwy += w * ypts[ipt];
+      nfit++;
+    }
+
+    if (nfit > 0)
+    {
+      double pedfit = sumwy / sumw;
+      for (int ipt = 0; ipt < npts; ipt++)
+      {
+        if (xpts[ipt] < xlow || xpts[ipt] > xhigh)
+        {
+          continue;
+        }
+        double err = (eypts != nullptr && eypts[ipt] > 0.) ? eypts[ipt] : 1.;
+        double resid = (ypts[ipt] - pedfit) / err;
+        chi2 += resid * resid;
+      }
+      ndf = nfit - 1;
+      ped_fcn->SetParameter(0, pedfit);
+    }
+  }
 
   /*
   if ( chi2/ndf>4 )
@@ -1244,6 +1332,175 @@ Double_t MbdSig::TemplateFcn(const Double_t* x, const Double_t* par)
   return f;
 }
 
+void MbdSig::TemplateEval(const Double_t xx, Double_t& val, Double_t& deriv) const
+{
+  // same linear interpolation as TemplateFcn, the derivative is the slope of the segment
+  Double_t step = (template_endtime - template_begintime) / (template_npointsx - 1);
+  Double_t index = (xx - template_begintime) / step;
+
+  int ilow = TMath::FloorNint(index);
+  ilow = std::clamp(ilow, 0, template_npointsx - 2);
+
+  Double_t y0 = template_y[ilow];
+  Double_t y1 = template_y[ilow + 1];
+  deriv = (y1 - y0) / step;
+  val = y0 + deriv * (xx - (template_begintime + ilow * step));
+}
+
+bool MbdSig::FastTemplateFit(const Double_t xmin, const Double_t xmax, Double_t& ampl, Double_t& time, Double_t& chi2, Double_t& ndf)
+{
+  const int maxiter = 20;
+
+  Int_t n = gSubPulse->GetN();
+  Double_t* x = gSubPulse->GetX();
+  Double_t* y = gSubPulse->GetY();
+  Double_t* ey = gSubPulse->GetEY();
+  Double_t* rawy = gRawPulse->GetY();
+  Int_t nraw = gRawPulse->GetN();
+
+  if ( template_npointsx < 2 || static_cast<Int_t>(template_y.size()) < template_npointsx )
+  {
+    return false;
+  }
+
+  // points used in the fit, with the same rejections as TemplateFcn
+  auto usepoint = [&](const int i, const Double_t t)
+  {
+    if (x[i] < xmin || x[i] > xmax)
+    {
+      return false;
+    }
+    Double_t xx = x[i] - t;
+    if (xx < template_begintime || xx > template_endtime)
+    {
+      return false;
+    }
+    int samp_point = static_cast<int>(x[i]);
+    return !(samp_point >= 0 && samp_point < nraw && rawy[samp_point] > 16370);
+  };
+
+  auto weight = [&](const int i)
+  {
+    Double_t err = (ey != nullptr && ey[i] > 0.) ? ey[i] : 1.;
+    return 1.0 / (err * err);
+  };
+
+  Double_t a = ampl;
+  Double_t t = time;
+  bool converged = false;
+  for (int iter = 0; iter < maxiter; iter++)
+  {
+    // normal equations of the model linearized in ampl and time
+    Double_t saa{0.};
+    Double_t sat{0.};
+    Double_t stt{0.};
+    Double_t sra{0.};
+    Double_t srt{0.};
+    int npts{0};
+    for (int i = 0; i < n; i++)
+    {
+      if (!usepoint(i, t))
+      {
+        continue;
+      }
+      Double_t val{0.};
+      Double_t deriv{0.};
+      TemplateEval(x[i] - t, val, deriv);
+
+      Double_t w = weight(i);
+      Double_t da = val;         // df/dampl
+      Double_t dt = -a * deriv;  // df/dtime
+      Double_t resid = y[i] - a * val;
+      saa += w * da * da;
+      sat += w * da * dt;
+      stt += w * dt * dt;
+      sra += w * resid * da;
+      srt += w * resid * dt;
+      npts++;
+    }
+    if (npts < 3)
+    {
+      return false;
+    }
+
+    Double_t det = saa * stt - sat * sat;
+    if (!(std::abs(det) > 0.))
+    {
+      return false;
+    }
+    Double_t delta_a = (stt * sra - sat * srt) / det;
+    Double_t delta_t = (saa * srt - sat * sra) / det;
+
+    // don't step more than a sample at a time, the template is only piecewise smooth
+    delta_t = std::clamp(delta_t, -1., 1.);
+
+    a += delta_a;
+    t += delta_t;
+    if (!std::isfinite(a) || !std::isfinite(t) || a <= 0.)
+    {
+      return false;
+    }
+
+    if (std::abs(delta_t) < 1e-4 && std::abs(delta_a) < 1e-4 * std::abs(a))
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  if (!converged)
+  {
+    return false;
+  }
+
+  chi2 = 0.;
+  int npts{0};
+  for (int i = 0; i < n; i++)
+  {
+    if (!usepoint(i, t))
+    {
+      continue;
+    }
+    Double_t val{0.};
+    Double_t deriv{0.};
+    TemplateEval(x[i] - t, val, deriv);
+    Double_t resid = y[i] - a * val;
+    chi2 += weight(i) * resid * resid;
+    npts++;
+  }
+  ndf = npts - 2;
+  ampl = a;
+  time = t;
+
+  return true;
+}
+
+void MbdSig::ValidateFastFit(const Double_t ampl, const Double_t time)
+{
+  if (h_fastfit_dampl == nullptr)
+  {
+    TString name = "h_fastfit_dampl";
+    name += _ch;
+    h_fastfit_dampl = new TH1F(name, name, 2000, -0.1, 0.1);
+    name = "h_fastfit_dtime";
+    name += _ch;
+    h_fastfit_dtime = new TH1F(name, name, 2000, -0.1, 0.1);
+  }
+
+  Double_t dampl = (f_ampl != 0.) ? (ampl - f_ampl) / f_ampl : 0.;
+  Double_t dtime = time - f_time;
+  h_fastfit_dampl->Fill(dampl);
+  h_fastfit_dtime->Fill(dtime);
+
+  static int counter = 0;
+  if ( (std::abs(dampl) > 0.01 || std::abs(dtime) > 0.05) && counter < 100 )
+  {
+    std::cout << PHWHERE << " fast fit differs, evt ch " << _evt_counter << "\t" << _ch
+              << "\tampl " << ampl << "\t" << f_ampl << "\ttime " << time << "\t" << f_time << std::endl;
+    counter++;
+  }
+}
+
 // sampmax>0 means fit to the peak near sampmax
 // fitmode:
 //   0 - no info or no fit
@@ -1358,39 +1615,68 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   }
 
   // Start with fit over early part of waveform to reduce pileup and afterpulse effects
+  Double_t fitmax{0.};
   template_fcn->SetParameters(ymax, x_at_max);
   if ( nsaturated==0 )
   {
-    template_fcn->SetRange(0, x_at_max+4.2);
+    fitmax = x_at_max+4.2;
     f_fitmode = 1;
   }
   else
   {
-    template_fcn->SetRange(0, sampmax + nsaturated + 0.5);
+    fitmax = sampmax + nsaturated + 0.5;
     f_fitmode = 4;
   }
+  template_fcn->SetRange(0, fitmax);
 
-  if (_verbose == 0)
+  // analytic fit, accepted only if it would also pass the good fit cut below
+  Double_t fast_ampl = ymax;
+  Double_t fast_time = x_at_max;
+  Double_t fast_chi2{0.};
+  Double_t fast_ndf{0.};
+  bool fast_good = false;
+  if ( _fastfit>0 && _verbose == 0 )
   {
-    //std::cout << PHWHERE << std::endl;
-    gSubPulse->Fit(template_fcn, "RNQ");
+    fast_good = FastTemplateFit(0, fitmax, fast_ampl, fast_time, fast_chi2, fast_ndf) && fast_ndf>6. && (fast_chi2/fast_ndf)<5.;
   }
-  else
+
+  if ( fast_good && _fastfit==1 )
   {
-    std::cout << "doing fit1 " << x_at_max << "\t" << ymax << std::endl;
-    gSubPulse->Fit(template_fcn, "R");
-    gSubPulse->Draw("ap");
-    gSubPulse->GetHistogram()->SetTitle(gSubPulse->GetName());
-    gPad->SetGridy(1);
-    PadUpdate();
-    //gSubPulse->Print("ALL");
+    template_fcn->SetParameters(fast_ampl, fast_time);
+    f_ampl = fast_ampl;
+    f_time = fast_time;
+    f_chi2 = fast_chi2;
+    f_ndf = fast_ndf;
   }
+  else
+  {
+    if (_verbose == 0)
+    {
+      //std::cout << PHWHERE << std::endl;
+      gSubPulse->Fit(template_fcn, "RNQ");
+    }
+    else
+    {
+      std::cout << "doing fit1 " << x_at_max << "\t" << ymax << std::endl;
+      gSubPulse->Fit(template_fcn, "R");
+      gSubPulse->Draw("ap");
+      gSubPulse->GetHistogram()->SetTitle(gSubPulse->GetName());
+      gPad->SetGridy(1);
+      PadUpdate();
+      //gSubPulse->Print("ALL");
+    }
+
+    // Get fit parameters
+    f_ampl = template_fcn->GetParameter(0);
+    f_time = template_fcn->GetParameter(1);
+    f_chi2 = template_fcn->GetChisquare();
+    f_ndf = template_fcn->GetNDF();
 
-  // Get fit parameters
-  f_ampl = template_fcn->GetParameter(0);
-  f_time = template_fcn->GetParameter(1);
-  f_chi2 = template_fcn->GetChisquare();
-  f_ndf = template_fcn->GetNDF();
+    if ( fast_good )
+    {
+      ValidateFastFit(fast_ampl, fast_time);
+    }
+  }
   Double_t chi2ndf = 1e9;
   if ( f_ndf>0. )
   {
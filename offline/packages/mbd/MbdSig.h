@@ -121,6 +121,13 @@ class MbdSig
   TF1 *GetTemplateFcn() { return template_fcn; }
   void SetMinMaxFitTime(const Double_t mintime, const Double_t maxtime);
 
+  /** Analytic single template fit before Minuit
+   *  0 - Minuit only (default)
+   *  1 - use analytic fit when it converges with a good chi2, otherwise Minuit
+   *  2 - validate, run both, use Minuit and histogram the differences */
+  void SetFastFit(const int f) { _fastfit = f; }
+  int GetFastFit() const { return _fastfit; }
+
   void PrintResiduals(TGraphErrors *g, TF1 *f);
 
   void WritePedHist();
@@ -135,6 +142,16 @@ class MbdSig
  private:
   void Init();
 
+  /** template value and its derivative at xx (time relative to the template start) */
+  void TemplateEval(const Double_t xx, Double_t &val, Double_t &deriv) const;
+
+  /** Gauss-Newton fit of ampl and time of template to gSubPulse in [xmin,xmax],
+   *  ampl and time are the starting values. Returns false if not converged */
+  bool FastTemplateFit(const Double_t xmin, const Double_t xmax, Double_t &ampl, Double_t &time, Double_t &chi2, Double_t &ndf);
+
+  /** fill fast fit vs Minuit differences */
+  void ValidateFastFit(const Double_t ampl, const Double_t time);
+
   int _ch;
   int _nsamples;
   int _status{0};
@@ -169,7 +186,6 @@ class MbdSig
   /** for CalcPed0 */
   MbdRunningStats *ped0stats{nullptr};    //! running pedestal
   TH1 *hPed0{nullptr};                //! all events
-  TH1 *hPedEvt{nullptr};              //! evt-by-event pedestal
   TGraphErrors *gPedvsEvent{nullptr}; //! Keep track of pedestal vs evtnum
   TF1 *ped_fcn{nullptr};
   Double_t ped0{0.};                  //!
@@ -207,6 +223,10 @@ class MbdSig
                                         // use for calibrating out the tail from these events
 
   TH1 *h_chi2ndf{nullptr};  //! for eval
+  TH1 *h_fastfit_dampl{nullptr};  //! fast fit validation, (fast-minuit)/minuit ampl
+  TH1 *h_fastfit_dtime{nullptr};  //! fast fit validation, fast-minuit time
+
+  int _fastfit{0};
 
   int _verbose{0};
   bool _pedstudyflag{false};
@@ -0,0 +1,93 @@
+#include "TpcBaselineEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+TpcBaselineEngine::TpcBaselineEngine(unsigned int nslots)
+  : m_slots(nslots)
+{
+}
+
+void TpcBaselineEngine::set_nslots(unsigned int nslots)
+{
+  m_slots.clear();
+  m_slots.resize(nslots);
+}
+
+void TpcBaselineEngine::book(unsigned int slot, int ntimebins)
+{
+  Slot &s = m_slots[slot];
+  if (s.ntimebins > 0 || ntimebins <= 0)
+  {
+    return;
+  }
+  s.ntimebins = ntimebins;
+  s.counts.assign(static_cast<size_t>(ntimebins) * nAdcCells, 0);
+  s.entries.assign(ntimebins, 0);
+  s.ped.assign(ntimebins, 0);
+  s.width.assign(ntimebins, 0);
+  s.baseline.assign(ntimebins, 0);
+}
+
+void TpcBaselineEngine::calculate(double nsigma, int min_entries)
+{
+  for (auto &s : m_slots)
+  {
+    if (!s.touched)
+    {
+      continue;
+    }
+    // the last time bin never got a baseline in the histogram based implementation
+    for (int t = 0; t < s.ntimebins - 1; t++)
+    {
+      double local_ped = 0;
+      double local_width = 0;
+      if (s.entries[t] > min_entries)
+      {
+        const uint8_t *row = &s.counts[static_cast<size_t>(t) * nAdcCells];
+        int nentries = std::accumulate(row, row + nAdcCells, 0);
+        if (nentries > 10)
+        {
+          // first maximum of the regular bins, like TH1::GetMaximumBin
+          int maxbin = std::max_element(row, row + nAdcBins) - row;
+          double hadc_sum = 0.0;
+          double hibin_sum = 0.0;
+          double hibin2_sum = 0.0;
+          for (int isum = -3; isum <= 3; isum++)
+          {
+            // out of range bins are clamped to the overflow as TH1::GetBinContent does
+            int bin = std::min(maxbin + isum, nAdcBins);
+            double val = (bin < 0) ? 0. : row[bin];
+            double center = adc_center(maxbin + isum);
+            hibin_sum += center * val;
+            hibin2_sum += center * center * val;
+            hadc_sum += val;
+          }
+          local_ped = hibin_sum / hadc_sum;
+          local_width = std::sqrt((hibin2_sum / hadc_sum) - (local_ped * local_ped));
+        }
+      }
+      s.ped[t] = local_ped;
+      s.width[t] = local_width;
+      s.baseline[t] = local_ped + nsigma * local_width;
+    }
+  }
+}
+
+void TpcBaselineEngine::reset()
+{
+  for (auto &s : m_slots)
+  {
+    if (!s.touched)
+    {
+      continue;
+    }
+    std::fill(s.counts.begin(), s.counts.end(), 0);
+    std::fill(s.entries.begin(), s.entries.end(), 0);
+    std::fill(s.ped.begin(), s.ped.end(), 0);
+    std::fill(s.width.begin(), s.width.end(), 0);
+    std::fill(s.baseline.begin(), s.baseline.end(), 0);
+    s.touched = false;
+  }
+}
@@ -0,0 +1,92 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef TPC_TPCBASELINEENGINE_H
+#define TPC_TPCBASELINEENGINE_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Per-FEE, per-time-bin baseline estimation for the TPC unpacker.
+ *
+ * Replaces the TH2C per FEE + ProjectionY per time bin with fixed-size
+ * integer counters in one contiguous block per FEE. The binning (501 bins from
+ * -0.5 to 1000.5, computed the way TAxis::FindBin does) and the 8 bit saturating
+ * counters are the ones of the TH2C it replaces, so the extracted baselines are unchanged.
+ * FEEs are addressed by a dense slot index (see TpcCombinedRawDataUnpacker::fee_slot)
+ */
+class TpcBaselineEngine
+{
+ public:
+  static constexpr int nAdcBins = 501;
+  static constexpr int nAdcCells = nAdcBins + 1;  // last cell is the overflow
+  static constexpr double adcMin = -0.5;
+  static constexpr double adcMax = 1000.5;
+  static constexpr double adcBinWidth = (adcMax - adcMin) / nAdcBins;
+
+  explicit TpcBaselineEngine(unsigned int nslots = 0);
+
+  //! number of fee slots, resets everything
+  void set_nslots(unsigned int nslots);
+  unsigned int get_nslots() const { return m_slots.size(); }
+
+  //! allocate counters for a slot on first use, ntimebins is fixed afterwards
+  bool is_booked(unsigned int slot) const { return m_slots[slot].ntimebins > 0; }
+  void book(unsigned int slot, int ntimebins);
+  int get_ntimebins(unsigned int slot) const { return m_slots[slot].ntimebins; }
+
+  //! add a pedestal subtracted adc value in given time bin
+  void fill(unsigned int slot, int tbin, double adc)
+  {
+    Slot &s = m_slots[slot];
+    if (tbin < 0 || tbin >= s.ntimebins)
+    {
+      return;
+    }
+    if (adc < adcMin)  // underflow, never used
+    {
+      return;
+    }
+    int adcbin = (adc < adcMax) ? static_cast<int>(nAdcBins * (adc - adcMin) / (adcMax - adcMin)) : nAdcBins;
+    uint8_t &cnt = s.counts[(tbin * nAdcCells) + adcbin];
+    if (cnt < 127)
+    {
+      ++cnt;
+    }
+    ++s.entries[tbin];
+    s.touched = true;
+  }
+
+  //! extract baseline (peak centroid + nsigma * width) for all time bins of all booked slots
+  void calculate(double nsigma, int min_entries = 100);
+
+  int get_entries(unsigned int slot, int tbin) const { return m_slots[slot].entries[tbin]; }
+  double get_pedestal(unsigned int slot, int tbin) const { return m_slots[slot].ped[tbin]; }
+  double get_width(unsigned int slot, int tbin) const { return m_slots[slot].width[tbin]; }
+  double get_baseline(unsigned int slot, int tbin) const
+  {
+    const Slot &s = m_slots[slot];
+    return (tbin < (int) s.baseline.size()) ? s.baseline[tbin] : 0.;
+  }
+
+  //! clear counters of all slots filled in this event, keeps the booking
+  void reset();
+
+ private:
+  struct Slot
+  {
+    int ntimebins = 0;
+    bool touched = false;
+    std::vector<uint8_t> counts;  // ntimebins x nAdcCells
+    std::vector<int> entries;
+    std::vector<float> ped;
+    std::vector<float> width;
+    std::vector<double> baseline;
+  };
+
+  static double adc_center(int adcbin) { return adcMin + (adcbin + 0.5) * adcBinWidth; }
+
+  std::vector<Slot> m_slots;
+};
+
+#endif  // TPC_TPCBASELINEENGINE_H
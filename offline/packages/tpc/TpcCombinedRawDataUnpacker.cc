@@ -39,7 +39,6 @@
 #include <cstdint>   // for exit
 #include <cstdlib>   // for exit
 #include <iostream>  // for operator<<, endl, bas...
-#include <map>       // for _Rb_tree_iterator
 #include <memory>
 #include <utility>
 
@@ -193,6 +192,34 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
     std::cout << "TpcCombinedRawDataUnpacker:: endevt = " << endevt << std::endl;
   }
 
+  // dense copy of the fee channel map, avoids the CDBTTree map lookups per raw hit
+  m_pad_table.assign(m_nFees * m_nChannels, pad_info());
+  for (int fee = 0; fee < m_nFees; fee++)
+  {
+    int feeM = FEE_map[fee];
+    if (FEE_R[fee] == 2)
+    {
+      feeM += 6;
+    }
+    if (FEE_R[fee] == 3)
+    {
+      feeM += 14;
+    }
+    for (int channel = 0; channel < m_nChannels; channel++)
+    {
+      unsigned int key = (256 * (feeM)) + channel;
+      pad_info& pinfo = m_pad_table[(fee * m_nChannels) + channel];
+      pinfo.layer = m_cdbttree->GetIntValue(key, "layer");
+      if (pinfo.layer > 6)
+      {
+        pinfo.phi = m_cdbttree->GetDoubleValue(key, "phi");
+      }
+    }
+  }
+  m_phibin_table.assign(m_nPacketSectors * m_nFees * m_nChannels, -1);
+  m_pad_fee.assign(2 * m_nLayers, std::vector<short>());
+  m_baseline.set_nslots(fee_slot(1, 11, 2, m_nFees - 1) + 1);
+
   // check run number if presamples need to be shifted, which went from 80 -> 120
   // at 41624
   Fun4AllServer* se = Fun4AllServer::instance();
@@ -273,14 +300,9 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     int fee = tpchit->get_fee();
     int channel = tpchit->get_channel();
 
-    int feeM = FEE_map[fee];
-    if (FEE_R[fee] == 2)
-    {
-      feeM += 6;
-    }
-    if (FEE_R[fee] == 3)
+    if (fee < 0 || fee >= m_nFees || channel < 0 || channel >= m_nChannels)
     {
-      feeM += 14;
+      continue;
     }
 
     int side = 1;
@@ -292,9 +314,8 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       side = 0;
     }
 
-    unsigned int key = (256 * (feeM)) + channel;
-    std::string varname = "layer";
-    int layer = m_cdbttree->GetIntValue(key, varname);
+    const pad_info& pinfo = m_pad_table[(fee * m_nChannels) + channel];
+    int layer = pinfo.layer;
     // antenna pads will be in 0 layer
     if (layer <= 6)
     {
@@ -316,10 +337,22 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       region = 1;
     }
 
-    varname = "phi";  // + std::to_string(key);
-    double phi = ((side == 1 ? 1 : -1) * (m_cdbttree->GetDoubleValue(key, varname) - M_PI / 2.)) + ((sector % 12) * M_PI / 6);
     PHG4TpcGeom* layergeom = geom_container->GetLayerCellGeom(layer);
-    unsigned int phibin = layergeom->get_phibin(phi, side);
+    unsigned int phibin = 0;
+    int* cached_phibin = (sector >= 0 && sector < m_nPacketSectors) ? &m_phibin_table[(((sector * m_nFees) + fee) * m_nChannels) + channel] : nullptr;
+    if (cached_phibin && *cached_phibin >= 0)
+    {
+      phibin = *cached_phibin;
+    }
+    else
+    {
+      double phi = ((side == 1 ? 1 : -1) * (pinfo.phi - M_PI / 2.)) + ((sector % 12) * M_PI / 6);
+      phibin = layergeom->get_phibin(phi, side);
+      if (cached_phibin)
+      {
+        *cached_phibin = phibin;
+      }
+    }
   
     hit_set_key = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
     hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
@@ -331,46 +364,28 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     {
       std::cout << "TpcCombinedRawDataUnpacker:: do zero suppression" << std::endl;
     }
-    TH2* feehist = nullptr;
     hpedestal = 60;
     hpedwidth = m_zs_threshold[region];
 
-    unsigned int pad_key = create_pad_key(side, layer, phibin);
-
-    std::map<unsigned int, chan_info>::iterator chan_it = chan_map.find(pad_key);
-    if (chan_it != chan_map.end())
-    {
-      (*chan_it).second.ped = hpedestal;
-      (*chan_it).second.width = hpedwidth;
-    }
-    else
+    // remember which fee reads out this pad, first one wins
+    if (m_do_baseline_corr && layer < m_nLayers)
     {
-      chan_info nucinfo;
-      nucinfo.fee = fee;
-      nucinfo.ped = hpedestal;
-      nucinfo.width = hpedwidth;
-      chan_map.insert(std::make_pair(pad_key, nucinfo));
+      std::vector<short>& pad_fee = m_pad_fee[(side * m_nLayers) + layer];
+      if (pad_fee.empty())
+      {
+        pad_fee.assign(layergeom->get_phibins(), -1);
+      }
+      if (phibin < pad_fee.size() && pad_fee[phibin] < 0)
+      {
+        pad_fee[phibin] = fee;
+      }
     }
     int rx = get_rx(layer);
-    unsigned int fee_key = create_fee_key(side, mc_sectors[sector % 12], rx, fee);
-    // find or insert TH2C;
-    std::map<unsigned int, TH2*>::iterator fee_map_it;
-
-    fee_map_it = feeadc_map.find(fee_key);
-    if (fee_map_it != feeadc_map.end())
+    unsigned int slot = fee_slot(side, mc_sectors[sector % 12], rx, fee);
+    if (m_do_baseline_corr && !m_baseline.is_booked(slot))
     {
-      feehist = (*fee_map_it).second;
+      m_baseline.book(slot, max_time_range + 1);
     }
-    else
-    {
-      std::string histname = "h" + std::to_string(fee_key);
-      feehist = new TH2C(histname.c_str(), "histname", max_time_range + 1, -0.5, max_time_range + 0.5, 501, -0.5, 1000.5);
-      feeadc_map.insert(std::make_pair(fee_key, feehist));
-      std::vector<int> feeentries(feehist->GetNbinsX(), 0);
-      feeentries_map.insert(std::make_pair(fee_key, feeentries));
-    }
-    auto fee_entries_it = feeentries_map.find(fee_key);
-    std::vector<int>& fee_entries_vec = (*fee_entries_it).second;
 
     double threshold_cut = m_zs_threshold[region];
 
@@ -387,14 +402,11 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
         {
           continue;
         }
-        if (feehist != nullptr)
+        if (adc > 0)
         {
-          if (adc > 0)
+          if ((double(adc) - hpedestal) > threshold_cut)
           {
-            if ((double(adc) - hpedestal) > threshold_cut)
-            {
-              nhitschan++;
-            }
+            nhitschan++;
           }
         }
       }
@@ -420,18 +432,11 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       {
         continue;
       }
-      if (feehist != nullptr)
+      if (m_do_baseline_corr && adc > 0)
       {
-        if (adc > 0)
+        if ((double(adc) - hpedestal) > threshold_cut)
         {
-          if ((double(adc) - hpedestal) > threshold_cut)
-          {
-            feehist->Fill(t, adc - hpedestal);
-            if (t < (int) fee_entries_vec.size())
-            {
-              fee_entries_vec[t]++;
-            }
-          }
+          m_baseline.fill(slot, t, adc - hpedestal);
         }
       }
 
@@ -476,93 +481,48 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 
   if (m_do_baseline_corr == true)
   {
-    // Histos filled now process them for fee local baselines
+    // counters filled now process them for fee local baselines
+    m_baseline.calculate(m_baseline_nsigma);
 
     int nhistfilled = 0;
     int nhisttotal = 0;
-    for (auto& hiter : feeadc_map)
+    for (unsigned int slot = 0; slot < m_baseline.get_nslots(); slot++)
     {
-      if (hiter.second != nullptr)
+      if (!m_baseline.is_booked(slot))
+      {
+        continue;
+      }
+      unsigned int side;
+      unsigned int sector;
+      unsigned int rx;
+      unsigned int fee;
+      unpack_fee_slot(side, sector, rx, fee, slot);
+      for (int timebin = 0; timebin < m_baseline.get_ntimebins(slot) - 1; timebin++)
       {
-        unsigned int fee_key = hiter.first;
-        unsigned int side;
-        unsigned int sector;
-        unsigned int rx;
-        unsigned int fee;
-        unpack_fee_key(side, sector, rx, fee, fee_key);
-        TH2* hist2d = hiter.second;
-        std::map<unsigned int, std::vector<int>>::iterator fee_entries_it = feeentries_map.find(fee_key);
-        if (fee_entries_it == feeentries_map.end())
+        nhisttotal++;
+        int entries = m_baseline.get_entries(slot, timebin);
+        if (entries > 100)
         {
-          continue;
-          //	  fee_entries_vec_it = (*fee_entries_it).second.begin();
+          nhistfilled++;
         }
-        std::vector<int>::iterator fee_entries_vec_it = (*fee_entries_it).second.begin();
 
-        std::vector<double> pedvec(hist2d->GetNbinsX(), 0);
-        feebaseline_map.insert(std::make_pair(hiter.first, pedvec));
-        std::map<unsigned int, std::vector<double>>::iterator fee_blm_it = feebaseline_map.find(hiter.first);
-        (*fee_blm_it).second.resize(hist2d->GetNbinsX(), 0);
-        for (int binx = 1; binx < hist2d->GetNbinsX(); binx++)
+        if (m_writeTree)
         {
-          double timebin = (hist2d->GetXaxis())->GetBinCenter(binx);
-          std::string histname1d = "h" + std::to_string(hiter.first) + "_" + std::to_string((int) timebin);
-          nhisttotal++;
-          double local_ped = 0;
-          double local_width = 0;
-          double entries = fee_entries_vec_it[timebin];
-          if (fee_entries_vec_it[timebin] > 100)
-          {
-            nhistfilled++;
-
-            TH1D* hist1d = hist2d->ProjectionY(histname1d.c_str(), binx, binx);
-            if (hist1d->GetEntries() != fee_entries_vec_it[timebin])
-            {
-              std::cout << " vec " << fee_entries_vec_it[timebin]
-                        << " hist " << hist1d->GetEntries()
-                        << std::endl;
-            }
-            if (hist1d->GetEntries() > 10)
-            {
-              int maxbin = hist1d->GetMaximumBin();
-              // calc peak position
-              double hadc_sum = 0.0;
-              double hibin_sum = 0.0;
-              double hibin2_sum = 0.0;
-
-              for (int isum = -3; isum <= 3; isum++)
-              {
-                double val = hist1d->GetBinContent(maxbin + isum);
-                double center = hist1d->GetBinCenter(maxbin + isum);
-                hibin_sum += center * val;
-                hibin2_sum += center * center * val;
-                hadc_sum += val;
-              }
-              local_ped = hibin_sum / hadc_sum;
-              local_width = sqrt((hibin2_sum / hadc_sum) - (local_ped * local_ped));
-            }
-            delete hist1d;
-          }
-          (*fee_blm_it).second[(int) timebin] = local_ped + m_baseline_nsigma * local_width;
-
-          if (m_writeTree)
-          {
-            float fXh[11];
-            int nh = 0;
+          float fXh[11];
+          int nh = 0;
 
-            fXh[nh++] = _ievent - 1;
-            fXh[nh++] = 0;                        // gtm_bco;
-            fXh[nh++] = 0;                        // packet_id;
-            fXh[nh++] = 0;                        // ep;
-            fXh[nh++] = mc_sectors[sector % 12];  // Sector;
-            fXh[nh++] = side;
-            fXh[nh++] = fee;
-            fXh[nh++] = rx;
-            fXh[nh++] = entries;
-            fXh[nh++] = local_ped;
-            fXh[nh++] = local_width;
-            m_ntup->Fill(fXh);
-          }
+          fXh[nh++] = _ievent - 1;
+          fXh[nh++] = 0;                        // gtm_bco;
+          fXh[nh++] = 0;                        // packet_id;
+          fXh[nh++] = 0;                        // ep;
+          fXh[nh++] = mc_sectors[sector % 12];  // Sector;
+          fXh[nh++] = side;
+          fXh[nh++] = fee;
+          fXh[nh++] = rx;
+          fXh[nh++] = entries;
+          fXh[nh++] = m_baseline.get_pedestal(slot, timebin);
+          fXh[nh++] = m_baseline.get_width(slot, timebin);
+          m_ntup->Fill(fXh);
         }
       }
     }
@@ -599,29 +559,23 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
         unsigned short tbin = TpcDefs::getTBin(hitr->first);
         unsigned short adc = (hitr->second->getAdc());
 
-        unsigned int pad_key = create_pad_key(side, layer, phibin);
-
-        double fee = 0;
-        std::map<unsigned int, chan_info>::iterator chan_it = chan_map.find(pad_key);
-        if (chan_it != chan_map.end())
+        int fee = 0;
+        if (layer < m_nLayers)
         {
-          chan_info cinfo = (*chan_it).second;
-          fee = cinfo.fee;
-          // hpedestal2 = cinfo.ped;
-          // hpedwidth2 = cinfo.width;
+          const std::vector<short>& pad_fee = m_pad_fee[(side * m_nLayers) + layer];
+          if (phibin < pad_fee.size() && pad_fee[phibin] >= 0)
+          {
+            fee = pad_fee[phibin];
+          }
         }
 
         int rx = get_rx(layer);
         double corr = 0;
 
-        unsigned int fee_key = create_fee_key(side, sector, rx, fee);
-        std::map<unsigned int, std::vector<double>>::iterator fee_blm_it = feebaseline_map.find(fee_key);
-        if (fee_blm_it != feebaseline_map.end())
+        unsigned int slot = fee_slot(side, sector, rx, fee);
+        if (slot < m_baseline.get_nslots() && m_baseline.is_booked(slot))
         {
-          if (tbin < (int) (*fee_blm_it).second.size())
-          {
-            corr = (*fee_blm_it).second[tbin];
-          }
+          corr = m_baseline.get_baseline(slot, tbin);
           hitr->second->setAdc(0);
           double nuadc = (double(adc) - corr);
           nuadc = std::max<double>(nuadc, 0);
@@ -656,19 +610,8 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       }
     }
   }
-  // reset histogramms
-  for (auto& hiter2 : feeadc_map)
-  {
-    if (hiter2.second != nullptr)
-    {
-      hiter2.second->Reset();
-    }
-  }
-  feebaseline_map.clear();
-  for (auto& hiter_entries : feeentries_map)
-  {
-    hiter_entries.second.assign(hiter_entries.second.size(), 0);
-  }
+  // reset baseline counters
+  m_baseline.reset();
 
   if (Verbosity())
   {
@@ -3,10 +3,11 @@
 #ifndef TPC_COMBINEDRAWDATAUNPACKER_H
 #define TPC_COMBINEDRAWDATAUNPACKER_H
 
+#include "TpcBaselineEngine.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <limits>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -85,12 +86,31 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   }
 
  private:
-  struct chan_info
+  static constexpr int m_nFees = 26;
+  static constexpr int m_nChannels = 256;
+  static constexpr int m_nPacketSectors = 24;
+  static constexpr int m_nLayers = 55;
+
+  //! dense index of a fee in the baseline engine
+  static unsigned int fee_slot(unsigned int side, unsigned int sector, unsigned int rx, unsigned int fee)
+  {
+    return (((side * 12 + sector) * 3 + rx) * m_nFees) + fee;
+  }
+  //! inverse of fee_slot
+  static void unpack_fee_slot(unsigned int &side, unsigned int &sector, unsigned int &rx, unsigned int &fee, unsigned int slot)
+  {
+    fee = slot % m_nFees;
+    slot /= m_nFees;
+    rx = slot % 3;
+    slot /= 3;
+    sector = slot % 12;
+    side = slot / 12;
+  }
+
+  struct pad_info
   {
-    unsigned int fee = std::numeric_limits<unsigned int>::max();
-    double ped = -1;
-    double width = -1;
-    int entries = 0;
+    int layer = std::numeric_limits<int>::min();
+    double phi = 0;
   };
   TNtuple *m_ntup{nullptr};
   TNtuple *m_ntup_hits{nullptr};
@@ -122,10 +142,10 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   int m_zs_threshold[3] = {20}; // zs per TPC region
   std::string m_TpcRawNodeName{"TPCRAWHIT"};
   std::string outfile_name;
-  std::map<unsigned int, chan_info> chan_map;                  // stays in place
-  std::map<unsigned int, TH2 *> feeadc_map;                    // histos reset after each event
-  std::map<unsigned int, std::vector<int>> feeentries_map;     // cleared after each event
-  std::map<unsigned int, std::vector<double>> feebaseline_map;  // cleared after each event
+  std::vector<pad_info> m_pad_table;            // layer and phi from the channel map, indexed by fee * m_nChannels + channel
+  std::vector<int> m_phibin_table;              // phibin by (packet sector, fee, channel), filled on first use, -1 if not yet known
+  std::vector<std::vector<short>> m_pad_fee;    // fee by (side, layer) and phibin, stays in place
+  TpcBaselineEngine m_baseline;                 // counters reset after each event
 };
 
 #endif  // TPC_COMBINEDRAWDATAUNPACKER_H
@@ -12,8 +12,10 @@
 #include <phool/getClass.h>
 #include <phool/PHCompositeNode.h>
 #include <trackbase/ActsGeometry.h>
+#include <trackbase/ClusterErrorPara.h>
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
 
 //____________________________________________________________________________________________________________________
 void TpcGlobalPositionWrapper::loadNodes( PHCompositeNode* topNode )
@@ -43,6 +45,36 @@ void TpcGlobalPositionWrapper::loadNodes( PHCompositeNode* topNode )
   {
     std::cout << "TpcGlobalPositionWrapper::loadNodes - found fluctuation TPC distortion correction container" << std::endl;
   }
+
+  // global position cache
+  m_cache = findNode::getClass<TrkrClusterGlobalPositionCache>(topNode, "TRKR_CLUSTER_GLOBALPOSITION");
+  if (m_cache && m_verbosity > 0)
+  {
+    std::cout << "TpcGlobalPositionWrapper::loadNodes - found cluster global position cache" << std::endl;
+  }
+}
+
+//____________________________________________________________________________________________________________________
+unsigned int TpcGlobalPositionWrapper::configuration() const
+{
+  unsigned int value = 0;
+  if (m_enable_module_edge_corr && m_dcc_module_edge)
+  {
+    value |= 1U << 0U;
+  }
+  if (m_enable_static_corr && m_dcc_static)
+  {
+    value |= 1U << 1U;
+  }
+  if (m_enable_average_corr && m_dcc_average)
+  {
+    value |= 1U << 2U;
+  }
+  if (m_enable_fluctuation_corr && m_dcc_fluctuation)
+  {
+    value |= 1U << 3U;
+  }
+  return value;
 }
 
 //____________________________________________________________________________________________________________________
@@ -72,6 +104,19 @@ Acts::Vector3 TpcGlobalPositionWrapper::applyDistortionCorrections(Acts::Vector3
   return global;
 }
 
+//____________________________________________________________________________________________________________________
+std::pair<double, double> TpcGlobalPositionWrapper::getClusterError(const TrkrDefs::cluskey& key, TrkrCluster* cluster) const
+{
+  // use cached errors if available
+  std::pair<double, double> error;
+  if (m_use_cache && m_cache && m_cache->get_error(key, cluster, error))
+  {
+    return error;
+  }
+
+  return ClusterErrorPara::get_clusterv5_modified_error(cluster, 0, key);
+}
+
 //____________________________________________________________________________________________________________________
 Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey& key, TrkrCluster* cluster, short int crossing ) const
 {
@@ -82,6 +127,16 @@ Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(con
     return {0,0,0};
   }
 
+  // use cached position if available
+  if (m_use_cache && m_cache)
+  {
+    Acts::Vector3 cached;
+    if (m_cache->get(key, cluster, crossing, configuration(), cached))
+    {
+      return cached;
+    }
+  }
+
   // get global position from acts
   Acts::Vector3 global = m_tGeometry->getGlobalPosition(key, cluster);
 
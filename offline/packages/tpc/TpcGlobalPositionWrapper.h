@@ -10,11 +10,13 @@
 
 #include <trackbase/TrkrDefs.h>
 
+#include <utility>
 
 class ActsGeometry;
 class PHCompositeNode;
 class TpcDistortionCorrectionContainer;
 class TrkrCluster;
+class TrkrClusterGlobalPositionCache;
 
 class TpcGlobalPositionWrapper
 {
@@ -48,6 +50,12 @@ class TpcGlobalPositionWrapper
   void set_enable_average_corr(bool flag) { m_enable_average_corr = flag; }
   void set_enable_fluctuation_corr(bool flag) { m_enable_fluctuation_corr = flag; }
 
+  //! use event wide global position cache, if found on the node tree
+  void set_use_cache(bool flag) { m_use_cache = flag; }
+
+  //! bit pattern of the distortion corrections effectively applied
+  unsigned int configuration() const;
+
   //! apply all loaded distortion corrections to a given position
   Acts::Vector3 applyDistortionCorrections( Acts::Vector3 /*source*/ ) const;
 
@@ -58,6 +66,10 @@ class TpcGlobalPositionWrapper
    */
   Acts::Vector3 getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey&, TrkrCluster*, short int /*crossing*/ ) const;
 
+  //! get squared parametrized cluster errors, same as ClusterErrorPara::get_clusterv5_modified_error
+  /** uses the event wide cache when available */
+  std::pair<double, double> getClusterError(const TrkrDefs::cluskey&, TrkrCluster*) const;
+
   private:
 
   //! verbosity
@@ -87,6 +99,10 @@ class TpcGlobalPositionWrapper
   TpcDistortionCorrectionContainer* m_dcc_fluctuation{nullptr};
   bool m_enable_fluctuation_corr = true;
 
+  //! event wide global position cache
+  TrkrClusterGlobalPositionCache* m_cache = nullptr;
+  bool m_use_cache = true;
+
 };
 
 #endif
@@ -0,0 +1,115 @@
+/*!
+ * \file TrkrClusterGlobalPositionCacheMaker.cc
+ * \brief fills the event wide table of corrected cluster global positions, used by TpcGlobalPositionWrapper
+ */
+
+#include "TrkrClusterGlobalPositionCacheMaker.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+//_____________________________________________________________________
+TrkrClusterGlobalPositionCacheMaker::TrkrClusterGlobalPositionCacheMaker(const std::string& name)
+  : SubsysReco(name)
+{
+}
+
+//_____________________________________________________________________
+int TrkrClusterGlobalPositionCacheMaker::InitRun(PHCompositeNode* topNode)
+{
+  m_clusterMap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
+  if (!m_clusterMap)
+  {
+    std::cout << "TrkrClusterGlobalPositionCacheMaker::InitRun - TRKR_CLUSTER node missing, quitting" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  m_cache = findNode::getClass<TrkrClusterGlobalPositionCache>(topNode, "TRKR_CLUSTER_GLOBALPOSITION");
+  if (!m_cache)
+  {
+    PHNodeIterator iter(topNode);
+    auto* dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
+    if (!dstNode)
+    {
+      std::cout << "TrkrClusterGlobalPositionCacheMaker::InitRun - DST node missing, quitting" << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+
+    PHNodeIterator dstiter(dstNode);
+    auto* trkrNode = dynamic_cast<PHCompositeNode*>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+    if (!trkrNode)
+    {
+      trkrNode = new PHCompositeNode("TRKR");
+      dstNode->addNode(trkrNode);
+    }
+
+    // transient, never written to the output
+    m_cache = new TrkrClusterGlobalPositionCache;
+    trkrNode->addNode(new PHDataNode<PHObject>(m_cache, "TRKR_CLUSTER_GLOBALPOSITION", "PHObject"));
+  }
+
+  // positions are always computed here
+  m_globalPositionWrapper.set_verbosity(Verbosity());
+  m_globalPositionWrapper.loadNodes(topNode);
+  m_globalPositionWrapper.set_use_cache(false);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_____________________________________________________________________
+int TrkrClusterGlobalPositionCacheMaker::process_event(PHCompositeNode* /*topNode*/)
+{
+  m_cache->init(m_clusterMap, m_crossing, m_globalPositionWrapper.configuration());
+
+  const size_t nslots = m_cache->size();
+  const auto fill = [this](size_t begin, size_t end)
+  {
+    for (size_t slot = begin; slot < end; ++slot)
+    {
+      auto* cluster = m_cache->cluster(slot);
+      if (cluster)
+      {
+        m_cache->set(slot, m_globalPositionWrapper.getGlobalPositionDistortionCorrected(m_cache->key(slot), cluster, m_crossing));
+      }
+    }
+  };
+
+  // split slots in contiguous chunks, one per thread
+  const size_t nthreads = std::clamp<size_t>(m_nthreads, 1, std::max<size_t>(1, nslots / 1000));
+  if (nthreads == 1)
+  {
+    fill(0, nslots);
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    const size_t chunk = (nslots + nthreads - 1) / nthreads;
+    for (size_t begin = 0; begin < nslots; begin += chunk)
+    {
+      threads.emplace_back(fill, begin, std::min(nslots, begin + chunk));
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    m_cache->identify();
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
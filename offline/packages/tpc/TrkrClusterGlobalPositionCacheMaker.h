@@ -0,0 +1,63 @@
+#ifndef TPC_TRKRCLUSTERGLOBALPOSITIONCACHEMAKER_H
+#define TPC_TRKRCLUSTERGLOBALPOSITIONCACHEMAKER_H
+
+/*!
+ * \file TrkrClusterGlobalPositionCacheMaker.h
+ * \brief fills the event wide table of corrected cluster global positions, used by TpcGlobalPositionWrapper
+ */
+
+#include "TpcGlobalPositionWrapper.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class TrkrClusterContainer;
+class TrkrClusterGlobalPositionCache;
+
+/*!
+ * computes the global position of all clusters once per event, with all TPC corrections applied,
+ * and stores them in the TRKR_CLUSTER_GLOBALPOSITION node.
+ * Must be registered after the clustering and after any module which modifies or moves clusters.
+ * Modules registered afterwards get the positions from the table through TpcGlobalPositionWrapper,
+ * as long as they use the same crossing and the same distortion corrections.
+ */
+class TrkrClusterGlobalPositionCacheMaker : public SubsysReco
+{
+ public:
+  //! constructor
+  TrkrClusterGlobalPositionCacheMaker(const std::string& = "TrkrClusterGlobalPositionCacheMaker");
+
+  //! run initialization
+  int InitRun(PHCompositeNode*) override;
+
+  //! event processing
+  int process_event(PHCompositeNode*) override;
+
+  //! crossing used for TPC clusters
+  void set_crossing(short int value) { m_crossing = value; }
+
+  //! number of threads used to fill the table
+  void set_nthreads(unsigned int value) { m_nthreads = value; }
+
+  //! global position wrapper, to configure distortion corrections
+  TpcGlobalPositionWrapper& globalPositionWrapper() { return m_globalPositionWrapper; }
+
+ private:
+  //! crossing
+  short int m_crossing = 0;
+
+  //! number of threads
+  unsigned int m_nthreads = 4;
+
+  //! cluster container
+  TrkrClusterContainer* m_clusterMap = nullptr;
+
+  //! global position table
+  TrkrClusterGlobalPositionCache* m_cache = nullptr;
+
+  //! global position wrapper, used to compute positions
+  TpcGlobalPositionWrapper m_globalPositionWrapper;
+};
+
+#endif
@@ -73,6 +73,22 @@ namespace
     return std::sqrt(square(x) + square(y));
   }
 
+  // truth stripe lookup grid dimensions
+  constexpr int truth_grid_rbins = 100;
+  constexpr double truth_grid_rmax = 100;  // cm
+  constexpr int truth_grid_phibins = 256;
+
+  int truth_grid_rbin(double r)
+  {
+    return std::clamp(static_cast<int>(std::floor(r * truth_grid_rbins / truth_grid_rmax)), 0, truth_grid_rbins - 1);
+  }
+
+  // unbounded, to be wrapped by the caller
+  int truth_grid_phibin(double phi)
+  {
+    return static_cast<int>(std::floor((phi + M_PI) * truth_grid_phibins / (2. * M_PI)));
+  }
+
   // stream acts vector3
   [[maybe_unused]] std::ostream& operator<<(std::ostream& out, const Acts::Vector3& v)
   {
@@ -978,6 +994,102 @@ int TpcCentralMembraneMatching::getClusterRMatch(double clusterR, int side)
   return -1;
 }
 
+//____________________________________________________________________________..
+void TpcCentralMembraneMatching::buildTruthGrid()
+{
+  m_truth_r.clear();
+  m_truth_phi.clear();
+  m_truth_RIndex.clear();
+  for (const auto& truth : m_truth_pos)
+  {
+    const double tR = get_r(truth.X(), truth.Y());
+    m_truth_r.push_back(tR);
+    m_truth_phi.push_back(truth.Phi());
+
+    // get which hit radial index this it
+    int truthRIndex = -1;
+    for (int k = 0; k < (int) m_truth_RPeaks.size(); k++)
+    {
+      if (std::abs(tR - m_truth_RPeaks[k]) < 0.5)
+      {
+        truthRIndex = k;
+        break;
+      }
+    }
+    m_truth_RIndex.push_back(truthRIndex);
+  }
+
+  // count stripes per cell, then store indices, keeping truth ordering within each cell
+  const auto cell = [this](unsigned int i)
+  {
+    const int phibin = (truth_grid_phibin(m_truth_phi[i]) % truth_grid_phibins + truth_grid_phibins) % truth_grid_phibins;
+    return truth_grid_rbin(m_truth_r[i]) * truth_grid_phibins + phibin;
+  };
+
+  for (int side = 0; side < 2; ++side)
+  {
+    auto& first = m_truth_grid_first[side];
+    auto& index = m_truth_grid_index[side];
+    first.assign(truth_grid_rbins * truth_grid_phibins + 1, 0);
+    index.clear();
+
+    std::vector<unsigned int> selected;
+    for (unsigned int i = 0; i < m_truth_pos.size(); ++i)
+    {
+      if ((m_truth_pos[i].Z() > 0) == (side == 1))
+      {
+        selected.push_back(i);
+        ++first[cell(i) + 1];
+      }
+    }
+
+    for (int c = 0; c < truth_grid_rbins * truth_grid_phibins; ++c)
+    {
+      first[c + 1] += first[c];
+    }
+
+    index.resize(selected.size());
+    auto next = first;
+    for (const auto& i : selected)
+    {
+      index[next[cell(i)]++] = i;
+    }
+  }
+}
+
+//____________________________________________________________________________..
+void TpcCentralMembraneMatching::getTruthCandidates(bool side, double r, double dr, double phi, double dphi, std::vector<int>& candidates) const
+{
+  const auto& first = m_truth_grid_first[side ? 1 : 0];
+  const auto& index = m_truth_grid_index[side ? 1 : 0];
+  if (first.empty())
+  {
+    return;
+  }
+
+  // one extra bin on each side guards against rounding at cell boundaries
+  const int rlow = std::max(0, truth_grid_rbin(r - dr) - 1);
+  const int rhigh = std::min(truth_grid_rbins - 1, truth_grid_rbin(r + dr) + 1);
+
+  int philow = truth_grid_phibin(phi - dphi) - 1;
+  int phihigh = truth_grid_phibin(phi + dphi) + 1;
+  if (phihigh - philow + 1 >= truth_grid_phibins)
+  {
+    philow = 0;
+    phihigh = truth_grid_phibins - 1;
+  }
+
+  for (int rbin = rlow; rbin <= rhigh; ++rbin)
+  {
+    for (int iphi = philow; iphi <= phihigh; ++iphi)
+    {
+      const int phibin = (iphi % truth_grid_phibins + truth_grid_phibins) % truth_grid_phibins;
+      const int c = rbin * truth_grid_phibins + phibin;
+      candidates.insert(candidates.end(), index.begin() + first[c], index.begin() + first[c + 1]);
+    }
+  }
+}
+
 //____________________________________________________________________________..
 int TpcCentralMembraneMatching::InitRun(PHCompositeNode* topNode)
 {
@@ -1117,6 +1229,9 @@ int TpcCentralMembraneMatching::InitRun(PHCompositeNode* topNode)
 
   }
 
+  // truth positions do not change during the run
+  buildTruthGrid();
+
   //const double phi_petal = M_PI / 9.0;  // angle span of one petal
 
   /*
@@ -1646,24 +1761,66 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
       }
     }
 
-    for (const auto& truth : m_truth_pos)
+    // reco cluster radius, azimuth corrected for the region rotation, and radial peak match
+    // these do not depend on the truth stripe, and are computed once per cluster
+    std::vector<double> reco_R(reco_pos.size());
+    std::vector<double> reco_rotatedPhi(reco_pos.size());
+    std::vector<int> reco_RMatchIndex(reco_pos.size());
+
+    // reco clusters with enough hits, grouped by radial peak match, in increasing index order
+    std::vector<std::vector<unsigned int>> reco_byRMatch(m_truth_RPeaks.size());
+    for (unsigned int reco_index = 0; reco_index < reco_pos.size(); ++reco_index)
     {
-      double tR = get_r(truth.X(), truth.Y());
-      double tPhi = truth.Phi();
-      double tZ = truth.Z();
+      const auto& reco = reco_pos[reco_index];
+      double rR = get_r(reco.X(), reco.Y());
+      double rPhi = reco.Phi();
+      bool side = reco_side[reco_index];
 
-      int truthRIndex = -1;
+      int region = -1;
+
+      if (rR < 41)
+      {
+        region = 0;
+      }
+      else if (rR >= 41 && rR < 58)
+      {
+        region = 1;
+      }
+      else if (rR >= 58)
+      {
+        region = 2;
+      }
 
-      // get which hit radial index this it
-      for (int k = 0; k < (int) m_truth_RPeaks.size(); k++)
+      if (region != -1)
       {
-        if (std::abs(tR - m_truth_RPeaks[k]) < 0.5)
+        if (side)
         {
-          truthRIndex = k;
-          break;
+          rPhi -= m_recoRotation[1][region];
+        }
+        else
+        {
+          rPhi -= m_recoRotation[0][region];
         }
       }
 
+      const int clustRMatchIndex = getClusterRMatch(rR, (side ? 1 : 0));
+      reco_R[reco_index] = rR;
+      reco_rotatedPhi[reco_index] = rPhi;
+      reco_RMatchIndex[reco_index] = clustRMatchIndex;
+
+      if (reco_nhits[reco_index] >= m_nHitsInCuster_minimum && clustRMatchIndex >= 0 && clustRMatchIndex < (int) reco_byRMatch.size())
+      {
+        reco_byRMatch[clustRMatchIndex].push_back(reco_index);
+      }
+    }
+
+    for (const auto& truth : m_truth_pos)
+    {
+      double tR = m_truth_r[truth_index];
+      double tPhi = m_truth_phi[truth_index];
+      double tZ = truth.Z();
+
+      const int truthRIndex = m_truth_RIndex[truth_index];
       if (truthRIndex == -1)
       {
         truth_index++;
@@ -1672,66 +1829,24 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
 
       double prev_dphi = 10000.0;
 
+      // only reco clusters matched to the same radial peak are candidates
       int recoMatchIndex = -1;
-      unsigned int reco_index = 0;
-      for (const auto& reco : reco_pos)
+      for (const auto& reco_index : reco_byRMatch[truthRIndex])
       {
-        if (reco_matched[reco_index] || reco_nhits[reco_index] < m_nHitsInCuster_minimum)
+        if (reco_matched[reco_index])
         {
-          reco_index++;
           continue;
         }
 
-        double rR = get_r(reco.X(), reco.Y());
-        double rPhi = reco.Phi();
         bool side = reco_side[reco_index];
-
-        int region = -1;
-
-        if (rR < 41)
-        {
-          region = 0;
-        }
-        else if (rR >= 41 && rR < 58)
-        {
-          region = 1;
-        }
-        else if (rR >= 58)
-        {
-          region = 2;
-        }
-
-        if (region != -1)
-        {
-          if (side)
-          {
-            rPhi -= m_recoRotation[1][region];
-          }
-          else
-          {
-            rPhi -= m_recoRotation[0][region];
-          }
-        }
-
-        int clustRMatchIndex = -1;
-        clustRMatchIndex = getClusterRMatch(rR, (side ? 1 : 0));
-
-        if (clustRMatchIndex == -1 || truthRIndex != clustRMatchIndex)
-        {
-          reco_index++;
-          continue;
-        }
-
         if ((!side && tZ > 0) || (side && tZ < 0))
         {
-          reco_index++;
           continue;
         }
 
-        auto dphi = delta_phi(tPhi - rPhi);
+        auto dphi = delta_phi(tPhi - reco_rotatedPhi[reco_index]);
         if (fabs(dphi) > m_phi_cut)
         {
-          reco_index++;
           continue;
         }
 
@@ -1741,8 +1856,6 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
           recoMatchIndex = reco_index;
           truth_matched[truth_index] = true;
         }
-
-        reco_index++;
       }  // end loop over reco
 
       if (recoMatchIndex != -1)
@@ -1768,39 +1881,10 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     int recoIndex = 0;
     for (const auto& reco : reco_pos)
     {
-      double rR = get_r(reco.X(), reco.Y());
-      double rPhi = reco.Phi();
+      double rR = reco_R[recoIndex];
+      double rPhi = reco_rotatedPhi[recoIndex];
       bool side = reco_side[recoIndex];
-
-      int region = -1;
-
-      if (rR < 41)
-      {
-        region = 0;
-      }
-      else if (rR >= 41 && rR < 58)
-      {
-        region = 1;
-      }
-      else if (rR >= 58)
-      {
-        region = 2;
-      }
-
-      if (region != -1)
-      {
-        if (side)
-        {
-          rPhi -= m_recoRotation[1][region];
-        }
-        else
-        {
-          rPhi -= m_recoRotation[0][region];
-        }
-      }
-
-      int clustRMatchIndex = -1;
-      clustRMatchIndex = getClusterRMatch(rR, (side ? 1 : 0));
+      int clustRMatchIndex = reco_RMatchIndex[recoIndex];
 
       int truthMatchIndex = -1;
       truth_index = 0;
@@ -1841,18 +1925,8 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
           continue;
         }
 
-        int truthRIndex = -1;
-
-        // get which hit radial index this it
-        for (int k = 0; k < (int) m_truth_RPeaks.size(); k++)
-        {
-          if (std::abs(tR - m_truth_RPeaks[k]) < 0.5)
-          {
-            truthRIndex = k;
-            break;
-          }
-        }
-
+        // truth_index is in sync with the truth stripe here, since clustRMatchIndex is valid
+        const int truthRIndex = m_truth_RIndex[truth_index];
         if (truthRIndex == -1 || truthRIndex != clustRMatchIndex)
         {
           truth_index++;
@@ -1893,6 +1967,7 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
   }  // end fancy
   else
   {
+    std::vector<int> truth_candidates;
     int reco_index = 0;
     for (const auto& reco : reco_pos)
     {
@@ -1900,43 +1975,43 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
       double rPhi = reco.Phi();
       bool side = reco_side[reco_index];
 
-      truth_index = 0;
+      // only truth stripes from the lookup grid cells around the cluster can pass the dR and dphi cuts
+      truth_candidates.clear();
+      getTruthCandidates(side, rR, 5.0, rPhi, 0.05, truth_candidates);
+
       double minNNDist = 100000.0;
       int match_localTruth = -1;
-      for (const auto& truth : m_truth_pos)
+      for (const auto& candidate : truth_candidates)
       {
-        // std::cout << "reco_index " << reco_index << "   truth_index " << truth_index << std::endl;
-        double tR = get_r(truth.X(), truth.Y());
-        double tPhi = truth.Phi();
+        const auto& truth = m_truth_pos[candidate];
+        double tR = m_truth_r[candidate];
+        double tPhi = m_truth_phi[candidate];
         double tZ = truth.Z();
 
         if ((!side && tZ > 0) || (side && tZ < 0))
         {
-          truth_index++;
           continue;
         }
 
         auto dR = fabs(tR - rR);
         if (dR > 5.0)
         {
-          truth_index++;
           continue;
         }
 
         auto dphi = delta_phi(tPhi - rPhi);
         if (fabs(dphi) > 0.05)
         {
-          truth_index++;
           continue;
         }
 
+        // candidates are not ordered. On equal distance, keep the first truth stripe
         double dist = sqrt(pow(truth.X() - reco.X(), 2) + pow(truth.Y() - reco.Y(), 2));
-        if (dist < minNNDist)
+        if (dist < minNNDist || (dist == minNNDist && candidate < match_localTruth))
         {
           minNNDist = dist;
-          match_localTruth = truth_index;
+          match_localTruth = candidate;
         }
-        truth_index++;
       }  // end truth loop
 
       if (match_localTruth == -1)
@@ -156,6 +156,13 @@ class TpcCentralMembraneMatching : public SubsysReco
 
   int getClusterRMatch(double clusterR, int side);
 
+  /// cache truth stripe radius, azimuth and radial peak index, and fill the truth lookup grid
+  void buildTruthGrid();
+
+  /// append indices of truth stripes on a given side, within dr and dphi of a given position
+  /** the list may contain extra stripes, outside of the requested window */
+  void getTruthCandidates(bool side, double r, double dr, double phi, double dphi, std::vector<int> &candidates) const;
+
   //! tpc distortion correction utility class
   TpcDistortionCorrection m_distortionCorrection;
 
@@ -402,6 +409,16 @@ class TpcCentralMembraneMatching : public SubsysReco
   std::vector<TVector3> m_truth_pos;
   std::vector<int> m_truth_index;
 
+  /// truth stripe radius, azimuth and matching radial peak index (or -1), in the same order as m_truth_pos
+  std::vector<double> m_truth_r;
+  std::vector<double> m_truth_phi;
+  std::vector<int> m_truth_RIndex;
+
+  /// truth stripe lookup grid in r and phi, per side
+  /** indices of the stripes in cell i are m_truth_grid_index[side][m_truth_grid_first[side][i]] to m_truth_grid_index[side][m_truth_grid_first[side][i+1]-1] */
+  std::vector<unsigned int> m_truth_grid_first[2];
+  std::vector<int> m_truth_grid_index[2];
+
   std::vector<double> m_truth_RPeaks{22.709, 23.841, 24.973, 26.1049, 27.2369, 28.3689, 29.5009, 30.6328, 31.7648, 32.8968, 34.0288, 35.1607, 36.2927, 37.4247, 38.5566, 39.6886, 42.1706, 44.2119, 46.2533, 48.2947, 50.3361, 52.3774, 54.4188, 56.4602, 59.4605, 61.6546, 63.8487, 66.0428, 68.2369, 70.431, 72.6251, 74.8192};
 
   //@}
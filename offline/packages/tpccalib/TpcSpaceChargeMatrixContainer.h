@@ -73,6 +73,30 @@ class TpcSpaceChargeMatrixContainer : public PHObject
   virtual float get_rhs_z(int /*cell_index*/, int /*i*/ ) const
   { return 0; }
 
+  /// get pointer to contiguous, row-major left hand side matrix for a given cell. nullptr if not available
+  virtual const float* get_lhs_array( int /*cell_index*/ ) const
+  { return nullptr; }
+
+  /// get pointer to contiguous right hand side column for a given cell. nullptr if not available
+  virtual const float* get_rhs_array( int /*cell_index*/ ) const
+  { return nullptr; }
+
+  /// get pointer to contiguous, row-major reduced rphi left hand side matrix for a given cell. nullptr if not available
+  virtual const float* get_lhs_rphi_array( int /*cell_index*/ ) const
+  { return nullptr; }
+
+  /// get pointer to contiguous reduced rphi right hand side column for a given cell. nullptr if not available
+  virtual const float* get_rhs_rphi_array( int /*cell_index*/ ) const
+  { return nullptr; }
+
+  /// get pointer to contiguous, row-major reduced z left hand side matrix for a given cell. nullptr if not available
+  virtual const float* get_lhs_z_array( int /*cell_index*/ ) const
+  { return nullptr; }
+
+  /// get pointer to contiguous reduced z right hand side column for a given cell. nullptr if not available
+  virtual const float* get_rhs_z_array( int /*cell_index*/ ) const
+  { return nullptr; }
+
   //@}
 
   ///@name modifiers
@@ -133,6 +133,42 @@ float TpcSpaceChargeMatrixContainerv2::get_rhs_z(int cell_index, int i) const
   return m_rhs_z[cell_index][i];
 }
 
+//___________________________________________________________
+const float* TpcSpaceChargeMatrixContainerv2::get_lhs_array(int cell_index) const
+{
+  return bound_check(cell_index) ? m_lhs[cell_index].data() : nullptr;
+}
+
+//___________________________________________________________
+const float* TpcSpaceChargeMatrixContainerv2::get_rhs_array(int cell_index) const
+{
+  return bound_check(cell_index) ? m_rhs[cell_index].data() : nullptr;
+}
+
+//___________________________________________________________
+const float* TpcSpaceChargeMatrixContainerv2::get_lhs_rphi_array(int cell_index) const
+{
+  return bound_check(cell_index) ? m_lhs_rphi[cell_index].data() : nullptr;
+}
+
+//___________________________________________________________
+const float* TpcSpaceChargeMatrixContainerv2::get_rhs_rphi_array(int cell_index) const
+{
+  return bound_check(cell_index) ? m_rhs_rphi[cell_index].data() : nullptr;
+}
+
+//___________________________________________________________
+const float* TpcSpaceChargeMatrixContainerv2::get_lhs_z_array(int cell_index) const
+{
+  return bound_check(cell_index) ? m_lhs_z[cell_index].data() : nullptr;
+}
+
+//___________________________________________________________
+const float* TpcSpaceChargeMatrixContainerv2::get_rhs_z_array(int cell_index) const
+{
+  return bound_check(cell_index) ? m_rhs_z[cell_index].data() : nullptr;
+}
+
 //___________________________________________________________
 void TpcSpaceChargeMatrixContainerv2::Reset()
 {
@@ -239,6 +275,33 @@ bool TpcSpaceChargeMatrixContainerv2::add(const TpcSpaceChargeMatrixContainer& o
     return false;
   }
 
+  // same internal layout: add the flat arrays directly, without per element virtual calls and bound checks
+  if (const auto* other_v2 = dynamic_cast<const TpcSpaceChargeMatrixContainerv2*>(&other))
+  {
+    auto add_arrays = [](auto& destination, const auto& source)
+    {
+      for (size_t cell_index = 0; cell_index < destination.size(); ++cell_index)
+      {
+        for (size_t i = 0; i < destination[cell_index].size(); ++i)
+        {
+          destination[cell_index][i] += source[cell_index][i];
+        }
+      }
+    };
+
+    for (size_t cell_index = 0; cell_index < m_entries.size(); ++cell_index)
+    {
+      m_entries[cell_index] += other_v2->m_entries[cell_index];
+    }
+    add_arrays(m_lhs, other_v2->m_lhs);
+    add_arrays(m_rhs, other_v2->m_rhs);
+    add_arrays(m_lhs_rphi, other_v2->m_lhs_rphi);
+    add_arrays(m_rhs_rphi, other_v2->m_rhs_rphi);
+    add_arrays(m_lhs_z, other_v2->m_lhs_z);
+    add_arrays(m_rhs_z, other_v2->m_rhs_z);
+    return true;
+  }
+
   // increment cell entries
   for (size_t cell_index = 0; cell_index < m_lhs.size(); ++cell_index)
   {
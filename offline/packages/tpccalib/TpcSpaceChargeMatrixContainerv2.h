@@ -60,6 +60,24 @@ class TpcSpaceChargeMatrixContainerv2 : public TpcSpaceChargeMatrixContainer
   /// get reduced z right hand side
   float get_rhs_z(int cell_index, int i) const override;
 
+  /// get pointer to contiguous, row-major left hand side matrix
+  const float* get_lhs_array(int cell_index) const override;
+
+  /// get pointer to contiguous right hand side column
+  const float* get_rhs_array(int cell_index) const override;
+
+  /// get pointer to contiguous, row-major reduced rphi left hand side matrix
+  const float* get_lhs_rphi_array(int cell_index) const override;
+
+  /// get pointer to contiguous reduced rphi right hand side column
+  const float* get_rhs_rphi_array(int cell_index) const override;
+
+  /// get pointer to contiguous, row-major reduced z left hand side matrix
+  const float* get_lhs_z_array(int cell_index) const override;
+
+  /// get pointer to contiguous reduced z right hand side column
+  const float* get_rhs_z_array(int cell_index) const override;
+
   //@}
 
   ///@name modifiers
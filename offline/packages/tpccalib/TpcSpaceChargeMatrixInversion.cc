@@ -14,10 +14,15 @@
 #include <TFile.h>
 #include <TH2.h>
 #include <TH3.h>
+#include <TROOT.h>
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <omp.h>
+
+#include <array>
+#include <cmath>
 #include <memory>
 
 namespace
@@ -35,35 +40,83 @@ namespace
   float m_zmax =  102.605;
   float m_zmin = -102.605;
 
-  // convert internal data from TpcSpaceChargeMatrixContainer to 2D Eighen::Matrix
-  template<float (TpcSpaceChargeMatrixContainer::*accessor)(int /*cell*/, int /*row*/, int /*column*/) const, int N>
-    Eigen::Matrix<float, N, N> get_matrix( const TpcSpaceChargeMatrixContainer* container, int icell )
+  // get pointer to row-major N x N matrix data for a given cell
+  // use container storage directly when available, copy to buffer otherwise
+  template<
+    float (TpcSpaceChargeMatrixContainer::*accessor)(int /*cell*/, int /*row*/, int /*column*/) const,
+    const float* (TpcSpaceChargeMatrixContainer::*array_accessor)(int /*cell*/) const,
+    int N>
+    const float* get_matrix_data( const TpcSpaceChargeMatrixContainer* container, int icell, std::array<float, N*N>& buffer )
   {
-    Eigen::Matrix<float, N, N> out;
+    if( const auto *data = (container->*array_accessor)(icell) )
+    {
+      return data;
+    }
+
     for( int i = 0; i < N; ++i )
     {
       for( int j = 0; j < N; ++j )
       {
-        out(i, j) = (container->*accessor)(icell, i, j);
+        buffer[j + i*N] = (container->*accessor)(icell, i, j);
       }
     }
-
-    return out;
+    return buffer.data();
   }
 
-  // convert internal data from TpcSpaceChargeMatrixContainer to 1D Eighen::Matrix
-  template<float (TpcSpaceChargeMatrixContainer::*accessor)(int /*cell*/,int /*row*/) const, int N>
-    Eigen::Matrix<float, N, 1> get_column( const TpcSpaceChargeMatrixContainer* container, int icell )
+  // get pointer to N column data for a given cell
+  // use container storage directly when available, copy to buffer otherwise
+  template<
+    float (TpcSpaceChargeMatrixContainer::*accessor)(int /*cell*/, int /*row*/) const,
+    const float* (TpcSpaceChargeMatrixContainer::*array_accessor)(int /*cell*/) const,
+    int N>
+    const float* get_column_data( const TpcSpaceChargeMatrixContainer* container, int icell, std::array<float, N>& buffer )
   {
-    Eigen::Matrix<float, N, 1> out;
+    if( const auto *data = (container->*array_accessor)(icell) )
+    {
+      return data;
+    }
+
     for( int i = 0; i < N; ++i )
     {
-      out(i) = (container->*accessor)(icell, i);
+      buffer[i] = (container->*accessor)(icell, i);
     }
+    return buffer.data();
+  }
+
+  // eigen matrices mapped onto the container internal storage
+  template<int N>
+    using matrix_map_t = Eigen::Map<const Eigen::Matrix<float, N, N, Eigen::RowMajor>>;
 
-    return out;
+  template<int N>
+    using column_map_t = Eigen::Map<const Eigen::Matrix<float, N, 1>>;
+
+  // solve lhs.x = rhs for small fixed size matrices
+  // the inverse of 2x2 and 3x3 matrices is calculated in closed form by Eigen, and also provides the errors
+  template<int N>
+    void solve( const float* lhs_data, const float* rhs_data, float* result, float* error )
+  {
+    const matrix_map_t<N> lhs(lhs_data);
+    const column_map_t<N> rhs(rhs_data);
+    const Eigen::Matrix<float, N, N> cov = lhs.inverse();
+    const Eigen::Matrix<float, N, 1> x = cov * rhs;
+    for( int i = 0; i < N; ++i )
+    {
+      result[i] = x(i);
+      error[i] = std::sqrt(cov(i, i));
+    }
   }
 
+  // inversion result for a given cell
+  struct cell_result_t
+  {
+    bool valid = false;
+    int entries = 0;
+
+    // dphi, dz, dr and, for reduced inversions, dr obtained from the other reduced matrix
+    std::array<float, 4> value = {};
+    std::array<float, 4> error = {};
+  };
+
 }  // namespace
 
 //_____________________________________________________________________
@@ -169,6 +222,61 @@ bool TpcSpaceChargeMatrixInversion::add_from_file(const std::string& shortfilena
   return add(*source);
 }
 
+//_____________________________________________________________________
+bool TpcSpaceChargeMatrixInversion::add_from_files(const std::vector<std::string>& shortfilenames, const std::string& objectname)
+{
+  // get filenames from frog. Done upfront because FROG is not thread safe
+  std::vector<std::string> filenames;
+  FROG frog;
+  for (const auto& shortfilename : shortfilenames)
+  {
+    filenames.emplace_back(frog.location(shortfilename));
+  }
+
+  // files are read and decompressed in parallel. Matrices are added to the current one as they become available
+  ROOT::EnableThreadSafety();
+  if (m_num_threads >= 1)
+  {
+    omp_set_num_threads(m_num_threads);
+  }
+
+  bool success = true;
+  const int nfiles = filenames.size();
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < nfiles; ++i)
+  {
+    const auto& filename = filenames[i];
+    std::unique_ptr<TFile> inputfile(TFile::Open(filename.c_str()));
+    if (!inputfile)
+    {
+#pragma omp critical
+      {
+        std::cout << "TpcSpaceChargeMatrixInversion::add_from_files - could not open file " << filename << std::endl;
+        success = false;
+      }
+      continue;
+    }
+
+    std::unique_ptr<TpcSpaceChargeMatrixContainer> source(dynamic_cast<TpcSpaceChargeMatrixContainer*>(inputfile->Get(objectname.c_str())));
+    inputfile->Close();
+
+#pragma omp critical
+    {
+      if (!source)
+      {
+        std::cout << "TpcSpaceChargeMatrixInversion::add_from_files - could not find object name " << objectname << " in file " << filename << std::endl;
+        success = false;
+      }
+      else if (!add(*source))
+      {
+        success = false;
+      }
+    }
+  }
+
+  return success;
+}
+
 //_____________________________________________________________________
 bool TpcSpaceChargeMatrixInversion::add(const TpcSpaceChargeMatrixContainer& source)
 {
@@ -220,7 +328,16 @@ void TpcSpaceChargeMatrixInversion::calculate_distortion_corrections(const Inver
     h->GetZaxis()->SetTitle("z (cm)");
   }
 
-  // loop over bins
+  // solve all cells in parallel. The matrices are mapped directly onto the container storage
+  if (m_num_threads >= 1)
+  {
+    omp_set_num_threads(m_num_threads);
+  }
+
+  const auto* container = m_matrix_container.get();
+  std::vector<cell_result_t> results(phibins * rbins * zbins);
+
+#pragma omp parallel for collapse(3) schedule(static)
   for (int iphi = 0; iphi < phibins; ++iphi)
   {
     for (int ir = 0; ir < rbins; ++ir)
@@ -228,64 +345,33 @@ void TpcSpaceChargeMatrixInversion::calculate_distortion_corrections(const Inver
       for (int iz = 0; iz < zbins; ++iz)
       {
         // get cell index
-        const auto icell = m_matrix_container->get_cell_index(iphi, ir, iz);
+        const auto icell = container->get_cell_index(iphi, ir, iz);
 
         // minimum number of entries per bin
         static constexpr int min_cluster_count = 2;
-        const auto cell_entries = m_matrix_container->get_entries(icell);
+        const auto cell_entries = container->get_entries(icell);
         if (cell_entries < min_cluster_count)
         {
           continue;
         }
 
-        switch( inversionMode )
+        auto& result = results[iz + zbins * (ir + rbins * iphi)];
+        result.valid = true;
+        result.entries = cell_entries;
+
+        switch (inversionMode)
         {
           case InversionMode::FullInversion:
           {
             /* number of coordinates must match that of the matrix container */
             static constexpr int ncoord = 3;
-            using matrix_t = Eigen::Matrix<float, ncoord, ncoord>;
-            using column_t = Eigen::Matrix<float, ncoord, 1>;
-
-            // build eigen matrices from container
-            matrix_t lhs = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs,ncoord>(m_matrix_container.get(),icell);
-            column_t rhs = get_column<&TpcSpaceChargeMatrixContainer::get_rhs,ncoord>(m_matrix_container.get(),icell);
-
-            if (Verbosity())
-            {
-              // print matrices and entries
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - inverting bin " << iz << ", " << ir << ", " << iphi << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - entries: " << cell_entries << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - lhs: \n"
-                << lhs << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - rhs: \n"
-                << rhs << std::endl;
-            }
-
-            // calculate result using linear solving
-            const auto cov = lhs.inverse();
-            auto partialLu = lhs.partialPivLu();
-            const auto result = partialLu.solve(rhs);
-
-            // fill histograms
-            hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_entries);
-
-            hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, result(0));
-            hphi->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(0, 0)));
-
-            hz->SetBinContent(iphi + 1, ir + 1, iz + 1, result(1));
-            hz->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(1, 1)));
-
-            hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result(2));
-            hr->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(2, 2)));
-
-            if (Verbosity())
-            {
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dphi: " << result(0) << " +/- " << std::sqrt(cov(0, 0)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result(1) << " +/- " << std::sqrt(cov(1, 1)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr: " << result(2) << " +/- " << std::sqrt(cov(2, 2)) << std::endl;
-              std::cout << std::endl;
-            }
+            std::array<float, ncoord * ncoord> lhs_buffer{};
+            std::array<float, ncoord> rhs_buffer{};
+            const auto* lhs = get_matrix_data<&TpcSpaceChargeMatrixContainer::get_lhs, &TpcSpaceChargeMatrixContainer::get_lhs_array, ncoord>(container, icell, lhs_buffer);
+            const auto* rhs = get_column_data<&TpcSpaceChargeMatrixContainer::get_rhs, &TpcSpaceChargeMatrixContainer::get_rhs_array, ncoord>(container, icell, rhs_buffer);
+
+            // result is ordered as dphi, dz, dr
+            solve<ncoord>(lhs, rhs, result.value.data(), result.error.data());
             break;
           }
 
@@ -294,57 +380,92 @@ void TpcSpaceChargeMatrixInversion::calculate_distortion_corrections(const Inver
           {
             /* number of coordinates must match that of the matrix container */
             static constexpr int ncoord = 2;
-            using matrix_t = Eigen::Matrix<float, ncoord, ncoord>;
-            using column_t = Eigen::Matrix<float, ncoord, 1>;
-
-            // build rphi eigen matrices from container and invert
-            matrix_t lhs_rphi = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs_rphi,ncoord>(m_matrix_container.get(),icell);
-            column_t rhs_rphi = get_column<&TpcSpaceChargeMatrixContainer::get_rhs_rphi,ncoord>(m_matrix_container.get(),icell);
-            const auto cov_rphi = lhs_rphi.inverse();
-            auto partialLu_rphi = lhs_rphi.partialPivLu();
-            const auto result_rphi = partialLu_rphi.solve(rhs_rphi);
-
-            // build z eigen matrices from container and invert
-            matrix_t lhs_z = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs_z,ncoord>(m_matrix_container.get(),icell);
-            column_t rhs_z = get_column<&TpcSpaceChargeMatrixContainer::get_rhs_z,ncoord>(m_matrix_container.get(),icell);
-            const auto cov_z = lhs_z.inverse();
-            auto partialLu_z = lhs_z.partialPivLu();
-            const auto result_z = partialLu_z.solve(rhs_z);
-
-            // fill histograms
-            hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_entries);
-
-            hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, result_rphi(0));
-            hphi->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_rphi(0, 0)));
-
-            hz->SetBinContent(iphi + 1, ir + 1, iz + 1, result_z(0));
-            hz->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_z(0, 0)));
-
-            if( inversionMode == InversionMode::ReducedInversion_phi )
-            {
-              hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result_rphi(1));
-              hr->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_rphi(1, 1)));
-            } else if( inversionMode == InversionMode::ReducedInversion_z ) {
-              hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result_z(1));
-              hr->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_z(1, 1)));
-            }
-
-
-            if (Verbosity())
-            {
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dphi: " << result_rphi(0) << " +/- " << std::sqrt(cov_rphi(0, 0)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result_z(0) << " +/- " << std::sqrt(cov_z(0, 0)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (rphi): " << result_rphi(1) << " +/- " << std::sqrt(cov_rphi(1, 1)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (z): " << result_z(1) << " +/- " << std::sqrt(cov_z(1, 1)) << std::endl;
-              std::cout << std::endl;
-            }
+            std::array<float, ncoord * ncoord> lhs_buffer{};
+            std::array<float, ncoord> rhs_buffer{};
+
+            // rphi reduced matrices give (dphi, dr)
+            std::array<float, ncoord> value_rphi{};
+            std::array<float, ncoord> error_rphi{};
+            const auto* lhs_rphi = get_matrix_data<&TpcSpaceChargeMatrixContainer::get_lhs_rphi, &TpcSpaceChargeMatrixContainer::get_lhs_rphi_array, ncoord>(container, icell, lhs_buffer);
+            const auto* rhs_rphi = get_column_data<&TpcSpaceChargeMatrixContainer::get_rhs_rphi, &TpcSpaceChargeMatrixContainer::get_rhs_rphi_array, ncoord>(container, icell, rhs_buffer);
+            solve<ncoord>(lhs_rphi, rhs_rphi, value_rphi.data(), error_rphi.data());
+
+            // z reduced matrices give (dz, dr)
+            std::array<float, ncoord> value_z{};
+            std::array<float, ncoord> error_z{};
+            const auto* lhs_z = get_matrix_data<&TpcSpaceChargeMatrixContainer::get_lhs_z, &TpcSpaceChargeMatrixContainer::get_lhs_z_array, ncoord>(container, icell, lhs_buffer);
+            const auto* rhs_z = get_column_data<&TpcSpaceChargeMatrixContainer::get_rhs_z, &TpcSpaceChargeMatrixContainer::get_rhs_z_array, ncoord>(container, icell, rhs_buffer);
+            solve<ncoord>(lhs_z, rhs_z, value_z.data(), error_z.data());
+
+            const bool use_rphi = (inversionMode == InversionMode::ReducedInversion_phi);
+            result.value = {value_rphi[0], value_z[0], use_rphi ? value_rphi[1] : value_z[1], use_rphi ? value_z[1] : value_rphi[1]};
+            result.error = {error_rphi[0], error_z[0], use_rphi ? error_rphi[1] : error_z[1], use_rphi ? error_z[1] : error_rphi[1]};
             break;
           }
         }
+      }  // z-loop
+    }  // r-loop
+  }  // phi-loop
 
-      } // z-loop
-    } // r-loop
-  } // phi-loop
+  // fill histograms
+  for (int iphi = 0; iphi < phibins; ++iphi)
+  {
+    for (int ir = 0; ir < rbins; ++ir)
+    {
+      for (int iz = 0; iz < zbins; ++iz)
+      {
+        const auto& result = results[iz + zbins * (ir + rbins * iphi)];
+        if (!result.valid)
+        {
+          continue;
+        }
+
+        if (Verbosity() && inversionMode == InversionMode::FullInversion)
+        {
+          // print matrices and entries
+          const auto icell = container->get_cell_index(iphi, ir, iz);
+          std::array<float, 9> lhs_buffer{};
+          std::array<float, 3> rhs_buffer{};
+          const matrix_map_t<3> lhs(get_matrix_data<&TpcSpaceChargeMatrixContainer::get_lhs, &TpcSpaceChargeMatrixContainer::get_lhs_array, 3>(container, icell, lhs_buffer));
+          const column_map_t<3> rhs(get_column_data<&TpcSpaceChargeMatrixContainer::get_rhs, &TpcSpaceChargeMatrixContainer::get_rhs_array, 3>(container, icell, rhs_buffer));
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - inverting bin " << iz << ", " << ir << ", " << iphi << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - entries: " << result.entries << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - lhs: \n"
+                    << lhs << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - rhs: \n"
+                    << rhs << std::endl;
+        }
+
+        hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, result.entries);
+
+        hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, result.value[0]);
+        hphi->SetBinError(iphi + 1, ir + 1, iz + 1, result.error[0]);
+
+        hz->SetBinContent(iphi + 1, ir + 1, iz + 1, result.value[1]);
+        hz->SetBinError(iphi + 1, ir + 1, iz + 1, result.error[1]);
+
+        hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result.value[2]);
+        hr->SetBinError(iphi + 1, ir + 1, iz + 1, result.error[2]);
+
+        if (Verbosity())
+        {
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dphi: " << result.value[0] << " +/- " << result.error[0] << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result.value[1] << " +/- " << result.error[1] << std::endl;
+          if (inversionMode == InversionMode::FullInversion)
+          {
+            std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr: " << result.value[2] << " +/- " << result.error[2] << std::endl;
+          }
+          else
+          {
+            const bool use_rphi = (inversionMode == InversionMode::ReducedInversion_phi);
+            std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (rphi): " << result.value[use_rphi ? 2 : 3] << " +/- " << result.error[use_rphi ? 2 : 3] << std::endl;
+            std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (z): " << result.value[use_rphi ? 3 : 2] << " +/- " << result.error[use_rphi ? 3 : 2] << std::endl;
+          }
+          std::cout << std::endl;
+        }
+      }
+    }
+  }
 
   // split histograms in two along z axis and write
   // also write histograms suitable for space charge reconstruction
@@ -12,6 +12,8 @@
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 /**
  * \class TpcSpaceChargeMatrixInversion
@@ -39,6 +41,12 @@ class TpcSpaceChargeMatrixInversion : public Fun4AllBase
   /// add space charge correction matrix, loaded from file, to current. Returns true on success
   bool add_from_file(const std::string& /*filename*/, const std::string& /*objectname*/ = "TpcSpaceChargeMatrixContainer");
 
+  /// add space charge correction matrices, loaded from several files in parallel, to current. Returns true if all files were added
+  bool add_from_files(const std::vector<std::string>& /*filenames*/, const std::string& /*objectname*/ = "TpcSpaceChargeMatrixContainer");
+
+  /// number of threads used for reading files and inverting matrices. Use OpenMP default if not set
+  void set_num_threads(int value) { m_num_threads = value; }
+
   enum class InversionMode
   {
     FullInversion,        // use 3D matrices (phi,z,r)
@@ -66,6 +74,9 @@ class TpcSpaceChargeMatrixInversion : public Fun4AllBase
 
   /// central membrane distortion container
   std::unique_ptr<TpcDistortionCorrectionContainer> m_dcc_cm;
+
+  /// number of threads
+  int m_num_threads = 0;
 };
 
 #endif
@@ -35,7 +35,7 @@ Acts::Vector3 ActsGeometry::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster
 
   /// If silicon/TPOT, the transform is one-to-one since the surface is planar
 
-  auto surface = m_surfMaps.getSurface(key, cluster);
+  const auto* surface = m_surfMaps.getSurfacePointer(key, cluster);
 
   if (!surface)
   {
@@ -103,7 +103,7 @@ Acts::Vector3 ActsGeometry::getGlobalPositionTpc(TrkrDefs::cluskey key, TrkrClus
     return glob;
   }
 
-  auto surface = m_surfMaps.getSurface(key, cluster);
+  const auto* surface = m_surfMaps.getSurfacePointer(key, cluster);
 
   /*
   std::cout << " getGlobalPositionTpc transform is: " << std::endl
@@ -149,10 +149,9 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
 {
   unsigned int layer = TrkrDefs::getLayer(hitsetkey);
   unsigned int side = TpcDefs::getSide(hitsetkey);
-  
-  auto mapIter = m_surfMaps.m_tpcSurfaceMap.find(layer);
 
-  if (mapIter == m_surfMaps.m_tpcSurfaceMap.end())
+  const unsigned int nsurfaces = m_surfMaps.getTpcSurfaceCount(layer);
+  if (nsurfaces == 0)
   {
     std::cout << "Error: hitsetkey not found in ActsGeometry::get_tpc_surface_from_coords, hitsetkey = "
               << hitsetkey << std::endl;
@@ -160,7 +159,18 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
   }
   double world_phi = atan2(world[1], world[0]);
 
-  const auto& surf_vec = mapIter->second;
+  // surface center azimuth, from the surface maps lookup table if valid for current alignment
+  const auto surface_phi = [&](unsigned int index)
+  {
+    double phi = 0;
+    if (!m_surfMaps.getTpcSurfacePhi(layer, index, phi))
+    {
+      const auto vec3d = m_surfMaps.getTpcSurface(hitsetkey, index)->center(m_tGeometry.getGeoContext());
+      phi = atan2(vec3d(1) / 10.0, vec3d(0) / 10.0);  // convert from mm to cm
+    }
+    return phi;
+  };
+
   unsigned int surf_index = 999;
 
   // Predict which surface index this phi and side will correspond to
@@ -168,20 +178,17 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
   // we use TPC side from the hitsetkey, since z can be either sign in north and south, depending on crossing
   double fraction = (world_phi + M_PI) / (2.0 * M_PI);
 
-  double rounded_nsurf = std::round((double) (surf_vec.size() / 2) * fraction - 0.5);  // NOLINT
+  double rounded_nsurf = std::round((double) (nsurfaces / 2) * fraction - 0.5);  // NOLINT
   unsigned int nsurfm = (unsigned int) rounded_nsurf;
 
   if (side == 0)
   {
-    nsurfm += surf_vec.size() / 2;
+    nsurfm += nsurfaces / 2;
   }
-  unsigned int nsurf = nsurfm % surf_vec.size();
-  Surface this_surf = surf_vec[nsurf];
+  unsigned int nsurf = nsurfm % nsurfaces;
   //std::cout << "    world_phi " << world_phi << " fraction " << fraction << " rounded_nsurf " << rounded_nsurf << " nsurfm " << nsurfm << " nsurf " << nsurf << std::endl;
   
-  auto vec3d = this_surf->center(m_tGeometry.getGeoContext());
-  std::vector<double> surf_center = {vec3d(0) / 10.0, vec3d(1) / 10.0, vec3d(2) / 10.0};  // convert from mm to cm
-  double surf_phi = atan2(surf_center[1], surf_center[0]);
+  double surf_phi = surface_phi(nsurf);
   double surfStepPhi = m_tGeometry.tpcSurfStepPhi;
   //  std::cout << "    surf_phi " << surf_phi << " surfStepPhi " << surfStepPhi  << " nsurf " << nsurf << std::endl;
   
@@ -193,9 +200,7 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
   else
   {
     // check for the periodic boundary condition
-    auto firstsurf = *surf_vec.begin();
-    auto firstsurfcenter = firstsurf->center(geometry().getGeoContext());
-    float firstsurf_phi = atan2(firstsurfcenter[1], firstsurfcenter[0]);
+    float firstsurf_phi = surface_phi(0);
     if (world_phi < firstsurf_phi - surfStepPhi / 2.0)
     {
       world_phi += 2.0 * M_PI;
@@ -207,23 +212,20 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
       {
         continue;
       }
-      unsigned int new_nsurf = (nsurf+i) % surf_vec.size();
-      this_surf = surf_vec[new_nsurf];
-      vec3d = this_surf->center(geometry().getGeoContext());
-      surf_center = {vec3d(0) / 10.0, vec3d(1) / 10.0, vec3d(2) / 10.0};  // convert from mm to cm
-      surf_phi = atan2(surf_center[1], surf_center[0]);
+      unsigned int new_nsurf = (nsurf+i) % nsurfaces;
+      surf_phi = surface_phi(new_nsurf);
       //std::cout << "    new world_phi " << world_phi << " new surf_phi " << surf_phi  << " new_nsurf " << new_nsurf << std::endl;
       if ((world_phi > surf_phi - surfStepPhi / 2.0 && world_phi < surf_phi + surfStepPhi / 2.0))
       {
         surf_index = new_nsurf;
         subsurfkey = new_nsurf;
-        return surf_vec[surf_index];
+        return m_surfMaps.getTpcSurface(hitsetkey, surf_index);
       }
     }
     return nullptr;
   }
 
-  return surf_vec[surf_index];
+  return m_surfMaps.getTpcSurface(hitsetkey, surf_index);
 }
 
 //________________________________________________________________________________________________
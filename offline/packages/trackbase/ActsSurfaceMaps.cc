@@ -8,10 +8,16 @@
 #include "InttDefs.h"
 #include "MvtxDefs.h"
 #include "TrkrCluster.h"
+#include "alignmentTransformationContainer.h"
 
 #include <Acts/Definitions/Units.hpp>
 #include <Acts/Surfaces/Surface.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iostream>
+
 namespace
 {
   /// square
@@ -27,6 +33,20 @@ namespace
   {
     return std::sqrt(square(x) + square(y));
   }
+
+  /// hitset key with crossing or strobe reset, as used for silicon surfaces
+  TrkrDefs::hitsetkey reset_crossing(TrkrDefs::hitsetkey hitsetkey)
+  {
+    switch (TrkrDefs::getTrkrId(hitsetkey))
+    {
+    case TrkrDefs::inttId:
+      return InttDefs::resetCrossing(hitsetkey);
+    case TrkrDefs::mvtxId:
+      return MvtxDefs::resetStrobe(hitsetkey);
+    default:
+      return hitsetkey;
+    }
+  }
 }  // namespace
 
 bool ActsSurfaceMaps::isTpcSurface(const Acts::Surface* surface) const
@@ -69,8 +89,32 @@ Surface ActsSurfaceMaps::getSurface(TrkrDefs::cluskey key,
   return nullptr;
 }
 
+const Acts::Surface* ActsSurfaceMaps::getSurfacePointer(TrkrDefs::cluskey key,
+                                                     TrkrCluster* cluster) const
+{
+  if (!hasLookupTables())
+  {
+    return getSurface(key, cluster).get();
+  }
+
+  const auto hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+  const auto index = (TrkrDefs::getTrkrId(key) == TrkrDefs::tpcId) ? findSurfaceIndex(hitsetkey, cluster->getSubSurfKey()) : findSurfaceIndex(reset_crossing(hitsetkey), 0);
+  return index < 0 ? nullptr : m_surfaces[index].get();
+}
+
 Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
+  if (hasLookupTables())
+  {
+    const auto index = findSurfaceIndex(reset_crossing(hitsetkey), 0);
+    if (index >= 0)
+    {
+      return m_surfaces[index];
+    }
+    std::cout << "Failed to find silicon surface for hitsetkey " << hitsetkey << " tmpkey " << reset_crossing(hitsetkey) << std::endl;
+    return nullptr;
+  }
+
   unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
   TrkrDefs::hitsetkey tmpkey = hitsetkey;
 
@@ -105,12 +149,18 @@ Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
                                        TrkrDefs::subsurfkey surfkey) const
 {
+  if (hasLookupTables())
+  {
+    const auto index = findSurfaceIndex(hitsetkey, surfkey);
+    return index < 0 ? nullptr : m_surfaces[index];
+  }
+
   unsigned int layer = TrkrDefs::getLayer(hitsetkey);
   const auto iter = m_tpcSurfaceMap.find(layer);
 
   if (iter != m_tpcSurfaceMap.end())
   {
-    auto surfvec = iter->second;
+    const auto& surfvec = iter->second;
     return surfvec.at(surfkey);
   }
 
@@ -120,6 +170,179 @@ Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
 
 Surface ActsSurfaceMaps::getMMSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
+  if (hasLookupTables())
+  {
+    const auto index = findSurfaceIndex(hitsetkey, 0);
+    return index < 0 ? nullptr : m_surfaces[index];
+  }
+
   const auto iter = m_mmSurfaceMap.find(hitsetkey);
   return (iter == m_mmSurfaceMap.end()) ? nullptr : iter->second;
 }
+
+void ActsSurfaceMaps::buildLookupTables()
+{
+  m_layerIndex.clear();
+  m_surfaceIndex.clear();
+  m_surfaces.clear();
+  m_surfacePhi.clear();
+  m_hasSurfacePhi = false;
+
+  // group planar surfaces by layer
+  std::map<unsigned int, std::vector<std::pair<TrkrDefs::hitsetkey, Surface>>> planarSurfaces;
+  for (const auto* map : {&m_siliconSurfaceMap, &m_mmSurfaceMap})
+  {
+    for (const auto& [hitsetkey, surface] : *map)
+    {
+      planarSurfaces[TrkrDefs::getLayer(hitsetkey)].emplace_back(hitsetkey, surface);
+    }
+  }
+
+  unsigned int nlayers = 0;
+  if (!planarSurfaces.empty())
+  {
+    nlayers = std::max(nlayers, planarSurfaces.rbegin()->first + 1);
+  }
+  if (!m_tpcSurfaceMap.empty())
+  {
+    nlayers = std::max(nlayers, m_tpcSurfaceMap.rbegin()->first + 1);
+  }
+  m_layerIndex.resize(nlayers);
+
+  // planar surfaces: dense table over the lower 16 bits of the hitset keys
+  for (const auto& [layer, surfaces] : planarSurfaces)
+  {
+    auto& index = m_layerIndex[layer];
+    index.upper = surfaces.front().first >> 16U;
+
+    uint32_t lo = 0xFFFFU;
+    uint32_t hi = 0;
+    for (const auto& [hitsetkey, surface] : surfaces)
+    {
+      lo = std::min(lo, hitsetkey & 0xFFFFU);
+      hi = std::max(hi, hitsetkey & 0xFFFFU);
+    }
+
+    // bits which are always zero, e.g. from crossing or strobe reset, are dropped
+    uint32_t bits = 0;
+    for (const auto& [hitsetkey, surface] : surfaces)
+    {
+      bits |= (hitsetkey & 0xFFFFU) - lo;
+    }
+
+    index.offset = lo;
+    index.shift = bits ? std::countr_zero(bits) : 0;
+    index.begin = m_surfaceIndex.size();
+    index.size = ((hi - lo) >> index.shift) + 1;
+    m_surfaceIndex.resize(index.begin + index.size, -1);
+
+    for (const auto& [hitsetkey, surface] : surfaces)
+    {
+      if ((hitsetkey >> 16U) != index.upper)
+      {
+        std::cout << "ActsSurfaceMaps::buildLookupTables - inconsistent hitsetkey " << hitsetkey << " in layer " << layer << std::endl;
+        continue;
+      }
+      m_surfaceIndex[index.begin + (((hitsetkey & 0xFFFFU) - lo) >> index.shift)] = m_surfaces.size();
+      m_surfaces.push_back(surface);
+    }
+  }
+
+  // TPC surfaces: the subsurface key is the position in the layer
+  for (const auto& [layer, surfaces] : m_tpcSurfaceMap)
+  {
+    auto& index = m_layerIndex[layer];
+    index.upper = TrkrDefs::genHitSetKey(TrkrDefs::tpcId, layer) >> 16U;
+    index.tpc = true;
+    index.begin = m_surfaces.size();
+    index.size = surfaces.size();
+    m_surfaces.insert(m_surfaces.end(), surfaces.begin(), surfaces.end());
+  }
+}
+
+void ActsSurfaceMaps::updateSurfaceCenters(const Acts::GeometryContext& geoContext)
+{
+  m_surfacePhi.assign(m_surfaces.size(), 0);
+  for (const auto& index : m_layerIndex)
+  {
+    if (!index.tpc)
+    {
+      continue;
+    }
+
+    for (auto i = index.begin; i < index.begin + index.size; ++i)
+    {
+      // same convention as ActsGeometry::get_tpc_surface_from_coords
+      const auto center = m_surfaces[i]->center(geoContext);
+      m_surfacePhi[i] = std::atan2(center(1) / 10.0, center(0) / 10.0);
+    }
+  }
+
+  m_surfacePhiVersion = alignmentTransformationContainer::version;
+  m_surfacePhiUseAlignment = alignmentTransformationContainer::use_alignment;
+  m_hasSurfacePhi = true;
+}
+
+unsigned int ActsSurfaceMaps::getTpcSurfaceCount(unsigned int layer) const
+{
+  if (hasLookupTables())
+  {
+    return (layer < m_layerIndex.size() && m_layerIndex[layer].tpc) ? m_layerIndex[layer].size : 0;
+  }
+
+  const auto iter = m_tpcSurfaceMap.find(layer);
+  return (iter == m_tpcSurfaceMap.end()) ? 0 : iter->second.size();
+}
+
+bool ActsSurfaceMaps::getTpcSurfacePhi(unsigned int layer, unsigned int index, double& phi) const
+{
+  if (!m_hasSurfacePhi ||
+      m_surfacePhiVersion != alignmentTransformationContainer::version ||
+      m_surfacePhiUseAlignment != alignmentTransformationContainer::use_alignment)
+  {
+    return false;
+  }
+
+  if (layer >= m_layerIndex.size() || !m_layerIndex[layer].tpc || index >= m_layerIndex[layer].size)
+  {
+    return false;
+  }
+
+  phi = m_surfacePhi[m_layerIndex[layer].begin + index];
+  return true;
+}
+
+int64_t ActsSurfaceMaps::findSurfaceIndex(TrkrDefs::hitsetkey hitsetkey, TrkrDefs::subsurfkey surfkey) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+  if (layer >= m_layerIndex.size())
+  {
+    return -1;
+  }
+
+  const auto& index = m_layerIndex[layer];
+  if (index.size == 0 || (hitsetkey >> 16U) != index.upper)
+  {
+    return -1;
+  }
+
+  if (index.tpc)
+  {
+    return surfkey < index.size ? int64_t(index.begin + surfkey) : -1;
+  }
+
+  const uint32_t low = hitsetkey & 0xFFFFU;
+  if (low < index.offset)
+  {
+    return -1;
+  }
+
+  const uint32_t delta = low - index.offset;
+  const uint32_t entry = delta >> index.shift;
+  if ((delta & ((1U << index.shift) - 1U)) || entry >= index.size)
+  {
+    return -1;
+  }
+
+  return m_surfaceIndex[index.begin + entry];
+}
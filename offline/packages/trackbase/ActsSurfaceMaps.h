@@ -21,6 +21,7 @@ namespace Acts
 class TGeoNode;
 class TrkrCluster;
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
@@ -49,6 +50,25 @@ struct ActsSurfaceMaps
 
   Surface getMMSurface(TrkrDefs::hitsetkey hitsetkey) const;
 
+  //! raw surface pointer, without shared pointer copy. Same as getSurface otherwise
+  const Acts::Surface* getSurfacePointer(TrkrDefs::cluskey, TrkrCluster* cluster) const;
+
+  //! build flat lookup tables from surface maps. Must be called once all maps are filled
+  void buildLookupTables();
+
+  //! store surface center azimuth for all TPC surfaces, with current alignment
+  void updateSurfaceCenters(const Acts::GeometryContext&);
+
+  //! true if lookup tables have been built
+  bool hasLookupTables() const { return !m_layerIndex.empty(); }
+
+  //! number of TPC surfaces in a given layer, or zero if not found
+  unsigned int getTpcSurfaceCount(unsigned int layer) const;
+
+  //! TPC surface center azimuth, as stored by updateSurfaceCenters
+  /** returns false if centers are unavailable, or were stored with a different alignment */
+  bool getTpcSurfacePhi(unsigned int layer, unsigned int index, double& phi) const;
+
   //! map hitset to Surface for the silicon detectors (MVTX and INTT)
   std::map<TrkrDefs::hitsetkey, Surface> m_siliconSurfaceMap;
 
@@ -68,6 +88,54 @@ struct ActsSurfaceMaps
   //! stores all acts volume ids relevant to the micromegas
   /** it is used to quickly tell if a given Acts Surface belongs to micromegas */
   std::set<int> m_micromegasVolumeIds;
+
+ private:
+  //! dense range of surfaces for a given layer
+  /**
+   * for silicon and micromegas, the lower 16 bits of the hitset key are mapped to
+   * an entry in m_surfaceIndex, as (bits - offset) >> shift.
+   * for the TPC, the subsurface key is directly the index in m_surfaces
+   */
+  struct LayerIndex
+  {
+    //! upper 16 bits of the hitset key (tracker id and layer)
+    uint16_t upper = 0;
+
+    //! lowest value of the lower 16 bits of the hitset key
+    uint16_t offset = 0;
+
+    //! number of always-zero low bits, from crossing and strobe reset
+    uint8_t shift = 0;
+
+    //! true for TPC layers
+    bool tpc = false;
+
+    //! first entry in m_surfaceIndex (silicon, micromegas) or m_surfaces (TPC)
+    uint32_t begin = 0;
+
+    //! number of entries
+    uint32_t size = 0;
+  };
+
+  //! find surface index in m_surfaces from (crossing-reset) hitset key and subsurface key. Returns -1 if not found
+  int64_t findSurfaceIndex(TrkrDefs::hitsetkey, TrkrDefs::subsurfkey) const;
+
+  //! lookup table, indexed by layer
+  std::vector<LayerIndex> m_layerIndex;
+
+  //! dense hitset key table for silicon and micromegas, index in m_surfaces, or -1 if empty
+  std::vector<int32_t> m_surfaceIndex;
+
+  //! all surfaces
+  SurfaceVec m_surfaces;
+
+  //! surface center azimuth, for TPC surfaces
+  std::vector<double> m_surfacePhi;
+
+  //! alignment state when surface centers were stored
+  unsigned int m_surfacePhiVersion = 0;
+  bool m_surfacePhiUseAlignment = false;
+  bool m_hasSurfacePhi = false;
 };
 
 #endif
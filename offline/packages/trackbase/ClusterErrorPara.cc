@@ -6,7 +6,9 @@
 #include <TF1.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -20,6 +22,236 @@ namespace
     return x * x;
   }
 
+  //! true when reconstructing real data, based on CDB global tag
+  bool is_data_reco()
+  {
+    static const bool value = []()
+    {
+      recoConsts* rc = recoConsts::instance();
+      if (rc->FlagExist("CDB_GLOBALTAG"))
+      {
+        if (rc->get_StringFlag("CDB_GLOBALTAG").find("MDC") != std::string::npos)
+        {
+          return false;
+        }
+      }
+      return true;  // default to data
+    }();
+    return value;
+  }
+
+  //! cluster size bins, as used in get_clusterv5_modified_error
+  /* 0: other, 1 to 4: exact value, 5: in ]3,5[ but not 4, 6: 5 and above */
+  static constexpr size_t n_size_bins = 7;
+  uint8_t size_bin(float size)
+  {
+    if (size >= 5)
+    {
+      return 6;
+    }
+    if (size == 4)
+    {
+      return 4;
+    }
+    if (size > 3)
+    {
+      return 5;
+    }
+    if (size == 3)
+    {
+      return 3;
+    }
+    if (size == 2)
+    {
+      return 2;
+    }
+    if (size == 1)
+    {
+      return 1;
+    }
+    return 0;
+  }
+
+  //! per tracker and layer error scale factors for get_clusterv5_modified_error
+  /*
+   * factors are applied one after the other, in the same order as the original per-detector branches,
+   * so that results are unchanged. A factor of 1 means the corresponding branch does not apply.
+   */
+  struct ModifiedErrorFactors
+  {
+    //!@name phi error
+    //@{
+    double phi_layer = 1;
+    double phi_edge = 1;     // applied when edge >= 3
+    double phi_overlap = 1;  // applied when overlap >= 2
+    std::array<double, n_size_bins> phi_size = {1, 1, 1, 1, 1, 1, 1};
+    double phi_layer_fine = 1;
+    double phi_large = 1;  // applied when phi size >= 5
+    bool phi_clamp = false;
+    double phi_fixed = 0;  // replaces the error when non zero
+    //@}
+
+    //!@name z error
+    //@{
+    double z_layer = 1;
+    std::array<double, n_size_bins> z_size = {1, 1, 1, 1, 1, 1, 1};
+    double z_layer_fine = 1;
+    double z_fixed = 0;  // replaces the error when non zero
+    //@}
+  };
+
+  //! factors table, indexed by tracker id and layer
+  static constexpr size_t n_trkr_ids = 4;
+  static constexpr size_t n_layers = 64;
+  using ModifiedErrorTable = std::array<std::array<ModifiedErrorFactors, n_layers>, n_trkr_ids>;
+
+  ModifiedErrorTable make_modified_error_table(bool is_data)
+  {
+    ModifiedErrorTable table{};
+
+    // TPC
+    for (int layer = 0; layer < static_cast<int>(n_layers); ++layer)
+    {
+      auto& f = table[TrkrDefs::tpcId][layer];
+      f.phi_edge = 4;
+      f.phi_overlap = 2;
+      f.phi_large = 10;
+
+      if (!is_data)
+      {
+        if (layer == 7 || layer == 22 || layer == 23 || layer == 38 || layer == 39)
+        {
+          f.phi_layer = 4;
+          f.z_layer = 4;
+        }
+        f.phi_size[1] = 10;
+        f.phi_clamp = true;
+        continue;
+      }
+
+      if (layer == 7 || layer == 22 || layer == 23 || layer == 38 || layer == 39 || layer == 54)
+      {
+        f.phi_layer = 4;
+        f.z_layer = 4;
+      }
+
+      if (layer < 7 || layer >= 7 + 48)
+      {
+        continue;
+      }
+
+      // phi size
+      f.phi_size[2] = 3.15;
+      f.phi_size[3] = 3.5;
+      f.phi_size[4] = f.phi_size[5] = f.phi_size[6] = 4;
+
+      // inline pol2 evaluation: p0 + p1*x + p2*x^2
+      const auto pol2 = [](double x, double p0, double p1, double p2)
+      { return p0 + p1 * x + p2 * x * x; };
+
+      if (layer < 7 + 16)
+      {
+        f.z_size[2] = 7;
+        f.z_size[3] = f.z_size[4] = 7;
+        f.z_size[6] = 20;
+        f.phi_layer_fine = pol2(layer, 3.206, -0.252, 0.007);
+      }
+      else if (layer < 7 + 32)
+      {
+        f.z_size[2] = 4.5;
+        f.z_size[3] = f.z_size[4] = 5;
+        f.z_size[6] = 6;
+        f.phi_layer_fine = pol2(layer, 4.48, -0.226, 0.00362);
+        f.z_layer_fine = pol2(layer, 5.593, -0.2458, 0.00333455);
+      }
+      else
+      {
+        f.z_size[2] = 4.5;
+        f.z_size[3] = f.z_size[4] = 5;
+        f.z_size[6] = 7;
+        f.phi_layer_fine = pol2(layer, 14.8112, -0.577, 0.00605);
+        f.z_layer_fine = pol2(layer, 5.6964, -0.21338, 0.002502);
+      }
+    }
+
+    if (!is_data)
+    {
+      return table;
+    }
+
+    // MVTX
+    for (auto& f : table[TrkrDefs::mvtxId])
+    {
+      f.phi_layer = 2;
+      f.z_layer = 2;
+    }
+
+    // INTT
+    for (int layer = 0; layer < static_cast<int>(n_layers); ++layer)
+    {
+      auto& f = table[TrkrDefs::inttId][layer];
+      f.phi_layer = 9;
+      f.phi_size[1] = 1.25;
+      f.phi_size[2] = 2.25;
+      if ((layer == 3) || (layer == 4))
+      {
+        f.phi_layer_fine = 0.8;
+      }
+      if ((layer == 5) || (layer == 6))
+      {
+        f.phi_layer_fine = 1.2;
+      }
+    }
+
+    // micromegas
+    table[TrkrDefs::micromegasId][55].phi_fixed = 0.0289;
+    table[TrkrDefs::micromegasId][56].z_fixed = 0.577;
+
+    return table;
+  }
+
+  //! factors for a given cluster key
+  const ModifiedErrorFactors& get_modified_error_factors(TrkrDefs::cluskey key)
+  {
+    static const ModifiedErrorTable table = make_modified_error_table(is_data_reco());
+    static const ModifiedErrorFactors unity;
+
+    const unsigned int trkrid = TrkrDefs::getTrkrId(key);
+    const unsigned int layer = TrkrDefs::getLayer(key);
+    return (trkrid < n_trkr_ids && layer < n_layers) ? table[trkrid][layer] : unity;
+  }
+
+  //! apply factors to errors
+  inline void apply_modified_error_factors(const ModifiedErrorFactors& f, char edge, char overlap, uint8_t phisize, uint8_t zsize, double& phierror, double& zerror)
+  {
+    phierror *= f.phi_layer;
+    phierror *= (edge >= 3) ? f.phi_edge : 1.;
+    phierror *= (overlap >= 2) ? f.phi_overlap : 1.;
+    phierror *= f.phi_size[phisize];
+    phierror *= f.phi_layer_fine;
+    phierror *= (phisize == 6) ? f.phi_large : 1.;
+    if (f.phi_clamp)
+    {
+      phierror = std::min(phierror, 0.1);
+      if (phierror < 0.0005)
+      {
+        phierror = 0.1;
+      }
+    }
+    if (f.phi_fixed != 0)
+    {
+      phierror = f.phi_fixed;
+    }
+
+    zerror *= f.z_layer;
+    zerror *= f.z_size[zsize];
+    zerror *= f.z_layer_fine;
+    if (f.z_fixed != 0)
+    {
+      zerror = f.z_fixed;
+    }
+  }
+
 }  // namespace
 
 ClusterErrorPara::ClusterErrorPara():
@@ -515,259 +747,54 @@ ClusterErrorPara::ClusterErrorPara():
 //_________________________________________________________________________________
 ClusterErrorPara::error_t ClusterErrorPara::get_clusterv5_modified_error(TrkrCluster* cluster, double /*unused*/, TrkrDefs::cluskey key)
 {
-
-  static const bool is_data_reco = []() {
-    recoConsts* rc = recoConsts::instance();
-    if (rc->FlagExist("CDB_GLOBALTAG"))
-    {
-      if (rc->get_StringFlag("CDB_GLOBALTAG").find("MDC") != std::string::npos)
-      {
-        return false;
-      }
-    }
-    return true;  // default to data
-  }();
-  /*
-  static bool is_data_reco{true};  // default to data
-  static bool is_data_reco_set{false};  // default to data
-  if(!is_data_reco_set){
-    recoConsts* rc = recoConsts::instance(); 
-    if(rc->FlagExist("CDB_GLOBALTAG"))
-      {
-	if(rc->get_StringFlag("CDB_GLOBALTAG").find("MDC") != std::string::npos)
-	  {
-	    is_data_reco = false;
-	  }
-      }
-    is_data_reco_set = true;
-  }
-  */
-  int layer = TrkrDefs::getLayer(key);
-
   double phierror = cluster->getRPhiError();
   double zerror = cluster->getZError();
+  apply_modified_error_factors(
+      get_modified_error_factors(key),
+      cluster->getEdge(), cluster->getOverlap(),
+      size_bin(cluster->getPhiSize()), size_bin(cluster->getZSize()),
+      phierror, zerror);
 
-  if(is_data_reco==false){
-    if (TrkrDefs::getTrkrId(key) == TrkrDefs::tpcId)
-      {
-	if (layer == 7 || layer == 22 || layer == 23 || layer == 38 || layer == 39)
-	  {
-	    phierror *= 4;
-	    zerror *= 4;
-	  }
-	if (cluster->getEdge() >= 3)
-	  {
-	    phierror *= 4;
-	  }
-	if (cluster->getOverlap() >= 2)
-	  {
-	    phierror *= 2;
-	  }
-	if (cluster->getPhiSize() == 1)
-	  {
-	    phierror *= 10;
-	  }
-	if (cluster->getPhiSize() >= 5)
-	  {
-	    phierror *= 10;
-	  }
-	
-	phierror = std::min(phierror, 0.1);
-	if (phierror < 0.0005)
-	  {
-	    phierror = 0.1;
-	  }
-      }
-  }else{
-    
-    if (TrkrDefs::getTrkrId(key) == TrkrDefs::tpcId)
-      {
-	if (layer == 7 || layer == 22 || layer == 23 || layer == 38 || layer == 39 || layer == 54)
-	  {
-	    phierror *= 4;
-	    zerror *= 4;
-	  }
-	if (cluster->getEdge() >= 3)
-	  {
-	    phierror *= 4;
-	  }
-	if (cluster->getOverlap() >= 2)
-	  {
-	    phierror *= 2;
-	  }
-	if(layer>=7&&layer<(7+48)){
-	  //Set phi error
-	  if (cluster->getPhiSize() == 1)
-	    {
-	      phierror *= 1.0;
-	    }
-	  if (cluster->getPhiSize() == 2)
-	    {
-	      phierror*=3.15;
-	    }
-	  if (cluster->getPhiSize() == 3)
-	    {
-	  phierror *=3.5;
-	    }
-	  if (cluster->getPhiSize() >3)
-	    {
-	      phierror *= 4;
-	    }
-	  //Set Z Error
-	  if (cluster->getZSize() == 1){
-	    zerror*=1.0;
-	  }
-	  if (cluster->getZSize() == 2){
-	    if(layer>=7&&layer<(7+16)){
-	      zerror*=7;
-	    }
-	    if(layer>=(7+16)&&layer<(7+32)){
-	      zerror*=4.5;
-	    }
-	    if(layer>=(7+32)&&layer<(7+48)){
-	      zerror*=4.5;
-	    }
-	    
-	  }
-	  if ((cluster->getZSize() == 3) || (cluster->getZSize() == 4)){
-	    if(layer>=7&&layer<(7+16)){
-	      zerror*=7;
-	    }
-	    if(layer>=(7+16)&&layer<(7+32)){
-	      zerror*=5;
-	    }
-	    if(layer>=(7+32)&&layer<(7+48)){
-	      zerror*=5;
-	    }
-	    //	zerror*=6;
-	  }
-	  if (cluster->getZSize() >=5){
-	    if(layer>=7&&layer<(7+16)){
-	      zerror*=20;
-	    }
-	    if(layer>=(7+16)&&layer<(7+32)){
-	      zerror*=6;
-	    }
-	    if(layer>=(7+32)&&layer<(7+48)){
-	      zerror*=7;
-	    }
-	  }
-	  /*
-	  static TF1 ftpcR1("ftpcR1", "pol2", 0, 60);
-	  ftpcR1.SetParameter(0, 3.206);
-	  ftpcR1.SetParameter(1, -0.252);
-	  ftpcR1.SetParameter(2, 0.007);
-	  
-	  static TF1 ftpcR2("ftpcR2", "pol2", 0, 60);
-	  ftpcR2.SetParameter(0, 4.48);
-	  ftpcR2.SetParameter(1, -0.226);
-	  ftpcR2.SetParameter(2, 0.00362);
-	  
-	  static TF1 ftpcR3("ftpcR3", "pol2", 0, 60);
-	  ftpcR3.SetParameter(0, 14.8112);
-	  ftpcR3.SetParameter(1, -0.577);
-	  ftpcR3.SetParameter(2, 0.00605);
-	  
-	  if(layer>=7&&layer<(7+16)){
-	    phierror*= ftpcR1.Eval(layer);
-	  }
-	  if(layer>=(7+16)&&layer<(7+32)){
-	    phierror*= ftpcR2.Eval(layer);
-	  }
-	  if(layer>=(7+32)&&layer<(7+48)){
-	    phierror*= ftpcR3.Eval(layer);
-	  }
-	  ftpcR2.SetParameter(0, 5.593);
-	  ftpcR2.SetParameter(1, -0.2458);
-	  ftpcR2.SetParameter(2, 0.00333455);
-	  
-	  ftpcR3.SetParameter(0, 5.6964);
-	  ftpcR3.SetParameter(1, -0.21338);
-	  ftpcR3.SetParameter(2, 0.002502);
-	  
-	  if(layer>=(7+16)&&layer<(7+32)){
-	    zerror*= ftpcR2.Eval(layer);
-	  }
-	  if(layer>=(7+32)&&layer<(7+48)){
-	    zerror*= ftpcR3.Eval(layer);
-	    }
-	  */
-	  
-	  // Inline pol2 evaluation: p0 + p1*x + p2*x^2
-	  auto pol2 = [](double x, double p0, double p1, double p2) {
-	    return p0 + p1 * x + p2 * x * x;
-	  };
-	  
-	  if(layer>=7&&layer<(7+16)){
-	    phierror *= pol2(layer, 3.206, -0.252, 0.007);
-	  }
-	  if(layer>=(7+16)&&layer<(7+32)){
-	    phierror *= pol2(layer, 4.48, -0.226, 0.00362);
-	  }
-	  if(layer>=(7+32)&&layer<(7+48)){
-	    phierror *= pol2(layer, 14.8112, -0.577, 0.00605);
-	  }
-	  
-	  if(layer>=(7+16)&&layer<(7+32)){
-	    zerror *= pol2(layer, 5.593, -0.2458, 0.00333455);
-	  }
-	  if(layer>=(7+32)&&layer<(7+48)){
-	    zerror *= pol2(layer, 5.6964, -0.21338, 0.002502);
-	  }
-	}
-	if (cluster->getPhiSize() >= 5)
-	  {
-	    phierror *= 10;
-	  }
-      }
-    
-    if (TrkrDefs::getTrkrId(key) == TrkrDefs::mvtxId){
-      phierror*=2;
-      zerror*=2;
+  return std::make_pair(square(phierror), square(zerror));
+}
 
+//_________________________________________________________________________________
+void ClusterErrorPara::get_clusterv5_modified_errors(size_t n, TrkrCluster* const* clusters, const TrkrDefs::cluskey* keys, double* phierror2, double* zerror2)
+{
+  static constexpr size_t block_size = 64;
+  std::array<const ModifiedErrorFactors*, block_size> factors{};
+  std::array<char, block_size> edge{};
+  std::array<char, block_size> overlap{};
+  std::array<uint8_t, block_size> phisize{};
+  std::array<uint8_t, block_size> zsize{};
+
+  for (size_t first = 0; first < n; first += block_size)
+  {
+    const size_t count = std::min(block_size, n - first);
+
+    // gather cluster properties, through virtual getters
+    for (size_t i = 0; i < count; ++i)
+    {
+      const auto* cluster = clusters[first + i];
+      factors[i] = &get_modified_error_factors(keys[first + i]);
+      phierror2[first + i] = cluster->getRPhiError();
+      zerror2[first + i] = cluster->getZError();
+      edge[i] = cluster->getEdge();
+      overlap[i] = cluster->getOverlap();
+      phisize[i] = size_bin(cluster->getPhiSize());
+      zsize[i] = size_bin(cluster->getZSize());
     }
-    
-    if (TrkrDefs::getTrkrId(key) == TrkrDefs::inttId){
-      phierror*=9;
-      if (cluster->getPhiSize() == 1){
-	phierror *= 1.25;
-      }
-      if (cluster->getPhiSize() == 2){
-	phierror *= 2.25;
-      }
-      if((layer==3)||(layer==4)){
-	phierror*=0.8;
-      }
-      if((layer==5)||(layer==6)){
-	phierror*=1.2;
-      }
-    }
-    
-    if (TrkrDefs::getTrkrId(key) == TrkrDefs::micromegasId){
-      if(layer==55){
-	/*
-	phierror*=5.4;
-	phierror*=4.6;
-	phierror*=3.0;
-	zerror*=0.82;
-	*/
-	phierror = 0.0289;
-      }
-      
-      if(layer==56){
-	/*
-	phierror*=0.9;
-	phierror*=0.95;
-	zerror*=4.5;
-	zerror*=3.4;
-	*/
-	zerror = 0.577;
-      }
 
+    // apply per layer factors
+    for (size_t i = 0; i < count; ++i)
+    {
+      double& phierror = phierror2[first + i];
+      double& zerror = zerror2[first + i];
+      apply_modified_error_factors(*factors[i], edge[i], overlap[i], phisize[i], zsize[i], phierror, zerror);
+      phierror = square(phierror);
+      zerror = square(zerror);
     }
   }
-
-  return std::make_pair(square(phierror), square(zerror));
 }
 
 //_________________________________________________________________________________
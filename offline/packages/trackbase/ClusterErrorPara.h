@@ -52,6 +52,10 @@ class ClusterErrorPara
   using error_t = std::pair<double, double>;
 
   static error_t get_clusterv5_modified_error(TrkrCluster *cluster, double cluster_r, TrkrDefs::cluskey key);
+
+  //! same as get_clusterv5_modified_error, for n clusters at once. Squared phi and z errors are stored in the output arrays
+  static void get_clusterv5_modified_errors(size_t n, TrkrCluster *const *clusters, const TrkrDefs::cluskey *keys, double *phierror2, double *zerror2);
+
   error_t get_cluster_error(TrkrCluster *cluster, double cluster_r, TrkrDefs::cluskey key, float qOverR, float slope);
   error_t get_cluster_error(TrkrCluster *cluster, TrkrDefs::cluskey key, double alpha, double beta);
 
@@ -10,6 +10,7 @@
 #include "RawHit.h"
 #include "TrkrDefs.h"
 
+#include <phool/PHEventArena.h>
 #include <phool/PHObject.h>
 
 #include <iostream>
@@ -24,6 +25,9 @@
 class RawHitv1 : public RawHit
 {
  public:
+  //! allocated from the per event arena, if enabled
+  PHEVENTARENA_OPERATORS
+
   //! ctor
   RawHitv1();
 
@@ -0,0 +1,168 @@
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.cc
+ * @brief event wide table of cluster global positions, with all corrections applied
+ */
+
+#include "TrkrClusterGlobalPositionCache.h"
+
+#include "ClusterErrorPara.h"
+#include "TrkrClusterContainer.h"
+#include "alignmentTransformationContainer.h"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+//_________________________________________________________________
+void TrkrClusterGlobalPositionCache::Reset()
+{
+  m_hitsets.clear();
+  m_keys.clear();
+  m_clusters.clear();
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_valid.clear();
+  m_phierror2.clear();
+  m_zerror2.clear();
+}
+
+//_________________________________________________________________
+void TrkrClusterGlobalPositionCache::identify(std::ostream& os) const
+{
+  os << "TrkrClusterGlobalPositionCache - hitsets: " << m_hitsets.size()
+     << " clusters: " << m_keys.size()
+     << " valid: " << std::count(m_valid.begin(), m_valid.end(), 1)
+     << " crossing: " << m_crossing
+     << " configuration: " << m_configuration
+     << std::endl;
+}
+
+//_________________________________________________________________
+void TrkrClusterGlobalPositionCache::init(TrkrClusterContainer* clustermap, short int crossing, unsigned int configuration)
+{
+  Reset();
+  m_crossing = crossing;
+  m_configuration = configuration;
+  m_alignment_version = alignment_version();
+  if (!clustermap)
+  {
+    return;
+  }
+
+  m_keys.reserve(clustermap->size());
+  m_clusters.reserve(clustermap->size());
+  for (const auto& hitsetkey : clustermap->getHitSetKeys())
+  {
+    HitSetRange range{hitsetkey, static_cast<uint32_t>(m_keys.size()), 0};
+    const auto clusters = clustermap->getClusters(hitsetkey);
+    for (auto iter = clusters.first; iter != clusters.second; ++iter)
+    {
+      m_keys.push_back(iter->first);
+      m_clusters.push_back(iter->second);
+    }
+    range.end = m_keys.size();
+
+    // keys must be sorted within each hitset for lookup
+    if (!std::is_sorted(m_keys.begin() + range.begin, m_keys.end()))
+    {
+      std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>> sorted;
+      for (auto i = range.begin; i < range.end; ++i)
+      {
+        sorted.emplace_back(m_keys[i], m_clusters[i]);
+      }
+      std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs)
+                { return lhs.first < rhs.first; });
+      for (auto i = range.begin; i < range.end; ++i)
+      {
+        std::tie(m_keys[i], m_clusters[i]) = sorted[i - range.begin];
+      }
+    }
+    m_hitsets.push_back(range);
+  }
+
+  std::sort(m_hitsets.begin(), m_hitsets.end(), [](const HitSetRange& lhs, const HitSetRange& rhs)
+            { return lhs.hitsetkey < rhs.hitsetkey; });
+
+  m_x.resize(m_keys.size());
+  m_y.resize(m_keys.size());
+  m_z.resize(m_keys.size());
+  m_valid.assign(m_keys.size(), 0);
+
+  // parametrized errors
+  m_phierror2.resize(m_keys.size());
+  m_zerror2.resize(m_keys.size());
+  ClusterErrorPara::get_clusterv5_modified_errors(m_keys.size(), m_clusters.data(), m_keys.data(), m_phierror2.data(), m_zerror2.data());
+}
+
+//_________________________________________________________________
+bool TrkrClusterGlobalPositionCache::get(TrkrDefs::cluskey key, const TrkrCluster* cluster, short int crossing, unsigned int configuration, Acts::Vector3& position) const
+{
+  if (!is_valid())
+  {
+    return false;
+  }
+
+  // crossing and distortion corrections only matter for the TPC
+  if (TrkrDefs::getTrkrId(key) == TrkrDefs::tpcId && (crossing != m_crossing || configuration != m_configuration))
+  {
+    return false;
+  }
+
+  const auto slot = find(key, cluster);
+  if (slot < 0 || !m_valid[slot])
+  {
+    return false;
+  }
+
+  position = {m_x[slot], m_y[slot], m_z[slot]};
+  return true;
+}
+
+//_________________________________________________________________
+bool TrkrClusterGlobalPositionCache::get_error(TrkrDefs::cluskey key, const TrkrCluster* cluster, std::pair<double, double>& error) const
+{
+  const auto slot = find(key, cluster);
+  if (slot < 0)
+  {
+    return false;
+  }
+
+  error = {m_phierror2[slot], m_zerror2[slot]};
+  return true;
+}
+
+//_________________________________________________________________
+int64_t TrkrClusterGlobalPositionCache::find(TrkrDefs::cluskey key, const TrkrCluster* cluster) const
+{
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+  const auto range = std::lower_bound(m_hitsets.begin(), m_hitsets.end(), hitsetkey, [](const HitSetRange& lhs, TrkrDefs::hitsetkey rhs)
+                                      { return lhs.hitsetkey < rhs; });
+  if (range == m_hitsets.end() || range->hitsetkey != hitsetkey)
+  {
+    return -1;
+  }
+
+  const auto first = m_keys.begin() + range->begin;
+  const auto last = m_keys.begin() + range->end;
+  const auto iter = std::lower_bound(first, last, key);
+  if (iter == last || *iter != key)
+  {
+    return -1;
+  }
+
+  const int64_t slot = iter - m_keys.begin();
+  return (m_clusters[slot] == cluster) ? slot : -1;
+}
+
+//_________________________________________________________________
+bool TrkrClusterGlobalPositionCache::is_valid() const
+{
+  return !m_keys.empty() && m_alignment_version == alignment_version();
+}
+
+//_________________________________________________________________
+unsigned int TrkrClusterGlobalPositionCache::alignment_version()
+{
+  return (alignmentTransformationContainer::version << 1U) | (alignmentTransformationContainer::use_alignment ? 1U : 0U);
+}
@@ -0,0 +1,128 @@
+#ifndef TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+#define TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.h
+ * @brief event wide table of cluster global positions, with all corrections applied
+ */
+
+#include "TrkrDefs.h"
+
+#include <phool/PHObject.h>
+
+#include <Acts/Definitions/Algebra.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+class TrkrCluster;
+class TrkrClusterContainer;
+
+/**
+ * @brief event wide table of cluster global positions, with all corrections applied
+ *
+ * The table is filled once per event, after clustering, by TrkrClusterGlobalPositionCacheMaker
+ * and is used by TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected
+ * in place of recomputing the positions.
+ *
+ * Positions are stored as structure of arrays. Clusters from a given hitset are contiguous
+ * and in the same order as in the TrkrClusterContainer.
+ * TPC positions depend on the crossing and on the set of distortion corrections used,
+ * they are only returned for the crossing and correction configuration used to fill the table.
+ * The whole table is invalidated when alignment transformations change.
+ *
+ * Parametrized cluster errors from ClusterErrorPara::get_clusterv5_modified_error
+ * are evaluated for all clusters when the table is created. They do not depend on crossing or alignment.
+ *
+ * The object is transient: it lives on a PHDataNode and is never written to the output
+ */
+class TrkrClusterGlobalPositionCache : public PHObject
+{
+ public:
+  //! constructor
+  TrkrClusterGlobalPositionCache() = default;
+
+  //! reset, called at the end of each event
+  void Reset() override;
+
+  //! identify
+  void identify(std::ostream& os = std::cout) const override;
+
+  //! allocate one slot per cluster in the container, for given crossing and distortion correction configuration
+  void init(TrkrClusterContainer*, short int crossing, unsigned int configuration);
+
+  //! number of slots
+  size_t size() const { return m_keys.size(); }
+
+  //! cluster key for a given slot
+  TrkrDefs::cluskey key(size_t slot) const { return m_keys[slot]; }
+
+  //! cluster for a given slot
+  TrkrCluster* cluster(size_t slot) const { return m_clusters[slot]; }
+
+  //! store global position for a given slot. Different slots can be set concurrently
+  void set(size_t slot, const Acts::Vector3& position)
+  {
+    m_x[slot] = position.x();
+    m_y[slot] = position.y();
+    m_z[slot] = position.z();
+    m_valid[slot] = 1;
+  }
+
+  //! get global position for a given cluster
+  /**
+   * returns false if the cluster is not in the table, if the cluster was replaced since the table was filled,
+   * or if crossing, correction configuration or alignment do not match
+   */
+  bool get(TrkrDefs::cluskey, const TrkrCluster*, short int crossing, unsigned int configuration, Acts::Vector3&) const;
+
+  //! get squared phi and z errors for a given cluster, as from ClusterErrorPara::get_clusterv5_modified_error
+  /** returns false if the cluster is not in the table, or if the cluster was replaced since the table was filled */
+  bool get_error(TrkrDefs::cluskey, const TrkrCluster*, std::pair<double, double>&) const;
+
+  //! true if the table is filled and valid for the current alignment
+  bool is_valid() const;
+
+  //! current alignment state, from alignmentTransformationContainer
+  static unsigned int alignment_version();
+
+ private:
+  //! range of slots for a given hitset
+  struct HitSetRange
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+  };
+
+  //! find slot for a given cluster. Returns -1 if not found or if the cluster was replaced
+  int64_t find(TrkrDefs::cluskey, const TrkrCluster*) const;
+
+  //! hitset ranges, sorted by hitset key
+  std::vector<HitSetRange> m_hitsets;
+
+  //!@name per slot quantities
+  //@{
+  std::vector<TrkrDefs::cluskey> m_keys;
+  std::vector<TrkrCluster*> m_clusters;
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_z;
+  std::vector<uint8_t> m_valid;
+  std::vector<double> m_phierror2;
+  std::vector<double> m_zerror2;
+  //@}
+
+  //! crossing used for TPC clusters
+  short int m_crossing = 0;
+
+  //! distortion corrections configuration used for TPC clusters
+  unsigned int m_configuration = 0;
+
+  //! alignment state when the table was created
+  unsigned int m_alignment_version = 0;
+};
+
+#endif
@@ -11,6 +11,8 @@
 #include "TrkrCluster.h"
 #include "TrkrDefs.h"
 
+#include <phool/PHEventArena.h>
+
 class PHObject;
 
 /**
@@ -22,6 +24,9 @@ class PHObject;
 class TrkrClusterv5 : public TrkrCluster
 {
  public:
+  //! allocated from the per event arena, if enabled
+  PHEVENTARENA_OPERATORS
+
   //! ctor
   TrkrClusterv5();
 
@@ -10,6 +10,7 @@
 #include "TrkrDefs.h"
 #include "TrkrHit.h"
 
+#include <phool/PHEventArena.h>
 #include <phool/PHObject.h>
 
 #include <iostream>
@@ -24,6 +25,9 @@
 class TrkrHitv2 : public TrkrHit
 {
  public:
+  //! allocated from the per event arena, if enabled
+  PHEVENTARENA_OPERATORS
+
   //! ctor
   explicit TrkrHitv2() = default;
 
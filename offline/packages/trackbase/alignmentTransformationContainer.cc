@@ -15,6 +15,7 @@
 #include <utility>
 
 bool alignmentTransformationContainer::use_alignment = false;
+unsigned int alignmentTransformationContainer::version = 0;
 
 alignmentTransformationContainer::alignmentTransformationContainer()
 {
@@ -29,6 +30,7 @@ void alignmentTransformationContainer::setMisalignmentFactor(uint8_t layer, doub
   if (it != m_misalignmentFactor.end())
   {
     it->second = factor;
+    ++version;
     return;
   }
   std::cout << "You provided a nonexistent layer in alignmentTransformationContainer::setMisalignmentFactor..."
@@ -36,6 +38,7 @@ void alignmentTransformationContainer::setMisalignmentFactor(uint8_t layer, doub
 }
 void alignmentTransformationContainer::Reset()
 {
+  ++version;
   if (transformVec.size() == 0)
   {
     return;
@@ -81,6 +84,7 @@ void alignmentTransformationContainer::identify(std::ostream& os)
 
 void alignmentTransformationContainer::addTransform(const Acts::GeometryIdentifier id, const Acts::Transform3& transform)
 {
+  ++version;
   unsigned int sphlayer = getsphlayer(id);
   unsigned int sensor = id.sensitive() - 1;  // Acts sensor numbering starts at 1
 
@@ -139,6 +143,7 @@ Acts::Transform3& alignmentTransformationContainer::getTransform(const Acts::Geo
 
 void alignmentTransformationContainer::replaceTransform(const Acts::GeometryIdentifier id, Acts::Transform3 transform)
 {
+  ++version;
   unsigned int sphlayer = getsphlayer(id);
   unsigned int sensor = id.sensitive() - 1;  // Acts sensor numbering starts at 1
 
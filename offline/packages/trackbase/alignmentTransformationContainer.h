@@ -40,6 +40,10 @@ class alignmentTransformationContainer
   const double& getMisalignmentFactor(uint8_t layer) const { return m_misalignmentFactor.find(layer)->second; }
   static bool use_alignment;
 
+  //! incremented each time a transformation is modified, in any container
+  /*! used together with use_alignment to invalidate cached global positions */
+  static unsigned int version;
+
  private:
   unsigned int getsphlayer(Acts::GeometryIdentifier);
 
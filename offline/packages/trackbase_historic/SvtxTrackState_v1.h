@@ -3,6 +3,8 @@
 
 #include "SvtxTrackState.h"
 
+#include <phool/PHEventArena.h>
+
 #include <cmath>
 #include <iostream>
 #include <string>  // for string, basic_string
@@ -12,6 +14,9 @@ class PHObject;
 class SvtxTrackState_v1 : public SvtxTrackState
 {
  public:
+  //! allocated from the per event arena, if enabled
+  PHEVENTARENA_OPERATORS
+
   SvtxTrackState_v1(float pathlength = 0.0);
   ~SvtxTrackState_v1() override {}
 
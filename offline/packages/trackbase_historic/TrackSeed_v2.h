@@ -5,6 +5,8 @@
 
 #include <trackbase/TrkrDefs.h>
 
+#include <phool/PHEventArena.h>
+
 #include <limits.h>
 #include <cmath>
 #include <iostream>
@@ -12,6 +14,9 @@
 class TrackSeed_v2 : public TrackSeed
 {
  public:
+  //! allocated from the per event arena, if enabled
+  PHEVENTARENA_OPERATORS
+
   TrackSeed_v2() = default;
 
   /// Copy constructors
@@ -87,6 +87,7 @@
 #include <TSystem.h>
 #include <TVector3.h>
 
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
@@ -157,6 +158,53 @@ namespace
     }
   }
 
+  // compare per-lookup cost of silicon and micromegas surfaces from flat tables and from maps
+  void benchmark_surface_lookup(const ActsSurfaceMaps &surfMaps)
+  {
+    std::vector<TrkrDefs::cluskey> keys;
+    for (const auto *map : {&surfMaps.m_siliconSurfaceMap, &surfMaps.m_mmSurfaceMap})
+    {
+      for (const auto &[hitsetkey, surface] : *map)
+      {
+        keys.push_back(TrkrDefs::genClusKey(hitsetkey, 0));
+      }
+    }
+    if (keys.empty())
+    {
+      return;
+    }
+
+    static constexpr int nrepeat = 1000;
+    const auto nlookups = static_cast<double>(nrepeat * keys.size());
+    size_t found = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nrepeat; ++i)
+    {
+      for (const auto &key : keys)
+      {
+        found += (surfMaps.getSurfacePointer(key, nullptr) != nullptr);
+      }
+    }
+    const std::chrono::duration<double, std::nano> table_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nrepeat; ++i)
+    {
+      for (const auto &key : keys)
+      {
+        const auto hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+        const auto iter = surfMaps.m_siliconSurfaceMap.find(hitsetkey);
+        found += (iter != surfMaps.m_siliconSurfaceMap.end() || surfMaps.m_mmSurfaceMap.count(hitsetkey));
+      }
+    }
+    const std::chrono::duration<double, std::nano> map_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << "MakeActsGeometry::InitRun - surface lookup, " << keys.size() << " surfaces, found " << found
+              << " - table: " << table_time.count() / nlookups << " ns"
+              << " map: " << map_time.count() / nlookups << " ns" << std::endl;
+  }
+
 }  // namespace
 
 MakeActsGeometry::MakeActsGeometry(const std::string &name)
@@ -275,6 +323,7 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
   surfMaps.m_tpcSurfaceMap = m_clusterSurfaceMapTpcEdit;
   surfMaps.m_mmSurfaceMap = m_clusterSurfaceMapMmEdit;
   surfMaps.m_tGeoNodeMap = m_clusterNodeMap;
+  surfMaps.buildLookupTables();
 
   // fill TPC volume ids
   for (const auto &[hitsetid, surfaceVector] : m_clusterSurfaceMapTpcEdit)
@@ -309,6 +358,13 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
   {
     alignment_transformation.misalignmentFactor(layer, factor);
   }
+
+  // TPC surface centers depend on alignment
+  m_actsGeometry->maps().updateSurfaceCenters(m_actsGeometry->geometry().getGeoContext());
+  if (Verbosity() > 0)
+  {
+    benchmark_surface_lookup(m_actsGeometry->maps());
+  }
   // print
   if (Verbosity() > 3)
   {
@@ -41,6 +41,51 @@
 #include <string>
 #include <utility>
 
+namespace
+{
+  // tower grids, in eta and phi bins
+  constexpr unsigned int emcal_neta = 96;
+  constexpr unsigned int emcal_nphi = 256;
+  constexpr unsigned int hcal_neta = 24;
+  constexpr unsigned int hcal_nphi = 64;
+
+  // peak minus pedestal of one waveform, for each sample in [sample_start, sample_end), stored in output.
+  // the peak is the maximum of 3 consecutive samples, the pedestal is the sample trig_sub_delay before the first one.
+  // The needed samples are copied once to buffer, rather than calling the accessor up to 7 times per sample
+  template <class Accessor>
+  void fill_peak_sub_ped(unsigned int *output, Accessor &&sample, int sample_start, int sample_end, int trig_sub_delay, std::vector<int> &buffer)
+  {
+    if (!output || sample_end <= sample_start)
+    {
+      return;
+    }
+
+    // pedestal sample index, for a given peak search sample
+    const auto pedestal_sample = [trig_sub_delay](int i)
+    { return static_cast<uint16_t>((i >= trig_sub_delay) ? i - trig_sub_delay : 0); };
+
+    // pedestal sample index is monotonous in i
+    const int first = std::min<int>(sample_start, pedestal_sample(sample_start));
+    const int last = std::max<int>(sample_end + 1, pedestal_sample(sample_end - 1));
+    buffer.resize(last - first + 1);
+    for (int i = first; i <= last; i++)
+    {
+      buffer[i - first] = sample(i);
+    }
+
+    const int *values = buffer.data();
+    for (int i = sample_start; i < sample_end; i++, output++)
+    {
+      const int index = i - first;
+      int16_t maxim = std::max(values[index], values[index + 1]);
+      maxim = std::max<int>(maxim, values[index + 2]);
+
+      const int pedestal = values[pedestal_sample(i) - first];
+      *output = (maxim > pedestal) ? (((uint16_t) (maxim - pedestal)) & 0x3fffU) : 0;
+    }
+  }
+}  // namespace
+
 // constructor
 CaloTriggerEmulator::CaloTriggerEmulator(const std::string &name)
   : SubsysReco(name)
@@ -576,13 +621,49 @@ int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
 // RESET event procedure that takes all variables to 0 and clears the primitives.
 int CaloTriggerEmulator::ResetEvent(PHCompositeNode * /*topNode*/)
 {
-  // here, the peak minus pedestal map is cleanly disposed of
-  m_peak_sub_ped_emcal.clear();
-  m_peak_sub_ped_hcalin.clear();
-  m_peak_sub_ped_hcalout.clear();
-
+  // the peak minus pedestal tables are zeroed when filled, in reset_peak_sub_ped
   return 0;
 }
+
+//____________________________________________________________________________..
+void CaloTriggerEmulator::PeakSubPedTable::reset(unsigned int neta, unsigned int nphi, unsigned int nsamples)
+{
+  m_neta = neta;
+  m_nphi = nphi;
+  m_nsamples = nsamples;
+  m_values.assign(static_cast<size_t>(neta) * nphi * nsamples, 0);
+}
+
+//____________________________________________________________________________..
+unsigned int *CaloTriggerEmulator::PeakSubPedTable::get(unsigned int key)
+{
+  const unsigned int etabin = TowerInfoDefs::getCaloTowerEtaBin(key);
+  const unsigned int phibin = TowerInfoDefs::getCaloTowerPhiBin(key);
+  if (etabin >= m_neta || phibin >= m_nphi)
+  {
+    return nullptr;
+  }
+  return m_values.data() + static_cast<size_t>(etabin * m_nphi + phibin) * m_nsamples;
+}
+
+//____________________________________________________________________________..
+void CaloTriggerEmulator::reset_peak_sub_ped(int nsamples)
+{
+  const unsigned int nwindow = std::max(nsamples, 0);
+  if (m_do_emcal)
+  {
+    m_peak_sub_ped_emcal.reset(emcal_neta, emcal_nphi, nwindow);
+  }
+  if (m_do_hcalout)
+  {
+    m_peak_sub_ped_hcalout.reset(hcal_neta, hcal_nphi, nwindow);
+  }
+  if (m_do_hcalin)
+  {
+    m_peak_sub_ped_hcalin.reset(hcal_neta, hcal_nphi, nwindow);
+  }
+}
+
 int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
 {
   int sample_start = 1;
@@ -592,6 +673,7 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
     sample_start = m_trig_sample;
     sample_end = m_trig_sample + 1;
   }
+  reset_peak_sub_ped(sample_end - sample_start);
 
   if (m_do_emcal)
   {
@@ -635,68 +717,21 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
             unsigned int adcboard = (unsigned int) channel / 64;
             if ((adc_skip_mask >> adcboard) & 0x1U)
             {
-              for (int iskip = 0; iskip < 64; iskip++)
-              {
-                std::vector<unsigned int> v_peak_sub_ped;
-                for (int i = sample_start; i < sample_end; i++)
-                {
-                  v_peak_sub_ped.push_back(0);
-                }
-                unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-                m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
-                iwave++;
-              }
-            }
-          }
-          std::vector<unsigned int> v_peak_sub_ped;
-          if (packet->iValue(channel, "SUPPRESSED"))
-          {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
+              // masked board, peak minus pedestal stays at zero
+              iwave += 64;
             }
           }
-          else
+          if (!packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
-            }
+            const auto sample = [packet, channel](int i)
+            { return packet->iValue(i, channel); };
+            fill_peak_sub_ped(m_peak_sub_ped_emcal.get(TowerInfoDefs::encode_emcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
           }
-          unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-          m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
           iwave++;
         }
         if (nchannels < 192 && !(adc_skip_mask < 4))
         {
-          for (int iskip = 0; iskip < 192 - nchannels; iskip++)
-          {
-            std::vector<unsigned int> v_peak_sub_ped;
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
-            unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-            m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
-            iwave++;
-          }
+          iwave += 192 - nchannels;
         }
       }
     }
@@ -727,40 +762,12 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
-          if (packet->iValue(channel, "SUPPRESSED"))
-          {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
-          }
-          else
+          if (!packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
-            }
+            const auto sample = [packet, channel](int i)
+            { return packet->iValue(i, channel); };
+            fill_peak_sub_ped(m_peak_sub_ped_hcalout.get(TowerInfoDefs::encode_hcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -792,40 +799,12 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
-          if (packet->iValue(channel, "SUPPRESSED"))
-          {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
-          }
-          else
+          if (!packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
-            }
+            const auto sample = [packet, channel](int i)
+            { return packet->iValue(i, channel); };
+            fill_peak_sub_ped(m_peak_sub_ped_hcalin.get(TowerInfoDefs::encode_hcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -869,6 +848,7 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
     sample_start = m_trig_sample;
     sample_end = m_trig_sample + 1;
   }
+  reset_peak_sub_ped(sample_end - sample_start);
 
   if (m_do_emcal)
   {
@@ -894,54 +874,17 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
             unsigned int adcboard = (unsigned int) channel / 64;
             if ((adc_skip_mask >> adcboard) & 0x1U)
             {
-              for (int iskip = 0; iskip < 64; iskip++)
-              {
-                std::vector<unsigned int> v_peak_sub_ped;
-                for (int i = sample_start; i < sample_end; i++)
-                {
-                  v_peak_sub_ped.push_back(0);
-                }
-                unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-                m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
-                iwave++;
-              }
+              // masked board, peak minus pedestal stays at zero
+              iwave += 64;
               continue;
             }
           }
-          std::vector<unsigned int> v_peak_sub_ped;
-          if (packet->iValue(channel, "SUPPRESSED"))
+          if (!packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
+            const auto sample = [packet, channel](int i)
+            { return packet->iValue(i, channel); };
+            fill_peak_sub_ped(m_peak_sub_ped_emcal.get(TowerInfoDefs::encode_emcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
           }
-          else
-          {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
-            }
-          }
-          unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-          m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -965,40 +908,12 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
-          if (packet->iValue(channel, "SUPPRESSED"))
-          {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
-          }
-          else
+          if (!packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
-            }
+            const auto sample = [packet, channel](int i)
+            { return packet->iValue(i, channel); };
+            fill_peak_sub_ped(m_peak_sub_ped_hcalout.get(TowerInfoDefs::encode_hcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -1022,40 +937,12 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
-          if (packet->iValue(channel, "SUPPRESSED"))
-          {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
-          }
-          else
+          if (!packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
-            }
+            const auto sample = [packet, channel](int i)
+            { return packet->iValue(i, channel); };
+            fill_peak_sub_ped(m_peak_sub_ped_hcalin.get(TowerInfoDefs::encode_hcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -1081,6 +968,7 @@ int CaloTriggerEmulator::process_sim()
     sample_start = m_trig_sample;
     sample_end = m_trig_sample + 1;
   }
+  reset_peak_sub_ped(sample_end - sample_start);
 
   if (m_do_emcal)
   {
@@ -1095,42 +983,13 @@ int CaloTriggerEmulator::process_sim()
     // for each waveform, clauclate the peak - pedestal given the sub-delay setting
     for (unsigned int iwave = 0; iwave < (unsigned int) m_waveforms_emcal->size(); iwave++)
     {
-      std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_emcal->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-      if (tower->get_isZS())
-      {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          v_peak_sub_ped.push_back(0);
-        }
-      }
-      else
+      if (!tower->get_isZS())
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          int16_t maxim = (tower->get_waveform_value(i) > tower->get_waveform_value(i + 1) ? tower->get_waveform_value(i) : tower->get_waveform_value(i + 1));
-          maxim = (maxim > tower->get_waveform_value(i + 2) ? maxim : tower->get_waveform_value(i + 2));
-          uint16_t sam = 0;
-          if (i >= m_trig_sub_delay)
-          {
-            sam = i - m_trig_sub_delay;
-          }
-          else
-          {
-            sam = 0;
-          }
-          unsigned int sub = 0;
-          if (maxim > tower->get_waveform_value(sam))
-          {
-            sub = (((uint16_t) (maxim - tower->get_waveform_value(sam))) & 0x3fffU);
-          }
-
-          v_peak_sub_ped.push_back(sub);
-        }
+        const auto sample = [tower](int i)
+        { return tower->get_waveform_value(i); };
+        fill_peak_sub_ped(m_peak_sub_ped_emcal.get(TowerInfoDefs::encode_emcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
       }
-      // save in global.
-      m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
     }
   }
   if (m_do_hcalout)
@@ -1149,42 +1008,13 @@ int CaloTriggerEmulator::process_sim()
 
     for (unsigned int iwave = 0; iwave < (unsigned int) m_waveforms_hcalout->size(); iwave++)
     {
-      std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_hcalout->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-      if (tower->get_isZS())
+      if (!tower->get_isZS())
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          v_peak_sub_ped.push_back(0);
-        }
-      }
-      else
-      {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          int16_t maxim = (tower->get_waveform_value(i) > tower->get_waveform_value(i + 1) ? tower->get_waveform_value(i) : tower->get_waveform_value(i + 1));
-          maxim = (maxim > tower->get_waveform_value(i + 2) ? maxim : tower->get_waveform_value(i + 2));
-          uint16_t sam = 0;
-          if (i >= m_trig_sub_delay)
-          {
-            sam = i - m_trig_sub_delay;
-          }
-          else
-          {
-            sam = 0;
-          }
-          unsigned int sub = 0;
-          if (maxim > tower->get_waveform_value(sam))
-          {
-            sub = (((uint16_t) (maxim - tower->get_waveform_value(sam))) & 0x3fffU);
-          }
-
-          v_peak_sub_ped.push_back(sub);
-        }
+        const auto sample = [tower](int i)
+        { return tower->get_waveform_value(i); };
+        fill_peak_sub_ped(m_peak_sub_ped_hcalout.get(TowerInfoDefs::encode_hcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
       }
-      // save in global.
-      m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
     }
   }
   if (m_do_hcalin)
@@ -1207,42 +1037,13 @@ int CaloTriggerEmulator::process_sim()
     // for each waveform, clauclate the peak - pedestal given the sub-delay setting
     for (unsigned int iwave = 0; iwave < (unsigned int) m_waveforms_hcalin->size(); iwave++)
     {
-      std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_hcalin->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-      if (tower->get_isZS())
+      if (!tower->get_isZS())
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          v_peak_sub_ped.push_back(0);
-        }
+        const auto sample = [tower](int i)
+        { return tower->get_waveform_value(i); };
+        fill_peak_sub_ped(m_peak_sub_ped_hcalin.get(TowerInfoDefs::encode_hcal(iwave)), sample, sample_start, sample_end, m_trig_sub_delay, m_waveform_buffer);
       }
-      else
-      {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          int16_t maxim = (tower->get_waveform_value(i) > tower->get_waveform_value(i + 1) ? tower->get_waveform_value(i) : tower->get_waveform_value(i + 1));
-          maxim = (maxim > tower->get_waveform_value(i + 2) ? maxim : tower->get_waveform_value(i + 2));
-          uint16_t sam = 0;
-          if (i >= m_trig_sub_delay)
-          {
-            sam = i - m_trig_sub_delay;
-          }
-          else
-          {
-            sam = 0;
-          }
-          unsigned int sub = 0;
-          if (maxim > tower->get_waveform_value(sam))
-          {
-            sub = (((uint16_t) (maxim - tower->get_waveform_value(sam))) & 0x3fffU);
-          }
-
-          v_peak_sub_ped.push_back(sub);
-        }
-      }
-      // save in global.
-      m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
     }
   }
 
@@ -1266,6 +1067,17 @@ int CaloTriggerEmulator::process_primitives()
     std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives" << std::endl;
   }
 
+  // identifiers do not change inside the loops
+  const TriggerDefs::TriggerId none_tid = TriggerDefs::GetTriggerId("NONE");
+
+  // towers of one sum, and their lookup tables
+  const unsigned int *peak_sub_ped[4] = {nullptr};
+  TH1 *lut[4] = {nullptr};
+
+  // lookup table input of tower j, for sample is
+  const auto lut_input = [&peak_sub_ped](int j, int is)
+  { return peak_sub_ped[j] ? ((peak_sub_ped[j][is] >> 4U) & 0x3ffU) : 0U; };
+
   if (m_do_emcal)
   {
     if (Verbosity())
@@ -1273,6 +1085,9 @@ int CaloTriggerEmulator::process_primitives()
       std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: emcal" << std::endl;
     }
 
+    const TriggerDefs::DetectorId emcal_did = TriggerDefs::GetDetectorId("EMCAL");
+    const TriggerDefs::PrimitiveId emcal_pid = TriggerDefs::GetPrimitiveId("EMCAL");
+
     ip = 0;
 
     // get the number of primitives needed to process
@@ -1285,7 +1100,7 @@ int CaloTriggerEmulator::process_primitives()
       }
       unsigned int tmp = 0;
       // get the primitive key of what we are making, in order of the packet ID and channel number
-      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip);
+      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(none_tid, emcal_did, emcal_pid, ip);
 
       TriggerPrimitive *primitive = m_primitives_emcal->get_primitive_at_key(primkey);
       unsigned int sum = 0;
@@ -1296,7 +1111,7 @@ int CaloTriggerEmulator::process_primitives()
       for (int isum = 0; isum < m_n_sums; isum++)
       {
         // get sum key
-        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip, isum);
+        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(none_tid, emcal_did, emcal_pid, ip, isum);
 
         // calculate sums for all samples, hense the vector.
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
@@ -1304,6 +1119,17 @@ int CaloTriggerEmulator::process_primitives()
 
         // check to mask channel (if fiber masked, automatically mask the channel)
         bool mask_channel = mask || CheckChannelMasks(sumkey);
+        if (!mask_channel)
+        {
+          for (int j = 0; j < 4; j++)
+          {
+            // unsigned int iwave = 64*ip + isum*4 + j;
+            unsigned int key = TriggerDefs::GetTowerInfoKey(emcal_did, ip, isum, j);
+            peak_sub_ped[j] = m_peak_sub_ped_emcal.get(key);
+            lut[j] = m_default_lut_emcal ? nullptr : h_emcal_lut[key];
+          }
+        }
+
         for (int is = 0; is < nsample; is++)
         {
           sum = 0;
@@ -1314,18 +1140,14 @@ int CaloTriggerEmulator::process_primitives()
           {
             for (int j = 0; j < 4; j++)
             {
-              // unsigned int iwave = 64*ip + isum*4 + j;
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("EMCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_emcal[key].at(is) >> 4U) & 0x3ffU;
-
               // shift before the sum
               if (m_default_lut_emcal)
               {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
+                tmp = (m_l1_adc_table[lut_input(j, is)] >> 2U);
               }
               else
               {
-                unsigned int lut_output = ((unsigned int) h_emcal_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
+                unsigned int lut_output = ((unsigned int) lut[j]->GetBinContent(lut_input(j, is) + 1)) & 0x3ffU;
                 tmp = (lut_output >> 2U);
               }
               temp_sum += (tmp & 0xffU);
@@ -1356,21 +1178,34 @@ int CaloTriggerEmulator::process_primitives()
       std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: ohcal" << std::endl;
     }
 
+    const TriggerDefs::DetectorId hcalout_did = TriggerDefs::GetDetectorId("HCALOUT");
+    const TriggerDefs::PrimitiveId hcalout_pid = TriggerDefs::GetPrimitiveId("HCALOUT");
+    const TriggerDefs::DetectorId hcal_did = TriggerDefs::GetDetectorId("HCAL");
+
     ip = 0;
 
     m_n_primitives = m_prim_map[TriggerDefs::DetectorId::hcaloutDId];
 
     for (i = 0; i < m_n_primitives; i++, ip++)
     {
-      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip);
+      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(none_tid, hcalout_did, hcalout_pid, ip);
       TriggerPrimitive *primitive = m_primitives_hcalout->get_primitive_at_key(primkey);
       unsigned int sum;
       mask = CheckFiberMasks(primkey);
       for (int isum = 0; isum < m_n_sums; isum++)
       {
-        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip, isum);
+        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(none_tid, hcalout_did, hcalout_pid, ip, isum);
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
         mask |= CheckChannelMasks(sumkey);
+        if (!mask)
+        {
+          for (int j = 0; j < 4; j++)
+          {
+            unsigned int key = TriggerDefs::GetTowerInfoKey(hcal_did, ip, isum, j);
+            peak_sub_ped[j] = m_peak_sub_ped_hcalout.get(key);
+            lut[j] = m_default_lut_hcalout ? nullptr : h_hcalout_lut[key];
+          }
+        }
         for (int is = 0; is < nsample; is++)
         {
           sum = 0;
@@ -1379,16 +1214,14 @@ int CaloTriggerEmulator::process_primitives()
           {
             for (int j = 0; j < 4; j++)
             {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalout[key].at(is) >> 4U) & 0x3ffU;
               unsigned int tmp = 0;
               if (m_default_lut_hcalout)
               {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
+                tmp = (m_l1_adc_table[lut_input(j, is)] >> 2U);
               }
               else
               {
-                unsigned int lut_output = ((unsigned int) h_hcalout_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
+                unsigned int lut_output = ((unsigned int) lut[j]->GetBinContent(lut_input(j, is) + 1)) & 0x3ffU;
                 tmp = (lut_output >> 2U);
               }
               temp_sum += (tmp & 0xffU);
@@ -1414,19 +1247,32 @@ int CaloTriggerEmulator::process_primitives()
       std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: ihcal" << std::endl;
     }
 
+    const TriggerDefs::DetectorId hcalin_did = TriggerDefs::GetDetectorId("HCALIN");
+    const TriggerDefs::PrimitiveId hcalin_pid = TriggerDefs::GetPrimitiveId("HCALIN");
+    const TriggerDefs::DetectorId hcal_did = TriggerDefs::GetDetectorId("HCAL");
+
     m_n_primitives = m_prim_map[TriggerDefs::DetectorId::hcalinDId];
 
     for (i = 0; i < m_n_primitives; i++, ip++)
     {
-      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip);
+      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(none_tid, hcalin_did, hcalin_pid, ip);
       TriggerPrimitive *primitive = m_primitives_hcalin->get_primitive_at_key(primkey);
       unsigned int sum;
       mask = CheckFiberMasks(primkey);
       for (int isum = 0; isum < m_n_sums; isum++)
       {
-        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip, isum);
+        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(none_tid, hcalin_did, hcalin_pid, ip, isum);
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
         mask |= CheckChannelMasks(sumkey);
+        if (!mask)
+        {
+          for (int j = 0; j < 4; j++)
+          {
+            unsigned int key = TriggerDefs::GetTowerInfoKey(hcal_did, ip, isum, j);
+            peak_sub_ped[j] = m_peak_sub_ped_hcalin.get(key);
+            lut[j] = m_default_lut_hcalin ? nullptr : h_hcalin_lut[key];
+          }
+        }
         for (int is = 0; is < nsample; is++)
         {
           sum = 0;
@@ -1435,16 +1281,14 @@ int CaloTriggerEmulator::process_primitives()
           {
             for (int j = 0; j < 4; j++)
             {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalin[key].at(is) >> 4U) & 0x3ffU;
               unsigned int tmp = 0;
               if (m_default_lut_hcalin)
               {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
+                tmp = (m_l1_adc_table[lut_input(j, is)] >> 2U);
               }
               else
               {
-                unsigned int lut_output = ((unsigned int) h_hcalin_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
+                unsigned int lut_output = ((unsigned int) lut[j]->GetBinContent(lut_input(j, is) + 1)) & 0x3ffU;
                 tmp = (lut_output >> 2U);
               }
               temp_sum += (tmp & 0x3ffU);
@@ -204,9 +204,33 @@ class CaloTriggerEmulator : public SubsysReco
   CDBHistos *cdbttree_hcalin{nullptr};
   CDBHistos *cdbttree_hcalout{nullptr};
 
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_emcal{};
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_hcalin{};
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_hcalout{};
+  //! peak minus pedestal of all towers of one calorimeter, for each sample of the trigger window
+  /** dense table indexed by tower eta and phi bins. Towers which are not read out stay at zero */
+  class PeakSubPedTable
+  {
+   public:
+    //! set dimensions and zero all values
+    void reset(unsigned int neta, unsigned int nphi, unsigned int nsamples);
+
+    //! values of the tower with given TowerInfo key, nullptr if outside of the table
+    unsigned int *get(unsigned int key);
+
+   private:
+    unsigned int m_neta{0};
+    unsigned int m_nphi{0};
+    unsigned int m_nsamples{0};
+    std::vector<unsigned int> m_values{};
+  };
+
+  //! reset the peak minus pedestal tables of the enabled calorimeters, for a trigger window of nsamples
+  void reset_peak_sub_ped(int nsamples);
+
+  PeakSubPedTable m_peak_sub_ped_emcal{};
+  PeakSubPedTable m_peak_sub_ped_hcalin{};
+  PeakSubPedTable m_peak_sub_ped_hcalout{};
+
+  //! scratch waveform buffer used to compute the peak minus pedestal
+  std::vector<int> m_waveform_buffer{};
 
   //! Verbosity.
   int m_nevent{0};
@@ -50,18 +50,13 @@ SvtxClusterEval::~SvtxClusterEval()
 
 void SvtxClusterEval::next_event(PHCompositeNode* topNode)
 {
-  _cache_all_truth_hits.clear();
+  _truth_table.clear();
   _cache_all_truth_clusters.clear();
   _cache_max_truth_hit_by_energy.clear();
   _cache_max_truth_cluster_by_energy.clear();
-  _cache_all_truth_particles.clear();
   _cache_max_truth_particle_by_energy.clear();
   _cache_max_truth_particle_by_cluster_energy.clear();
-  _cache_all_clusters_from_particle.clear();
-  _cache_all_clusters_from_g4hit.clear();
   _cache_best_cluster_from_g4hit.clear();
-  _cache_get_energy_contribution_g4particle.clear();
-  _cache_get_energy_contribution_g4hit.clear();
   _cache_best_cluster_from_gtrackid_layer.clear();
   _clusters_per_layer.clear();
   //  _g4hits_per_layer.clear();
@@ -344,69 +339,14 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     return std::set<PHG4Hit*>();
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>>::iterator iter =
-        _cache_all_truth_hits.find(cluster_key);
-    if (iter != _cache_all_truth_hits.end())
-    {
-      return iter->second;
-    }
-  }
+  FillRecoClusterFromG4HitCache();
 
+  // all truth hits for this cluster, obtained from the TrkrAssoc maps
   std::set<PHG4Hit*> truth_hits;
-
-  // get all truth hits for this cluster
-  //_cluster_hit_map->identify();
-  std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-      hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-
-  for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-           clushititer = hitrange.first;
-       clushititer != hitrange.second; ++clushititer)
+  const auto range = _truth_table.get_entries(cluster_key);
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    TrkrDefs::hitkey hitkey = clushititer->second;
-    // TrkrHitTruthAssoc uses a map with (hitsetkey, std::pair(hitkey, g4hitkey)) - get the hitsetkey from the cluskey
-    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
-
-    // get all of the g4hits for this hitkey
-    std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>> temp_map;
-    _hit_truth_map->getG4Hits(hitsetkey, hitkey, temp_map);
-    // returns pairs (hitsetkey, std::pair(hitkey, g4hitkey)) for this hitkey only
-
-    for (auto& htiter : temp_map)
-    {
-      // extract the g4 hit key here and add the hits to the set
-      PHG4HitDefs::keytype g4hitkey = htiter.second.second;
-      PHG4Hit* g4hit = nullptr;
-      unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
-      switch (trkrid)
-      {
-      case TrkrDefs::tpcId:
-        g4hit = _g4hits_tpc->findHit(g4hitkey);
-        break;
-      case TrkrDefs::inttId:
-        g4hit = _g4hits_intt->findHit(g4hitkey);
-        break;
-      case TrkrDefs::mvtxId:
-        g4hit = _g4hits_mvtx->findHit(g4hitkey);
-        break;
-      case TrkrDefs::micromegasId:
-        g4hit = _g4hits_mms->findHit(g4hitkey);
-        break;
-      default:
-        break;
-      }
-      if (g4hit)
-      {
-        truth_hits.insert(g4hit);
-      }
-    }  // end loop over g4hits associated with hitsetkey and hitkey
-  }  // end loop over hits associated with cluskey
-
-  if (_do_cache)
-  {
-    _cache_all_truth_hits.insert(std::make_pair(cluster_key, truth_hits));
+    truth_hits.insert(truth_hits.end(), iter->g4hit);
   }
 
   return truth_hits;
@@ -786,24 +726,23 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
     return std::set<PHG4Particle*>();
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>>::iterator iter =
-        _cache_all_truth_particles.find(cluster_key);
-    if (iter != _cache_all_truth_particles.end())
-    {
-      return iter->second;
-    }
-  }
+  FillRecoClusterFromG4HitCache();
 
   std::set<PHG4Particle*> truth_particles;
 
-  std::set<PHG4Hit*> g4hits = all_truth_hits(cluster_key);
-
-  for (auto* hit : g4hits)
+  const auto range = _truth_table.get_entries(cluster_key);
+  int last_trkid = 0;
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    PHG4Particle* particle = get_truth_eval()->get_particle(hit);
-    // std::cout << "cluster key " << cluster_key << " has hit " << hit->get_hit_id() << " and has particle " << particle->get_track_id() << std::endl;
+    // consecutive g4hits frequently come from the same particle
+    if (iter != range.first && iter->trkid == last_trkid)
+    {
+      continue;
+    }
+    last_trkid = iter->trkid;
+
+    PHG4Particle* particle = get_truth_eval()->get_particle(iter->g4hit);
+    // std::cout << "cluster key " << cluster_key << " has hit " << iter->g4hit->get_hit_id() << " and has particle " << particle->get_track_id() << std::endl;
 
     if (_strict)
     {
@@ -818,11 +757,6 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
     truth_particles.insert(particle);
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_particles.insert(std::make_pair(cluster_key, truth_particles));
-  }
-
   return truth_particles;
 }
 
@@ -937,68 +871,41 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Particle* tru
     ++_errors;
     return std::set<TrkrDefs::cluskey>();
   }
-  // check if cache is filled, if not fill it.
-  //   if(_cache_all_clusters_from_particle.count(truthparticle)==0){
-  if (_cache_all_clusters_from_particle.empty())
-  {
-    FillRecoClusterFromG4HitCache();
-  }
+  FillRecoClusterFromG4HitCache();
 
-  if (_do_cache)
+  std::set<TrkrDefs::cluskey> clusters;
+  const auto range = _truth_table.get_clusters(truthparticle->get_track_id());
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>>::iterator iter =
-        _cache_all_clusters_from_particle.find(truthparticle);
-    if (iter != _cache_all_clusters_from_particle.end())
-    {
-      return iter->second;
-    }
+    clusters.insert(clusters.end(), iter->second);
   }
-  std::set<TrkrDefs::cluskey> clusters;
   return clusters;
 }
 
 void SvtxClusterEval::FillRecoClusterFromG4HitCache()
 {
+  if (_truth_table.is_built())
+  {
+    return;
+  }
+
   auto Mytimer = std::make_unique<PHTimer>("ReCl_timer");
   Mytimer->stop();
   Mytimer->restart();
 
-  std::multimap<PHG4Particle*, TrkrDefs::cluskey> temp_clusters_from_particles;
-  // loop over all the clusters
-  for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-  {
-    auto range = _clustermap->getClusters(hitsetkey);
-    for (auto iter = range.first; iter != range.second; ++iter)
-    {
-      TrkrDefs::cluskey cluster_key = iter->first;
-
-      // loop over all truth particles connected to this cluster
-      std::set<PHG4Particle*> particles = all_truth_particles(cluster_key);
-      for (auto* candidate : particles)
-      {
-        temp_clusters_from_particles.insert(std::make_pair(candidate, cluster_key));
-      }
-    }
-  }
-  // Loop over particles and fill cache
-  PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second; ++iter)
-  {
-    PHG4Particle* g4particle = iter->second;
-    std::set<TrkrDefs::cluskey> clusters;
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
-    {
-      TrkrDefs::cluskey cluster_key = cfp_iter->second;
-      clusters.insert(cluster_key);
-    }
-    _cache_all_clusters_from_particle.insert(std::make_pair(g4particle, clusters));
-  }
+  SvtxClusterTruthTable::G4HitContainers g4hits;
+  g4hits.mvtx = _g4hits_mvtx;
+  g4hits.intt = _g4hits_intt;
+  g4hits.tpc = _g4hits_tpc;
+  g4hits.micromegas = _g4hits_mms;
+  _truth_table.build(_clustermap, _cluster_hit_map, _hit_truth_map, g4hits);
 
   Mytimer->stop();
+  if (_verbosity > 1)
+  {
+    std::cout << "SvtxClusterEval::FillRecoClusterFromG4HitCache - " << _truth_table.size()
+              << " cluster/g4hit associations, " << Mytimer->elapsed() << " ms" << std::endl;
+  }
 }
 
 std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit)
@@ -1019,110 +926,21 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit
     return std::set<TrkrDefs::cluskey>();
   }
 
-  // one time, fill cache of g4hit/cluster pairs
-  if (_cache_all_clusters_from_g4hit.empty())
-  {
-    // make a map of truthhit, cluster_key inside this loop
-    std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey> truth_cluster_map;
-    std::set<PHG4HitDefs::keytype> all_g4hits_set;
-    std::map<PHG4HitDefs::keytype, PHG4Hit*> all_g4hits_map;
-
-    // get all reco clusters
-    if (_verbosity > 1)
-    {
-      std::cout << "all_clusters_from_g4hit: list all reco clusters " << std::endl;
-    }
-
-    for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-    {
-      auto range = _clustermap->getClusters(hitsetkey);
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        TrkrDefs::cluskey cluster_key = iter->first;
-        int layer = TrkrDefs::getLayer(cluster_key);
-        TrkrCluster* clus = iter->second;
-        if (_verbosity > 1)
-        {
-          std::cout << " layer " << layer << " cluster_key " << cluster_key << " adc " << clus->getAdc()
-                    << " localx " << clus->getLocalX()
-                    << " localy " << clus->getLocalY()
-                    << std::endl;
-          std::cout << "  associated hits:";
-          std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-              hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-          for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-                   clushititer = hitrange.first;
-               clushititer != hitrange.second; ++clushititer)
-          {
-            TrkrDefs::hitkey hitkey = clushititer->second;
-            std::cout << " " << hitkey;
-          }
-          std::cout << std::endl;
-        }
-
-        // the returned truth hits were obtained from TrkrAssoc maps
-        std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-        for (auto* candidate : hits)
-        {
-          PHG4HitDefs::keytype g4hit_key = candidate->get_hit_id();
-
-          if (_verbosity > 5)
-          {
-            int gtrackID = candidate->get_trkid();
-            std::cout << "   adding cluster with cluster_key " << cluster_key << " g4hit with g4hit_key " << g4hit_key
-                      << " gtrackID " << gtrackID
-                      << std::endl;
-          }
-
-          all_g4hits_set.insert(g4hit_key);
-          all_g4hits_map.insert(std::make_pair(g4hit_key, candidate));
-
-          truth_cluster_map.insert(std::make_pair(g4hit_key, cluster_key));
-        }
-      }
-    }
-
-    // now fill the cache
-    // loop over all entries in all_g4hits
-    for (unsigned long long g4hit_key : all_g4hits_set)
-    {
-      if (_verbosity > 5)
-      {
-        std::cout << " associations for g4hit_key " << g4hit_key << std::endl;
-      }
-
-      std::map<PHG4HitDefs::keytype, PHG4Hit*>::iterator it = all_g4hits_map.find(g4hit_key);
-      PHG4Hit* g4hit = it->second;
-
-      std::set<TrkrDefs::cluskey> assoc_clusters;
-
-      std::pair<std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator,
-                std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator>
-          ret = truth_cluster_map.equal_range(g4hit_key);
-      for (std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator jter = ret.first; jter != ret.second; ++jter)
-      {
-        assoc_clusters.insert(jter->second);
-
-        if (_verbosity > 5)
-        {
-          std::cout << "             g4hit_key " << g4hit_key << " associated with cluster_key " << jter->second << std::endl;
-        }
-      }
-      // done with this g4hit
-      _cache_all_clusters_from_g4hit.insert(std::make_pair(g4hit, assoc_clusters));
-    }
-  }
+  FillRecoClusterFromG4HitCache();
 
   // get the clusters
   std::set<TrkrDefs::cluskey> clusters;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>>::iterator iter =
-      _cache_all_clusters_from_g4hit.find(truthhit);
-  if (iter != _cache_all_clusters_from_g4hit.end())
+  const auto range = _truth_table.get_clusters(truthhit);
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    return iter->second;
+    if (_verbosity > 5)
+    {
+      std::cout << "             g4hit_key " << truthhit->get_hit_id() << " associated with cluster_key " << iter->second << std::endl;
+    }
+    clusters.insert(clusters.end(), iter->second);
   }
 
-  if (_clusters_per_layer.empty())
+  if (clusters.empty() && _clusters_per_layer.empty())
   {
     fill_cluster_layer_map();
   }
@@ -1278,32 +1096,9 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return std::numeric_limits<float>::quiet_NaN();
   }
 
-  if (_do_cache)
-  {
-    std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4particle.find(std::make_pair(cluster_key, particle));
-    if (iter != _cache_get_energy_contribution_g4particle.end())
-    {
-      return iter->second;
-    }
-  }
-
-  float energy = 0.0;
-  std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-  for (auto* hit : hits)
-  {
-    if (get_truth_eval()->is_g4hit_from_particle(hit, particle))
-    {
-      energy += hit->get_edep();
-    }
-  }
-
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4particle.insert(std::make_pair(std::make_pair(cluster_key, particle), energy));
-  }
+  FillRecoClusterFromG4HitCache();
 
-  return energy;
+  return _truth_table.get_energy(cluster_key, particle->get_track_id());
 }
 
 float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PHG4Hit* g4hit)
@@ -1325,32 +1120,9 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return std::numeric_limits<float>::quiet_NaN();
   }
 
-  if ((_do_cache) &&
-      (_cache_get_energy_contribution_g4hit.contains(std::make_pair(cluster_key, g4hit))))
-  {
-    return _cache_get_energy_contribution_g4hit[std::make_pair(cluster_key, g4hit)];
-  }
-
-  // this is a fairly simple existance check right now, but might be more
-  // complex in the future, so this is here mostly as future-proofing.
-
-  float energy = 0.0;
-  std::set<PHG4Hit*> g4hits = all_truth_hits(cluster_key);
-  for (auto* candidate : g4hits)
-  {
-    if (candidate->get_hit_id() != g4hit->get_hit_id())
-    {
-      continue;
-    }
-    energy += candidate->get_edep();
-  }
-
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4hit.insert(std::make_pair(std::make_pair(cluster_key, g4hit), energy));
-  }
+  FillRecoClusterFromG4HitCache();
 
-  return energy;
+  return _truth_table.get_energy(cluster_key, g4hit->get_hit_id());
 }
 
 void SvtxClusterEval::get_node_pointers(PHCompositeNode* topNode)
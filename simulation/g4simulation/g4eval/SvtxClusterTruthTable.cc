@@ -0,0 +1,180 @@
+#include "SvtxClusterTruthTable.h"
+
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterHitAssoc.h>
+#include <trackbase/TrkrHitTruthAssoc.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+namespace
+{
+  //! order entries by cluster key, then g4hit
+  bool entry_less(const SvtxClusterTruthTable::Entry& lhs, const SvtxClusterTruthTable::Entry& rhs)
+  {
+    return lhs.cluskey < rhs.cluskey || (lhs.cluskey == rhs.cluskey && std::less<PHG4Hit*>()(lhs.g4hit, rhs.g4hit));
+  }
+
+  bool entry_equal(const SvtxClusterTruthTable::Entry& lhs, const SvtxClusterTruthTable::Entry& rhs)
+  {
+    return lhs.cluskey == rhs.cluskey && lhs.g4hit == rhs.g4hit;
+  }
+
+  //! compare entries to cluster key only, for binary searches
+  struct EntryKeyCompare
+  {
+    bool operator()(const SvtxClusterTruthTable::Entry& entry, TrkrDefs::cluskey key) const { return entry.cluskey < key; }
+    bool operator()(TrkrDefs::cluskey key, const SvtxClusterTruthTable::Entry& entry) const { return key < entry.cluskey; }
+  };
+
+  //! compare pairs to their first member only, for binary searches
+  template <class T>
+  struct FirstCompare
+  {
+    template <class P>
+    bool operator()(const P& p, const T& key) const
+    {
+      return std::less<T>()(p.first, key);
+    }
+    template <class P>
+    bool operator()(const T& key, const P& p) const
+    {
+      return std::less<T>()(key, p.first);
+    }
+  };
+}  // namespace
+
+void SvtxClusterTruthTable::clear()
+{
+  m_entries.clear();
+  m_g4hit_clusters.clear();
+  m_track_clusters.clear();
+  m_built = false;
+}
+
+void SvtxClusterTruthTable::build(TrkrClusterContainer* clustermap, TrkrClusterHitAssoc* cluster_hit_map, TrkrHitTruthAssoc* hit_truth_map, const G4HitContainers& g4hits)
+{
+  clear();
+  m_built = true;
+
+  if (!clustermap || !cluster_hit_map || !hit_truth_map)
+  {
+    return;
+  }
+
+  TrkrHitTruthAssoc::MMap temp_map;
+  for (const auto& hitsetkey : clustermap->getHitSetKeys())
+  {
+    PHG4HitContainer* container = nullptr;
+    switch (TrkrDefs::getTrkrId(hitsetkey))
+    {
+    case TrkrDefs::mvtxId:
+      container = g4hits.mvtx;
+      break;
+    case TrkrDefs::inttId:
+      container = g4hits.intt;
+      break;
+    case TrkrDefs::tpcId:
+      container = g4hits.tpc;
+      break;
+    case TrkrDefs::micromegasId:
+      container = g4hits.micromegas;
+      break;
+    default:
+      break;
+    }
+    if (!container)
+    {
+      continue;
+    }
+
+    auto range = clustermap->getClusters(hitsetkey);
+    for (auto clusiter = range.first; clusiter != range.second; ++clusiter)
+    {
+      const TrkrDefs::cluskey cluskey = clusiter->first;
+      const auto hitrange = cluster_hit_map->getHits(cluskey);
+      for (auto hititer = hitrange.first; hititer != hitrange.second; ++hititer)
+      {
+        // returns pairs (hitsetkey, std::pair(hitkey, g4hitkey)) for this hitkey only
+        temp_map.clear();
+        hit_truth_map->getG4Hits(hitsetkey, hititer->second, temp_map);
+        for (const auto& htiter : temp_map)
+        {
+          PHG4Hit* g4hit = container->findHit(htiter.second.second);
+          if (g4hit)
+          {
+            m_entries.push_back({cluskey, g4hit, g4hit->get_trkid(), g4hit->get_edep()});
+          }
+        }
+      }
+    }
+  }
+
+  // a g4hit contributing to several hits of the same cluster is stored once
+  std::sort(m_entries.begin(), m_entries.end(), entry_less);
+  m_entries.erase(std::unique(m_entries.begin(), m_entries.end(), entry_equal), m_entries.end());
+  m_entries.shrink_to_fit();
+
+  m_g4hit_clusters.reserve(m_entries.size());
+  m_track_clusters.reserve(m_entries.size());
+  for (const auto& entry : m_entries)
+  {
+    m_g4hit_clusters.emplace_back(entry.g4hit, entry.cluskey);
+    m_track_clusters.emplace_back(entry.trkid, entry.cluskey);
+  }
+
+  std::sort(m_g4hit_clusters.begin(), m_g4hit_clusters.end(),
+            [](const auto& lhs, const auto& rhs)
+            { return std::less<PHG4Hit*>()(lhs.first, rhs.first) || (lhs.first == rhs.first && lhs.second < rhs.second); });
+
+  std::sort(m_track_clusters.begin(), m_track_clusters.end());
+  m_track_clusters.erase(std::unique(m_track_clusters.begin(), m_track_clusters.end()), m_track_clusters.end());
+  m_track_clusters.shrink_to_fit();
+}
+
+SvtxClusterTruthTable::EntryRange SvtxClusterTruthTable::get_entries(TrkrDefs::cluskey cluskey) const
+{
+  return std::equal_range(m_entries.begin(), m_entries.end(), cluskey, EntryKeyCompare());
+}
+
+SvtxClusterTruthTable::G4HitClusterRange SvtxClusterTruthTable::get_clusters(PHG4Hit* g4hit) const
+{
+  return std::equal_range(m_g4hit_clusters.begin(), m_g4hit_clusters.end(), g4hit, FirstCompare<PHG4Hit*>());
+}
+
+SvtxClusterTruthTable::TrackClusterRange SvtxClusterTruthTable::get_clusters(int trkid) const
+{
+  return std::equal_range(m_track_clusters.begin(), m_track_clusters.end(), trkid, FirstCompare<int>());
+}
+
+float SvtxClusterTruthTable::get_energy(TrkrDefs::cluskey cluskey, int trkid) const
+{
+  float energy = 0;
+  const auto range = get_entries(cluskey);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->trkid == trkid)
+    {
+      energy += iter->edep;
+    }
+  }
+  return energy;
+}
+
+float SvtxClusterTruthTable::get_energy(TrkrDefs::cluskey cluskey, PHG4HitDefs::keytype hitid) const
+{
+  float energy = 0;
+  const auto range = get_entries(cluskey);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->g4hit->get_hit_id() == hitid)
+    {
+      energy += iter->edep;
+    }
+  }
+  return energy;
+}
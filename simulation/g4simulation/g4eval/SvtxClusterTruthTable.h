@@ -0,0 +1,86 @@
+#ifndef G4EVAL_SVTXCLUSTERTRUTHTABLE_H
+#define G4EVAL_SVTXCLUSTERTRUTHTABLE_H
+
+#include <trackbase/TrkrDefs.h>
+
+#include <g4main/PHG4HitDefs.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class PHG4Hit;
+class PHG4HitContainer;
+class TrkrClusterContainer;
+class TrkrClusterHitAssoc;
+class TrkrHitTruthAssoc;
+
+//! flat reco cluster to truth association tables, built once per event
+//! from the cluster-hit and hit-truth association nodes.
+//! All tables are sorted vectors, queries are binary searches,
+//! so that memory grows linearly with the number of associations
+class SvtxClusterTruthTable
+{
+ public:
+  //! one (cluster, g4hit) association, with the g4hit track id and energy deposit
+  struct Entry
+  {
+    TrkrDefs::cluskey cluskey = 0;
+    PHG4Hit* g4hit = nullptr;
+    int trkid = 0;
+    float edep = 0;
+  };
+
+  using EntryList = std::vector<Entry>;
+  using EntryRange = std::pair<EntryList::const_iterator, EntryList::const_iterator>;
+
+  using G4HitClusterList = std::vector<std::pair<PHG4Hit*, TrkrDefs::cluskey>>;
+  using G4HitClusterRange = std::pair<G4HitClusterList::const_iterator, G4HitClusterList::const_iterator>;
+
+  using TrackClusterList = std::vector<std::pair<int, TrkrDefs::cluskey>>;
+  using TrackClusterRange = std::pair<TrackClusterList::const_iterator, TrackClusterList::const_iterator>;
+
+  //! g4hit containers of the tracking subsystems, missing ones can be left null
+  struct G4HitContainers
+  {
+    PHG4HitContainer* mvtx = nullptr;
+    PHG4HitContainer* intt = nullptr;
+    PHG4HitContainer* tpc = nullptr;
+    PHG4HitContainer* micromegas = nullptr;
+  };
+
+  void build(TrkrClusterContainer* clustermap, TrkrClusterHitAssoc* cluster_hit_map, TrkrHitTruthAssoc* hit_truth_map, const G4HitContainers& g4hits);
+  void clear();
+  bool is_built() const { return m_built; }
+
+  //! g4hits associated to a cluster, sorted by g4hit
+  EntryRange get_entries(TrkrDefs::cluskey cluskey) const;
+
+  //! clusters associated to a g4hit, sorted by cluster key
+  G4HitClusterRange get_clusters(PHG4Hit* g4hit) const;
+
+  //! clusters associated to a g4 track id, sorted by cluster key
+  TrackClusterRange get_clusters(int trkid) const;
+
+  //! energy deposited in a cluster by a given g4 track id
+  float get_energy(TrkrDefs::cluskey cluskey, int trkid) const;
+
+  //! energy deposited in a cluster by g4hits with a given hit id
+  float get_energy(TrkrDefs::cluskey cluskey, PHG4HitDefs::keytype hitid) const;
+
+  size_t size() const { return m_entries.size(); }
+
+ private:
+  bool m_built = false;
+
+  //! sorted by cluster key, then g4hit
+  EntryList m_entries;
+
+  //! sorted by g4hit, then cluster key
+  G4HitClusterList m_g4hit_clusters;
+
+  //! sorted by track id, then cluster key, unique
+  TrackClusterList m_track_clusters;
+};
+
+#endif  // G4EVAL_SVTXCLUSTERTRUTHTABLE_H
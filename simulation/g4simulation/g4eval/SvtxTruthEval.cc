@@ -41,12 +41,23 @@
 #include <cassert>
 #include <cmath>    // for sqrt, fabs
 #include <cstdlib>  // for abs
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <set>
 #include <utility>
 
+namespace
+{
+  //! compare (track id, g4hit) entries to a track id, for binary searches
+  struct TrkIdCompare
+  {
+    bool operator()(const std::pair<int, PHG4Hit*>& entry, int trkid) const { return entry.first < trkid; }
+    bool operator()(int trkid, const std::pair<int, PHG4Hit*>& entry) const { return trkid < entry.first; }
+  };
+}  // namespace
+
 SvtxTruthEval::SvtxTruthEval(PHCompositeNode* topNode)
   : _basetrutheval(topNode)
 {
@@ -67,7 +78,8 @@ SvtxTruthEval::~SvtxTruthEval()
 void SvtxTruthEval::next_event(PHCompositeNode* topNode)
 {
   _cache_all_truth_hits.clear();
-  _cache_all_truth_hits_g4particle.clear();
+  _truth_hits_by_trkid.clear();
+  _truth_hits_by_trkid_filled = false;
   _cache_all_truth_clusters_g4particle.clear();
   _cache_get_innermost_truth_hit.clear();
   _cache_get_outermost_truth_hit.clear();
@@ -173,94 +185,43 @@ std::set<PHG4Hit*> SvtxTruthEval::all_truth_hits(PHG4Particle* particle)
     ++_errors;
     return std::set<PHG4Hit*>();
   }
-  //  if( _cache_all_truth_hits_g4particle.count(particle)==0){
-  if (_cache_all_truth_hits_g4particle.empty())
-  {
-    FillTruthHitsFromParticleCache();
-  }
+  FillTruthHitsFromParticleCache();
 
-  if (_do_cache)
+  std::set<PHG4Hit*> truth_hits;
+  const auto range = std::equal_range(_truth_hits_by_trkid.begin(), _truth_hits_by_trkid.end(), particle->get_track_id(), TrkIdCompare());
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    std::map<PHG4Particle*, std::set<PHG4Hit*>>::iterator iter =
-        _cache_all_truth_hits_g4particle.find(particle);
-    if (iter != _cache_all_truth_hits_g4particle.end())
-    {
-      return iter->second;
-    }
+    truth_hits.insert(truth_hits.end(), iter->second);
   }
-  // return empty if we dont find anything int he cache
-
-  std::set<PHG4Hit*> truth_hits;
   return truth_hits;
 }
 
 void SvtxTruthEval::FillTruthHitsFromParticleCache()
 {
-  std::multimap<const int, PHG4Hit*> temp_clusters_from_particles;
-  // loop over all the g4hits in the cylinder layers
-  if (_g4hits_svtx)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_svtx->getHits().first;
-         g4iter != _g4hits_svtx->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
-  }
-
-  // loop over all the g4hits in the ladder layers
-  if (_g4hits_tracker)
+  if (_truth_hits_by_trkid_filled)
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_tracker->getHits().first;
-         g4iter != _g4hits_tracker->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
+    return;
   }
+  _truth_hits_by_trkid_filled = true;
 
-  // loop over all the g4hits in the maps ladder layers
-  if (_g4hits_maps)
+  // loop over all the g4hits in the cylinder, ladder, maps and micromegas layers
+  for (PHG4HitContainer* container : {_g4hits_svtx, _g4hits_tracker, _g4hits_maps, _g4hits_mms})
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_maps->getHits().first;
-         g4iter != _g4hits_maps->getHits().second;
-         ++g4iter)
+    if (!container)
     {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
+      continue;
     }
-  }
-
-  // loop over all the g4hits in the micromegas layers
-  if (_g4hits_mms)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_mms->getHits().first;
-         g4iter != _g4hits_mms->getHits().second;
+    for (PHG4HitContainer::ConstIterator g4iter = container->getHits().first;
+         g4iter != container->getHits().second;
          ++g4iter)
     {
       PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
-  }
-
-  PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second; ++iter)
-  {
-    PHG4Particle* g4particle = iter->second;
-    std::set<PHG4Hit*> truth_hits;
-    std::multimap<const int, PHG4Hit*>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle->get_track_id());
-    std::multimap<const int, PHG4Hit*>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle->get_track_id());
-    std::multimap<const int, PHG4Hit*>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
-    {
-      PHG4Hit* g4hit = cfp_iter->second;
-      truth_hits.insert(g4hit);
+      _truth_hits_by_trkid.emplace_back(g4hit->get_trkid(), g4hit);
     }
-    _cache_all_truth_hits_g4particle.insert(std::make_pair(g4particle, truth_hits));
   }
+  std::sort(_truth_hits_by_trkid.begin(), _truth_hits_by_trkid.end(),
+            [](const auto& lhs, const auto& rhs)
+            { return lhs.first < rhs.first || (lhs.first == rhs.first && std::less<PHG4Hit*>()(lhs.second, rhs.second)); });
 }
 
 std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>> SvtxTruthEval::all_truth_clusters(PHG4Particle* particle)
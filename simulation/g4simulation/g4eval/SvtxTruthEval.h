@@ -21,6 +21,7 @@ class PHParametersContainer;
 #include <map>
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 class SvtxTruthEval
@@ -67,6 +68,7 @@ class SvtxTruthEval
   unsigned int get_errors() { return _errors + _basetrutheval.get_errors(); }
 
   std::set<PHG4Hit*> get_truth_hits_from_truth_cluster(TrkrDefs::cluskey ckey);
+  //! build the flat (track id, g4hit) table for this event, if not done already
   void FillTruthHitsFromParticleCache();
 
  private:
@@ -109,7 +111,9 @@ class SvtxTruthEval
 
   bool _do_cache = true;
   std::set<PHG4Hit*> _cache_all_truth_hits;
-  std::map<PHG4Particle*, std::set<PHG4Hit*>> _cache_all_truth_hits_g4particle;
+  //! g4hits of all tracking subsystems, sorted by track id then g4hit
+  std::vector<std::pair<int, PHG4Hit*>> _truth_hits_by_trkid;
+  bool _truth_hits_by_trkid_filled = false;
   std::map<PHG4Particle*, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_all_truth_clusters_g4particle;
   std::map<PHG4Particle*, PHG4Hit*> _cache_get_innermost_truth_hit;
   std::map<PHG4Particle*, PHG4Hit*> _cache_get_outermost_truth_hit;
@@ -5,6 +5,7 @@
 
 #include "Fun4AllDstPileupInputManager.h"
 #include "Fun4AllDstPileupMerger.h"
+#include "PHG4PileupPool.h"
 
 #include <ffaobjects/RunHeader.h>
 
@@ -23,6 +24,7 @@
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 
 #include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
 
 #include <cassert>
 #include <iostream>  // for operator<<, basic_ostream, endl
@@ -38,6 +40,9 @@ Fun4AllDstPileupInputManager::Fun4AllDstPileupInputManager(const std::string &na
   gsl_rng_set(m_rng.get(), seed);
 }
 
+//_____________________________________________________________________________
+Fun4AllDstPileupInputManager::~Fun4AllDstPileupInputManager() = default;
+
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
 {
@@ -136,16 +141,36 @@ int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::run(const int nevents)
 {
-  if (nevents == 0)
+  // open pileup pool on first use
+  if (!m_pool_filename.empty() && !m_pool)
   {
-    return runOne(nevents);
+    m_pool = std::make_unique<PHG4PileupPool>();
+    if (!m_pool->open(m_pool_filename) || m_pool->size() == 0)
+    {
+      std::cout << PHWHERE << " " << Name() << ": could not use pileup pool " << m_pool_filename << std::endl;
+      m_pool.reset();
+      return -1;
+    }
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << ": using pileup pool " << m_pool_filename << " with " << m_pool->size() << " collisions" << std::endl;
+    }
   }
-  if (nevents > 1)
+
+  // with a pileup pool there are no events to skip, collisions are picked randomly
+  if (!m_pool)
   {
-    const auto result = runOne(nevents - 1);
-    if (result != 0)
+    if (nevents == 0)
+    {
+      return runOne(nevents);
+    }
+    if (nevents > 1)
     {
-      return result;
+      const auto result = runOne(nevents - 1);
+      if (result != 0)
+      {
+        return result;
+      }
     }
   }
 
@@ -181,6 +206,18 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
     const int ncollisions = gsl_ran_poisson(m_rng.get(), mu);
     for (int icollision = 0; icollision < ncollisions; ++icollision)
     {
+      if (m_pool)
+      {
+        // pick one collision from the pool and merge
+        const size_t index = gsl_rng_uniform_int(m_rng.get(), m_pool->size());
+        if (Verbosity() > 0)
+        {
+          std::cout << "Fun4AllDstPileupInputManager::run - merged pileup pool collision " << index << " time: " << crossing_time << std::endl;
+        }
+        merger.copy_background_event(*m_pool, index, crossing_time);
+        continue;
+      }
+
       // read one event
       const auto result = runOne(1);
       if (result != 0)
@@ -312,6 +349,13 @@ void Fun4AllDstPileupInputManager::Print(const std::string &what) const
     std::cout << "PHNodeIOManager print in Fun4AllDstPileupInputManager " << Name() << ":" << std::endl;
     m_IManager->print();
   }
+  if ((what == "ALL" || what == "POOL") && m_pool)
+  {
+    std::cout << "--------------------------------------" << std::endl
+              << std::endl;
+    std::cout << "Pileup pool " << m_pool_filename << " in Fun4AllDstPileupInputManager " << Name() << ": "
+              << m_pool->size() << " collisions, " << m_pool->containers().size() << " g4hit containers" << std::endl;
+  }
   Fun4AllInputManager::Print(what);
   return;
 }
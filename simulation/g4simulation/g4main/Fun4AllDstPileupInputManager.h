@@ -22,6 +22,8 @@
 #include <string>
 #include <utility>  // for pair
 
+class PHG4PileupPool;
+
 /*!
  * dedicated input manager that merges single events into "merged" events, containing a trigger event
  * and a number of time-shifted pile-up events corresponding to a given pile-up rate
@@ -30,6 +32,7 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 {
  public:
   Fun4AllDstPileupInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
+  ~Fun4AllDstPileupInputManager() override;
   int fileopen(const std::string &filenam) override;
   int fileclose() override;
   int run(const int nevents = 0) override;
@@ -66,6 +69,10 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 
   void setDetectorActiveCrossings(const std::string &name, const int min, const int max);
 
+  //! read pileup collisions from a pileup pool written by PHG4PileupPoolWriter instead of the input DSTs
+  /*! collisions are picked randomly from the pool, so that a given pool can be reused by many jobs */
+  void setPileupPool(const std::string &filename) { m_pool_filename = filename; }
+
  private:
   //! loads one event on internal DST node
   int runOne(const int nevents = 0);
@@ -122,6 +129,10 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
   std::unique_ptr<gsl_rng, Deleter> m_rng;
 
   std::map<std::string, std::pair<double, double>> m_DetectorTiming;
+
+  //! pileup pool, if used
+  std::string m_pool_filename;
+  std::unique_ptr<PHG4PileupPool> m_pool;
 };
 
 #endif /* G4MAIN_FUN4ALLDSTPILEUPINPUTMANAGER_H_ */
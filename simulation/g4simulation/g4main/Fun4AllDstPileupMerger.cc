@@ -10,6 +10,7 @@
 #include "PHG4Hitv1.h"
 #include "PHG4Particle.h"  // for PHG4Particle
 #include "PHG4Particlev3.h"
+#include "PHG4PileupPool.h"
 #include "PHG4TruthInfoContainer.h"
 #include "PHG4VtxPoint.h"  // for PHG4VtxPoint
 #include "PHG4VtxPointv1.h"
@@ -29,6 +30,8 @@
 
 #include <HepMC/GenEvent.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <limits>
@@ -371,3 +374,236 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
     }
   }
 }
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_background_event(const PHG4PileupPool &pool, size_t index, double delta_t) const
+{
+  PHG4PileupPool::CollisionView collision;
+  if (!pool.get_collision(index, collision))
+  {
+    std::cout << "Fun4AllDstPileupMerger::copy_background_event - could not read pileup pool collision " << index << std::endl;
+    return;
+  }
+
+  // HepMC records are not stored in the pool. An empty background event is still
+  // inserted, so that each collision gets its own embed id and its crossing time is kept
+  int new_embed_id = -1;
+  if (m_geneventmap)
+  {
+    auto *newevent = m_geneventmap->insert_background_event(nullptr);
+    newevent->moveVertex(0, 0, 0, delta_t);
+    new_embed_id = newevent->get_embedding_id();
+  }
+
+  // copy truth container
+  // keep track of the correspondance between source index and destination index for vertices and tracks
+  using ConversionMap = std::map<int, int>;
+  ConversionMap vtxid_map;
+  ConversionMap trkid_map;
+
+  const auto get_converted_id = [](const ConversionMap &conversion_map, int id, const std::string &what, int &value)
+  {
+    const auto keyiter = conversion_map.find(id);
+    if (keyiter != conversion_map.end())
+    {
+      value = keyiter->second;
+      return;
+    }
+    std::cout << "Fun4AllDstPileupMerger::copy_background_event - " << what << " id " << id << " not found in map" << std::endl;
+  };
+
+  const auto new_vertex = [delta_t](const PHG4PileupPool::Vertex &source)
+  { return new PHG4VtxPoint_t(source.x, source.y, source.z, source.t + delta_t); };
+
+  const auto new_particle = [&pool](const PHG4PileupPool::Particle &source)
+  {
+    auto *dest = new PHG4Particle_t;
+    dest->set_name(pool.particle_name(source.name_index));
+    dest->set_pid(source.pid);
+    dest->set_px(source.px);
+    dest->set_py(source.py);
+    dest->set_pz(source.pz);
+    dest->set_e(source.e);
+    dest->set_barcode(source.barcode);
+    dest->set_A(source.A);
+    dest->set_Z(source.Z);
+    dest->set_IonCharge(source.ioncharge);
+    dest->set_ExcitEnergy(source.excit_energy);
+    return dest;
+  };
+
+  if (m_g4truthinfo)
+  {
+    {
+      // primary vertices
+      auto key = m_g4truthinfo->maxvtxindex();
+      for (size_t i = 0; i < collision.nprimary_vertices; ++i)
+      {
+        const auto &source = collision.vertices[i];
+        m_g4truthinfo->AddVertex(++key, new_vertex(source));
+        vtxid_map.insert(std::make_pair(source.id, key));
+      }
+    }
+
+    {
+      // secondary vertices, from last to first to preserve order with respect to the original event
+      auto key = m_g4truthinfo->minvtxindex();
+      const auto *first = collision.vertices + collision.nprimary_vertices;
+      for (size_t i = collision.nsecondary_vertices; i > 0; --i)
+      {
+        const auto &source = first[i - 1];
+        m_g4truthinfo->AddVertex(--key, new_vertex(source));
+        vtxid_map.insert(std::make_pair(source.id, key));
+      }
+    }
+
+    {
+      // primary particles
+      auto key = m_g4truthinfo->maxtrkindex();
+      for (size_t i = 0; i < collision.nprimary_particles; ++i)
+      {
+        const auto &source = collision.particles[i];
+        auto *dest = new_particle(source);
+        m_g4truthinfo->AddParticle(++key, dest);
+        dest->set_track_id(key);
+        dest->set_parent_id(0);
+        dest->set_primary_id(dest->get_track_id());
+
+        int vtx_id = source.vtx_id;
+        get_converted_id(vtxid_map, source.vtx_id, "vertex", vtx_id);
+        dest->set_vtx_id(vtx_id);
+
+        trkid_map.insert(std::make_pair(source.track_id, dest->get_track_id()));
+      }
+    }
+
+    {
+      // secondary particles, from last to first, so that parents are converted before their daughters
+      auto key = m_g4truthinfo->mintrkindex();
+      const auto *first = collision.particles + collision.nprimary_particles;
+      for (size_t i = collision.nsecondary_particles; i > 0; --i)
+      {
+        const auto &source = first[i - 1];
+        auto *dest = new_particle(source);
+        m_g4truthinfo->AddParticle(--key, dest);
+        dest->set_track_id(key);
+
+        int id = source.parent_id;
+        get_converted_id(trkid_map, source.parent_id, "track", id);
+        dest->set_parent_id(id);
+
+        id = source.primary_id;
+        get_converted_id(trkid_map, source.primary_id, "track", id);
+        dest->set_primary_id(id);
+
+        id = source.vtx_id;
+        get_converted_id(vtxid_map, source.vtx_id, "vertex", id);
+        dest->set_vtx_id(id);
+
+        trkid_map.insert(std::make_pair(source.track_id, dest->get_track_id()));
+      }
+    }
+
+    // embed flags, for primary vertices and tracks only
+    for (const auto &pair : vtxid_map)
+    {
+      if (pair.first > 0)
+      {
+        m_g4truthinfo->AddEmbededVtxId(pair.second, new_embed_id);
+      }
+    }
+    for (const auto &pair : trkid_map)
+    {
+      if (pair.first > 0)
+      {
+        m_g4truthinfo->AddEmbededTrkId(pair.second, new_embed_id);
+      }
+    }
+  }
+
+  // copy g4hits
+  const auto &names = pool.containers();
+  for (const auto &pair : m_g4hitscontainers)
+  {
+    if (!pair.second)
+    {
+      std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid destination container " << pair.first << std::endl;
+      continue;
+    }
+
+    const auto nameiter = std::find(names.begin(), names.end(), pair.first);
+    if (nameiter == names.end())
+    {
+      std::cout << "Fun4AllDstPileupMerger::copy_background_event - container " << pair.first << " not found in pileup pool" << std::endl;
+      continue;
+    }
+
+    auto detiter = m_DetectorTiming.find(pair.first);
+    // apply special  cuts for selected detectors
+    if (detiter != m_DetectorTiming.end())
+    {
+      if (delta_t < detiter->second.first || delta_t > detiter->second.second)
+      {
+        continue;
+      }
+    }
+
+    const auto &container = collision.containers[std::distance(names.begin(), nameiter)];
+    const auto *prop = container.props;
+    for (size_t i = 0; i < container.nhits; ++i)
+    {
+      const auto &source = container.hits[i];
+      auto *newHit = new PHG4Hit_t;
+      for (int j = 0; j < 2; ++j)
+      {
+        newHit->set_x(j, source.x[j]);
+        newHit->set_y(j, source.y[j]);
+        newHit->set_z(j, source.z[j]);
+        newHit->set_t(j, source.t[j] + delta_t);
+      }
+      newHit->set_edep(source.edep);
+
+      int trkid = source.trkid;
+      get_converted_id(trkid_map, source.trkid, "track", trkid);
+      newHit->set_trkid(trkid);
+
+      // showers from the background events are not copied, reset the hits shower id
+      newHit->set_shower_id(std::numeric_limits<int>::min());
+
+      for (const auto *prop_end = prop + source.nprops; prop != prop_end; ++prop)
+      {
+        const auto prop_id = static_cast<PHG4Hit::PROPERTY>(prop->id);
+        switch (PHG4Hit::get_property_info(prop_id).second)
+        {
+        case PHG4Hit::type_float:
+        {
+          float value;
+          std::memcpy(&value, &prop->value, sizeof(value));
+          newHit->set_property(prop_id, value);
+          break;
+        }
+        case PHG4Hit::type_int:
+        {
+          int value;
+          std::memcpy(&value, &prop->value, sizeof(value));
+          newHit->set_property(prop_id, value);
+          break;
+        }
+        case PHG4Hit::type_uint:
+          newHit->set_property(prop_id, static_cast<unsigned int>(prop->value));
+          break;
+        default:
+          break;
+        }
+      }
+
+      // generate a new key for the hit, so that there is no conflict with the hits from the 'main' event
+      pair.second->AddHit(source.detid, newHit);
+    }
+
+    for (size_t i = 0; i < container.nlayers; ++i)
+    {
+      pair.second->AddLayer(container.layers[i]);
+    }
+  }
+}
@@ -8,12 +8,14 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <utility>  // for pair
 
 class PHCompositeNode;
 class PHG4HitContainer;
+class PHG4PileupPool;
 class PHG4TruthInfoContainer;
 class PHHepMCGenEventMap;
 
@@ -37,6 +39,9 @@ class Fun4AllDstPileupMerger final
   //! time-shift and copy content of source nodes to destination
   void copy_background_event(PHCompositeNode *, double delta_t) const;
 
+  //! time-shift and copy collision from pileup pool to destination
+  void copy_background_event(const PHG4PileupPool &, size_t index, double delta_t) const;
+
   void copyDetectorActiveCrossings(const std::map<std::string, std::pair<double, double>> &dmap) { m_DetectorTiming = dmap; }
 
  private:
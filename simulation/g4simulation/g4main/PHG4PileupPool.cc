@@ -0,0 +1,222 @@
+#include "PHG4PileupPool.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+
+//_____________________________________________________________________________
+PHG4PileupPool::~PHG4PileupPool()
+{
+  close();
+}
+
+//_____________________________________________________________________________
+bool PHG4PileupPool::open(const std::string &filename)
+{
+  close();
+
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "PHG4PileupPool::open - could not open " << filename << std::endl;
+    return false;
+  }
+  struct stat st
+  {
+  };
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader))
+  {
+    std::cout << "PHG4PileupPool::open - invalid file " << filename << std::endl;
+    ::close(fd);
+    return false;
+  }
+  void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    std::cout << "PHG4PileupPool::open - could not map " << filename << std::endl;
+    return false;
+  }
+  m_data = static_cast<const char *>(mapped);
+  m_size = st.st_size;
+
+  // check header
+  FileHeader header;
+  const FileHeader reference;
+  std::memcpy(&header, m_data, sizeof(FileHeader));
+  if (std::memcmp(header.magic, reference.magic, sizeof(header.magic)) != 0 ||
+      header.version != format_version ||
+      header.index_offset % sizeof(uint64_t) != 0 ||
+      header.index_offset > m_size ||
+      header.ncollisions > (m_size - header.index_offset) / sizeof(uint64_t) ||
+      header.names_offset < sizeof(FileHeader) ||
+      header.names_offset > m_size ||
+      header.names_size > m_size - header.names_offset)
+  {
+    std::cout << "PHG4PileupPool::open - " << filename << " is not a valid pileup pool (version " << format_version << ")" << std::endl;
+    close();
+    return false;
+  }
+
+  m_ncollisions = header.ncollisions;
+  m_index = reinterpret_cast<const uint64_t *>(m_data + header.index_offset);
+  m_blocks_end = header.names_offset;
+
+  // names
+  const char *name = m_data + header.names_offset;
+  const char *names_end = name + header.names_size;
+  const size_t nnames = header.ncontainers + header.nparticle_names;
+  for (size_t i = 0; i < nnames && name < names_end; ++i)
+  {
+    const std::string value(name, strnlen(name, names_end - name));
+    if (i < header.ncontainers)
+    {
+      m_containers.push_back(value);
+    }
+    else
+    {
+      m_particle_names.push_back(value);
+    }
+    name += value.size() + 1;
+  }
+  if (m_containers.size() != header.ncontainers || m_particle_names.size() != header.nparticle_names)
+  {
+    std::cout << "PHG4PileupPool::open - " << filename << " has truncated names" << std::endl;
+    close();
+    return false;
+  }
+
+  // make sure all collision blocks are inside the file, so that truncated or corrupted files are rejected here
+  for (size_t index = 0; index < m_ncollisions; ++index)
+  {
+    if (!check_block(index))
+    {
+      std::cout << "PHG4PileupPool::open - " << filename << " collision " << index << " is corrupted" << std::endl;
+      close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________________
+void PHG4PileupPool::close()
+{
+  if (m_data)
+  {
+    munmap(const_cast<char *>(m_data), m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_ncollisions = 0;
+  m_index = nullptr;
+  m_blocks_end = 0;
+  m_containers.clear();
+  m_particle_names.clear();
+}
+
+//_____________________________________________________________________________
+bool PHG4PileupPool::check_block(size_t index) const
+{
+  // blocks are 8 bytes aligned, between the file header and the names
+  const uint64_t offset = m_index[index];
+  if (offset < sizeof(FileHeader) || offset >= m_blocks_end || offset % sizeof(uint64_t) != 0)
+  {
+    return false;
+  }
+
+  uint64_t remaining = m_blocks_end - offset;
+  const auto consume = [&remaining](uint64_t n, uint64_t size)
+  {
+    if (n > remaining / size)
+    {
+      return false;
+    }
+    remaining -= n * size;
+    return true;
+  };
+
+  if (!consume(1, sizeof(CollisionHeader)) || !consume(m_containers.size(), sizeof(ContainerHeader)))
+  {
+    return false;
+  }
+  const auto *header = reinterpret_cast<const CollisionHeader *>(m_data + offset);
+  const auto *container_headers = reinterpret_cast<const ContainerHeader *>(m_data + offset + sizeof(CollisionHeader));
+  if (!consume(static_cast<uint64_t>(header->nprimary_vertices) + header->nsecondary_vertices, sizeof(Vertex)) ||
+      !consume(static_cast<uint64_t>(header->nprimary_particles) + header->nsecondary_particles, sizeof(Particle)))
+  {
+    return false;
+  }
+  for (size_t i = 0; i < m_containers.size(); ++i)
+  {
+    if (!consume(container_headers[i].nhits, sizeof(Hit)) ||
+        !consume(container_headers[i].nprops, sizeof(Property)) ||
+        !consume(container_headers[i].nlayers, sizeof(uint32_t)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//_____________________________________________________________________________
+bool PHG4PileupPool::get_collision(size_t index, CollisionView &view) const
+{
+  if (index >= m_ncollisions)
+  {
+    std::cout << "PHG4PileupPool::get_collision - invalid index " << index << " (" << m_ncollisions << " collisions)" << std::endl;
+    return false;
+  }
+
+  const char *block = m_data + m_index[index];
+  const auto *header = reinterpret_cast<const CollisionHeader *>(block);
+  block += sizeof(CollisionHeader);
+
+  const auto *container_headers = reinterpret_cast<const ContainerHeader *>(block);
+  block += m_containers.size() * sizeof(ContainerHeader);
+
+  view.vertices = reinterpret_cast<const Vertex *>(block);
+  view.nprimary_vertices = header->nprimary_vertices;
+  view.nsecondary_vertices = header->nsecondary_vertices;
+  block += (view.nprimary_vertices + view.nsecondary_vertices) * sizeof(Vertex);
+
+  view.particles = reinterpret_cast<const Particle *>(block);
+  view.nprimary_particles = header->nprimary_particles;
+  view.nsecondary_particles = header->nsecondary_particles;
+  block += (view.nprimary_particles + view.nsecondary_particles) * sizeof(Particle);
+
+  view.containers.resize(m_containers.size());
+  for (size_t i = 0; i < m_containers.size(); ++i)
+  {
+    auto &container = view.containers[i];
+    container.hits = reinterpret_cast<const Hit *>(block);
+    container.nhits = container_headers[i].nhits;
+    block += container.nhits * sizeof(Hit);
+
+    container.props = reinterpret_cast<const Property *>(block);
+    container.nprops = container_headers[i].nprops;
+    block += container.nprops * sizeof(Property);
+
+    container.layers = reinterpret_cast<const uint32_t *>(block);
+    container.nlayers = container_headers[i].nlayers;
+    block += container.nlayers * sizeof(uint32_t);
+
+    // hits properties are read sequentially, they must add up to the container properties
+    uint64_t nprops = 0;
+    for (size_t ihit = 0; ihit < container.nhits; ++ihit)
+    {
+      nprops += container.hits[ihit].nprops;
+    }
+    if (nprops != container.nprops)
+    {
+      std::cout << "PHG4PileupPool::get_collision - inconsistent hit properties in collision " << index << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
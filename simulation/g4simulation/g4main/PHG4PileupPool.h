@@ -0,0 +1,182 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4PILEUPPOOL_H
+#define G4MAIN_PHG4PILEUPPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * read-only, memory mapped pool of pre-digested pileup collisions.
+ * The pool is written from background DSTs by PHG4PileupPoolWriter and used by
+ * Fun4AllDstPileupInputManager::setPileupPool in place of reading the DSTs event by event.
+ *
+ * Each collision is stored as a block of flat arrays: truth vertices and particles,
+ * then for each g4hit container its hits, their properties and the layers.
+ * An index at the end of the file gives random access by collision index.
+ */
+class PHG4PileupPool
+{
+ public:
+  //!@name file format
+  //@{
+  static constexpr uint32_t format_version = 1;
+
+  struct FileHeader
+  {
+    char magic[8] = {'P', 'H', 'G', '4', 'P', 'O', 'O', 'L'};
+    uint32_t version = format_version;
+    uint32_t ncontainers = 0;
+    uint64_t ncollisions = 0;
+
+    //! offset of the collision index, one uint64_t block offset per collision
+    uint64_t index_offset = 0;
+
+    //! offset and size of null terminated names: g4hit containers first, then particle names
+    uint64_t names_offset = 0;
+    uint64_t names_size = 0;
+    uint32_t nparticle_names = 0;
+    uint32_t reserved = 0;
+  };
+
+  //! start of each collision block, followed by one ContainerHeader per container
+  struct CollisionHeader
+  {
+    uint32_t nprimary_vertices = 0;
+    uint32_t nsecondary_vertices = 0;
+    uint32_t nprimary_particles = 0;
+    uint32_t nsecondary_particles = 0;
+  };
+
+  struct ContainerHeader
+  {
+    uint32_t nhits = 0;
+    uint32_t nprops = 0;
+    uint32_t nlayers = 0;
+    uint32_t reserved = 0;
+  };
+
+  struct Vertex
+  {
+    double x = 0;
+    double y = 0;
+    double z = 0;
+    double t = 0;
+    int32_t id = 0;
+    int32_t reserved = 0;
+  };
+
+  struct Particle
+  {
+    double px = 0;
+    double py = 0;
+    double pz = 0;
+    double e = 0;
+    double ioncharge = 0;
+    double excit_energy = 0;
+    int32_t track_id = 0;
+    int32_t vtx_id = 0;
+    int32_t parent_id = 0;
+    int32_t primary_id = 0;
+    int32_t pid = 0;
+    int32_t barcode = 0;
+    int32_t A = 0;
+    int32_t Z = 0;
+    uint32_t name_index = 0;
+    uint32_t reserved = 0;
+  };
+
+  //! g4hit, its nprops properties follow those of the previous hits in the property array
+  struct Hit
+  {
+    float x[2] = {0, 0};
+    float y[2] = {0, 0};
+    float z[2] = {0, 0};
+    float t[2] = {0, 0};
+    float edep = 0;
+    int32_t trkid = 0;
+    int32_t showerid = 0;
+    int32_t detid = 0;
+    uint32_t nprops = 0;
+    uint32_t reserved = 0;
+  };
+
+  //! g4hit property, value is the raw 32 bit storage of the int, uint or float property
+  struct Property
+  {
+    uint32_t id = 0;
+    uint32_t value = 0;
+  };
+  //@}
+
+  //! one g4hit container in a collision
+  struct ContainerView
+  {
+    const Hit *hits = nullptr;
+    size_t nhits = 0;
+    const Property *props = nullptr;
+    size_t nprops = 0;
+    const uint32_t *layers = nullptr;
+    size_t nlayers = 0;
+  };
+
+  //! one collision, pointing into the mapped file
+  struct CollisionView
+  {
+    //! primary vertices, followed by secondary vertices, each in the source container order
+    const Vertex *vertices = nullptr;
+    size_t nprimary_vertices = 0;
+    size_t nsecondary_vertices = 0;
+
+    //! primary particles, followed by secondary particles, each in the source container order
+    const Particle *particles = nullptr;
+    size_t nprimary_particles = 0;
+    size_t nsecondary_particles = 0;
+
+    //! one entry per container, in the order of containers()
+    std::vector<ContainerView> containers;
+  };
+
+  PHG4PileupPool() = default;
+  ~PHG4PileupPool();
+
+  PHG4PileupPool(const PHG4PileupPool &) = delete;
+  PHG4PileupPool &operator=(const PHG4PileupPool &) = delete;
+
+  //! map pool file, returns false on failure or if the file content is inconsistent
+  bool open(const std::string &filename);
+  void close();
+  bool is_open() const { return m_data != nullptr; }
+
+  //! number of collisions
+  size_t size() const { return m_ncollisions; }
+
+  //! g4hit container node names
+  const std::vector<std::string> &containers() const { return m_containers; }
+
+  //! particle name from index
+  const std::string &particle_name(uint32_t index) const { return m_particle_names.at(index); }
+
+  //! fill view of a given collision, returns false if index is out of range or the collision is corrupted
+  bool get_collision(size_t index, CollisionView &) const;
+
+ private:
+  //! check that the collision block fits in the file
+  bool check_block(size_t index) const;
+
+  const char *m_data = nullptr;
+  size_t m_size = 0;
+
+  size_t m_ncollisions = 0;
+  const uint64_t *m_index = nullptr;
+
+  //! collision blocks are between the file header and this offset
+  uint64_t m_blocks_end = 0;
+
+  std::vector<std::string> m_containers;
+  std::vector<std::string> m_particle_names;
+};
+
+#endif
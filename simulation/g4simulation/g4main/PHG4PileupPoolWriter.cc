@@ -0,0 +1,326 @@
+#include "PHG4PileupPoolWriter.h"
+
+#include "PHG4Hit.h"
+#include "PHG4HitContainer.h"
+#include "PHG4Particle.h"
+#include "PHG4PileupPool.h"
+#include "PHG4TruthInfoContainer.h"
+#include "PHG4VtxPoint.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHNodeOperation.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <TObject.h>
+
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+  //! utility class to find all PHG4Hit container node names
+  class FindG4HitContainerNames : public PHNodeOperation
+  {
+   public:
+    const std::vector<std::string> &names() const { return m_names; }
+
+   protected:
+    void perform(PHNode *node) override
+    {
+      if (node->getType() != "PHIODataNode")
+      {
+        return;
+      }
+      auto *ionode = static_cast<PHIODataNode<TObject> *>(node);
+      if (dynamic_cast<PHG4HitContainer *>(ionode->getData()))
+      {
+        m_names.push_back(node->getName());
+      }
+    }
+
+   private:
+    std::vector<std::string> m_names;
+  };
+
+  //! append POD to buffer
+  template <class T>
+  void append(std::vector<char> &buffer, const T &value)
+  {
+    const auto offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+  }
+
+  //! overwrite POD in buffer at given offset
+  template <class T>
+  void write_at(std::vector<char> &buffer, size_t offset, const T &value)
+  {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+  }
+
+  //! raw 32 bit storage of a g4hit property
+  bool get_property(const PHG4Hit *hit, PHG4Hit::PROPERTY prop_id, uint32_t &value)
+  {
+    switch (PHG4Hit::get_property_info(prop_id).second)
+    {
+    case PHG4Hit::type_float:
+    {
+      const float fvalue = hit->get_property_float(prop_id);
+      std::memcpy(&value, &fvalue, sizeof(value));
+      return true;
+    }
+    case PHG4Hit::type_int:
+    {
+      const int ivalue = hit->get_property_int(prop_id);
+      std::memcpy(&value, &ivalue, sizeof(value));
+      return true;
+    }
+    case PHG4Hit::type_uint:
+      value = hit->get_property_uint(prop_id);
+      return true;
+    default:
+      return false;
+    }
+  }
+}  // namespace
+
+//_____________________________________________________________________________
+PHG4PileupPoolWriter::PHG4PileupPoolWriter(const std::string &name, const std::string &filename)
+  : SubsysReco(name)
+  , m_filename(filename)
+{
+}
+
+//_____________________________________________________________________________
+int PHG4PileupPoolWriter::Init(PHCompositeNode * /*topNode*/)
+{
+  m_out.open(m_filename, std::ios::binary | std::ios::trunc);
+  if (!m_out)
+  {
+    std::cout << PHWHERE << " could not open " << m_filename << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // placeholder, rewritten in End
+  const PHG4PileupPool::FileHeader header;
+  m_out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_____________________________________________________________________________
+int PHG4PileupPoolWriter::process_event(PHCompositeNode *topNode)
+{
+  if (!m_containers_set)
+  {
+    PHNodeIterator iter(topNode);
+    auto *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    FindG4HitContainerNames nodeFinder;
+    PHNodeIterator(dstNode ? dstNode : topNode).forEach(nodeFinder);
+    m_containers = nodeFinder.names();
+    m_containers_set = true;
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4PileupPoolWriter::process_event - storing " << m_containers.size() << " g4hit containers" << std::endl;
+    }
+  }
+
+  m_buffer.clear();
+
+  // collision and container headers are filled once the counts are known
+  PHG4PileupPool::CollisionHeader header;
+  append(m_buffer, header);
+  const size_t container_header_offset = m_buffer.size();
+  m_buffer.resize(m_buffer.size() + m_containers.size() * sizeof(PHG4PileupPool::ContainerHeader));
+
+  auto *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+  if (truthinfo)
+  {
+    const auto append_vertex = [this](const PHG4VtxPoint *source)
+    {
+      PHG4PileupPool::Vertex vertex;
+      vertex.x = source->get_x();
+      vertex.y = source->get_y();
+      vertex.z = source->get_z();
+      vertex.t = source->get_t();
+      vertex.id = source->get_id();
+      append(m_buffer, vertex);
+    };
+
+    const auto append_particle = [this](const PHG4Particle *source)
+    {
+      PHG4PileupPool::Particle particle;
+      particle.px = source->get_px();
+      particle.py = source->get_py();
+      particle.pz = source->get_pz();
+      particle.e = source->get_e();
+      particle.ioncharge = source->get_IonCharge();
+      particle.excit_energy = source->get_ExcitEnergy();
+      particle.track_id = source->get_track_id();
+      particle.vtx_id = source->get_vtx_id();
+      particle.parent_id = source->get_parent_id();
+      particle.primary_id = source->get_primary_id();
+      particle.pid = source->get_pid();
+      particle.barcode = source->get_barcode();
+      particle.A = source->get_A();
+      particle.Z = source->get_Z();
+      particle.name_index = get_name_index(source->get_name());
+      append(m_buffer, particle);
+    };
+
+    auto range = truthinfo->GetPrimaryVtxRange();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      append_vertex(iter->second);
+      ++header.nprimary_vertices;
+    }
+    range = truthinfo->GetSecondaryVtxRange();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      append_vertex(iter->second);
+      ++header.nsecondary_vertices;
+    }
+
+    auto prange = truthinfo->GetPrimaryParticleRange();
+    for (auto iter = prange.first; iter != prange.second; ++iter)
+    {
+      append_particle(iter->second);
+      ++header.nprimary_particles;
+    }
+    prange = truthinfo->GetSecondaryParticleRange();
+    for (auto iter = prange.first; iter != prange.second; ++iter)
+    {
+      append_particle(iter->second);
+      ++header.nsecondary_particles;
+    }
+  }
+  write_at(m_buffer, 0, header);
+
+  std::vector<PHG4PileupPool::Property> props;
+  for (size_t icontainer = 0; icontainer < m_containers.size(); ++icontainer)
+  {
+    PHG4PileupPool::ContainerHeader container_header;
+    auto *container = findNode::getClass<PHG4HitContainer>(topNode, m_containers[icontainer]);
+    if (container)
+    {
+      props.clear();
+      const auto range = container->getHits();
+      for (auto iter = range.first; iter != range.second; ++iter)
+      {
+        const auto *source = iter->second;
+        PHG4PileupPool::Hit hit;
+        for (int i = 0; i < 2; ++i)
+        {
+          hit.x[i] = source->get_x(i);
+          hit.y[i] = source->get_y(i);
+          hit.z[i] = source->get_z(i);
+          hit.t[i] = source->get_t(i);
+        }
+        hit.edep = source->get_edep();
+        hit.trkid = source->get_trkid();
+        hit.showerid = source->get_shower_id();
+        hit.detid = source->get_detid();
+
+        // generic copy of all properties, consistently with PHG4Hit::CopyFrom
+        for (unsigned char ic = 0; ic < std::numeric_limits<unsigned char>::max(); ic++)
+        {
+          const auto prop_id = static_cast<PHG4Hit::PROPERTY>(ic);
+          uint32_t value = 0;
+          if (source->has_property(prop_id) && get_property(source, prop_id, value))
+          {
+            props.push_back({ic, value});
+            ++hit.nprops;
+          }
+        }
+        append(m_buffer, hit);
+        ++container_header.nhits;
+      }
+
+      for (const auto &prop : props)
+      {
+        append(m_buffer, prop);
+      }
+      container_header.nprops = props.size();
+
+      const auto layers = container->getLayers();
+      for (auto iter = layers.first; iter != layers.second; ++iter)
+      {
+        append(m_buffer, static_cast<uint32_t>(*iter));
+        ++container_header.nlayers;
+      }
+    }
+    write_at(m_buffer, container_header_offset + icontainer * sizeof(PHG4PileupPool::ContainerHeader), container_header);
+  }
+
+  // keep blocks 8 bytes aligned
+  m_buffer.resize((m_buffer.size() + 7) & ~size_t(7), 0);
+
+  m_index.push_back(m_out.tellp());
+  m_out.write(m_buffer.data(), m_buffer.size());
+  if (!m_out)
+  {
+    std::cout << PHWHERE << " error writing " << m_filename << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_____________________________________________________________________________
+int PHG4PileupPoolWriter::End(PHCompositeNode * /*topNode*/)
+{
+  if (!m_out.is_open())
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  PHG4PileupPool::FileHeader header;
+  header.ncontainers = m_containers.size();
+  header.ncollisions = m_index.size();
+  header.nparticle_names = m_particle_names.size();
+
+  // names
+  header.names_offset = m_out.tellp();
+  for (const auto &name : m_containers)
+  {
+    m_out.write(name.c_str(), name.size() + 1);
+  }
+  for (const auto &name : m_particle_names)
+  {
+    m_out.write(name.c_str(), name.size() + 1);
+  }
+  header.names_size = static_cast<uint64_t>(m_out.tellp()) - header.names_offset;
+
+  // index, 8 bytes aligned
+  const char padding[8] = {};
+  m_out.write(padding, (8 - header.names_size % 8) % 8);
+  header.index_offset = m_out.tellp();
+  m_out.write(reinterpret_cast<const char *>(m_index.data()), m_index.size() * sizeof(uint64_t));
+
+  m_out.seekp(0);
+  m_out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  m_out.close();
+
+  std::cout << "PHG4PileupPoolWriter::End - wrote " << header.ncollisions << " collisions to " << m_filename << std::endl;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_____________________________________________________________________________
+uint32_t PHG4PileupPoolWriter::get_name_index(const std::string &name)
+{
+  const auto iter = m_name_index.find(name);
+  if (iter != m_name_index.end())
+  {
+    return iter->second;
+  }
+  const uint32_t index = m_particle_names.size();
+  m_name_index.emplace(name, index);
+  m_particle_names.push_back(name);
+  return index;
+}
@@ -0,0 +1,55 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4PILEUPPOOLWRITER_H
+#define G4MAIN_PHG4PILEUPPOOLWRITER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+
+/*!
+ * writes the truth information and g4hits of each event from the DST node
+ * into a pileup pool (see PHG4PileupPool), one collision per event.
+ * Run it over background DSTs read with Fun4AllDstInputManager,
+ * the pool can then be used with Fun4AllDstPileupInputManager::setPileupPool.
+ * HepMC records are not stored in the pool.
+ */
+class PHG4PileupPoolWriter : public SubsysReco
+{
+ public:
+  PHG4PileupPoolWriter(const std::string &name = "PHG4PileupPoolWriter", const std::string &filename = "pileup_pool.bin");
+
+  int Init(PHCompositeNode *) override;
+  int process_event(PHCompositeNode *) override;
+  int End(PHCompositeNode *) override;
+
+  void set_filename(const std::string &filename) { m_filename = filename; }
+
+ private:
+  uint32_t get_name_index(const std::string &);
+
+  std::string m_filename;
+  std::ofstream m_out;
+
+  //! g4hit container names, from the first event
+  std::vector<std::string> m_containers;
+  bool m_containers_set = false;
+
+  //! particle names and their index
+  std::map<std::string, uint32_t> m_name_index;
+  std::vector<std::string> m_particle_names;
+
+  //! collision block offsets
+  std::vector<uint64_t> m_index;
+
+  //! collision block buffer, reused from event to event
+  std::vector<char> m_buffer;
+};
+
+#endif
@@ -107,6 +107,9 @@ class PHG4Showerv1 : public PHG4Shower
   const HitIdMap& g4hit_ids() const override { return _g4hit_ids; }
 
  private:
+  //! compact I/O streams the shower content directly
+  friend class PHG4TruthInfoContainer;
+
   unsigned int covar_index(unsigned int i, unsigned int j) const;
 
   int _id{std::numeric_limits<int>::min()};  //< unique identifier within container
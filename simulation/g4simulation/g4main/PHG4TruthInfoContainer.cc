@@ -1,14 +1,138 @@
 #include "PHG4TruthInfoContainer.h"
 
 #include "PHG4Particle.h"
+#include "PHG4Particlev1.h"
+#include "PHG4Particlev2.h"
+#include "PHG4Particlev3.h"
 #include "PHG4Shower.h"
+#include "PHG4Showerv1.h"
 #include "PHG4VtxPoint.h"
+#include "PHG4VtxPointv1.h"
+#include "PHG4VtxPointv2.h"
+
+#include <TBuffer.h>
 
 #include <algorithm>
 #include <boost/tuple/tuple.hpp>
 
 #include <limits>
 #include <string>
+#include <set>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+  // stride of the compact arrays
+  constexpr size_t particle_nints = 8;
+  constexpr size_t particle_ndoubles = 4;
+  constexpr size_t vtx_nints = 4;
+  constexpr size_t vtx_ndoubles = 4;
+
+  //! compact storage class version of a particle, 0 if not supported
+  int particle_class(const PHG4Particle* particle)
+  {
+    const auto& type = typeid(*particle);
+    if (type == typeid(PHG4Particlev3))
+    {
+      return 3;
+    }
+    if (type == typeid(PHG4Particlev2))
+    {
+      return 2;
+    }
+    if (type == typeid(PHG4Particlev1))
+    {
+      return 1;
+    }
+    return 0;
+  }
+
+  //! compact storage class version of a vertex, 0 if not supported
+  int vtx_class(const PHG4VtxPoint* vtx)
+  {
+    const auto& type = typeid(*vtx);
+    if (type == typeid(PHG4VtxPointv2))
+    {
+      return 2;
+    }
+    if (type == typeid(PHG4VtxPointv1))
+    {
+      return 1;
+    }
+    return 0;
+  }
+
+  //! true if a shower is supported by the compact storage
+  bool shower_supported(const PHG4Shower* shower)
+  {
+    return typeid(*shower) == typeid(PHG4Showerv1);
+  }
+
+  //! append the size of a map or set, followed by its keys
+  template <typename T>
+  void pack_keys(std::vector<int>& ints, const T& container)
+  {
+    ints.push_back(container.size());
+    for (const auto& entry : container)
+    {
+      if constexpr (std::is_same_v<T, std::set<int>>)
+      {
+        ints.push_back(entry);
+      }
+      else
+      {
+        ints.push_back(entry.first);
+      }
+    }
+  }
+
+  //! sequential reader of a compact array
+  /*! reading past the end returns default values and invalidates the reader */
+  template <typename T>
+  class compact_reader
+  {
+   public:
+    explicit compact_reader(const std::vector<T>& data)
+      : m_data(data)
+    {
+    }
+
+    T next()
+    {
+      if (m_pos < m_data.size())
+      {
+        return m_data[m_pos++];
+      }
+      m_valid = false;
+      return T{};
+    }
+
+    //! read a number of entries, which must not exceed the size left in the array
+    size_t next_size(size_t available)
+    {
+      const auto size = next();
+      if (size < 0 || static_cast<size_t>(size) > available)
+      {
+        m_valid = false;
+        return 0;
+      }
+      return size;
+    }
+    size_t next_size() { return next_size(remaining()); }
+
+    size_t remaining() const { return m_data.size() - m_pos; }
+    bool valid() const { return m_valid; }
+    bool at_end() const { return m_pos == m_data.size(); }
+
+   private:
+    const std::vector<T>& m_data;
+    size_t m_pos = 0;
+    bool m_valid = true;
+  };
+}  // namespace
 
 PHG4TruthInfoContainer::~PHG4TruthInfoContainer() { Reset(); }
 
@@ -41,6 +165,8 @@ void PHG4TruthInfoContainer::Reset()
   particle_embed_flags.clear();
   vertex_embed_flags.clear();
 
+  clear_compact();
+
   return;
 }
 
@@ -484,3 +610,322 @@ bool operator==(const PHG4TruthInfoContainer::ShowerMap::value_type& lhs, const
 {
   return *lhs.second == *rhs.second;
 }
+
+void PHG4TruthInfoContainer::Streamer(TBuffer& R__b)
+{
+  if (R__b.IsReading())
+  {
+    R__b.ReadClassBuffer(PHG4TruthInfoContainer::Class(), this);
+    unpack_compact();
+  }
+  else if (m_compact_io && pack_compact())
+  {
+    // particles, vertices and showers are stored in the compact arrays, write empty maps instead
+    Map particles;
+    VtxMap vertices;
+    ShowerMap showers;
+    std::swap(particles, particlemap);
+    std::swap(vertices, vtxmap);
+    std::swap(showers, showermap);
+    R__b.WriteClassBuffer(PHG4TruthInfoContainer::Class(), this);
+    std::swap(particles, particlemap);
+    std::swap(vertices, vtxmap);
+    std::swap(showers, showermap);
+    clear_compact();
+  }
+  else
+  {
+    R__b.WriteClassBuffer(PHG4TruthInfoContainer::Class(), this);
+  }
+}
+
+bool PHG4TruthInfoContainer::pack_compact()
+{
+  clear_compact();
+
+  // check that all objects are supported first
+  for (const auto& [key, particle] : particlemap)
+  {
+    if (!particle_class(particle))
+    {
+      return false;
+    }
+  }
+  for (const auto& [key, vtx] : vtxmap)
+  {
+    if (!vtx_class(vtx))
+    {
+      return false;
+    }
+  }
+  for (const auto& [key, shower] : showermap)
+  {
+    if (!shower_supported(shower))
+    {
+      return false;
+    }
+  }
+
+  compact_particle_ints.reserve(particlemap.size() * particle_nints);
+  compact_particle_doubles.reserve(particlemap.size() * particle_ndoubles);
+  compact_particle_name_index.reserve(particlemap.size());
+
+  std::unordered_map<std::string, int> name_index;
+  for (const auto& [key, particle] : particlemap)
+  {
+    const int particle_version = particle_class(particle);
+    compact_particle_ints.insert(compact_particle_ints.end(),
+                                 {key, particle_version, particle->get_pid(),
+                                  particle->get_track_id(), particle->get_vtx_id(), particle->get_parent_id(), particle->get_primary_id(),
+                                  particle->get_barcode()});
+    compact_particle_doubles.insert(compact_particle_doubles.end(),
+                                    {particle->get_px(), particle->get_py(), particle->get_pz(), particle->get_e()});
+
+    const auto [iter, inserted] = name_index.try_emplace(particle->get_name(), compact_particle_names.size());
+    if (inserted)
+    {
+      compact_particle_names.push_back(iter->first);
+    }
+    compact_particle_name_index.push_back(iter->second);
+
+    if (particle_version == 3)
+    {
+      compact_ion_ints.insert(compact_ion_ints.end(), {particle->get_A(), particle->get_Z()});
+      compact_ion_doubles.insert(compact_ion_doubles.end(), {particle->get_IonCharge(), particle->get_ExcitEnergy()});
+    }
+  }
+
+  compact_vtx_ints.reserve(vtxmap.size() * vtx_nints);
+  compact_vtx_doubles.reserve(vtxmap.size() * vtx_ndoubles);
+  for (const auto& [key, vtx] : vtxmap)
+  {
+    const int vtx_version = vtx_class(vtx);
+    compact_vtx_ints.insert(compact_vtx_ints.end(), {key, vtx_version, vtx->get_id(), vtx_version == 2 ? vtx->get_process() : 0});
+    compact_vtx_doubles.insert(compact_vtx_doubles.end(), {vtx->get_x(), vtx->get_y(), vtx->get_z(), vtx->get_t()});
+  }
+
+  // showers have variable size content, each shower is stored as
+  // - ints: key, id, parent particle, parent shower,
+  //   number and (volume, nhits) pairs, number and volumes of the edep, eion, light yield and eh ratio maps,
+  //   number and ids of particles, number and ids of vertices, number and (volume, number of hits) pairs of hit ids
+  // - floats: position, covariance, edep, eion, light yield and eh ratio values
+  // - hit ids: the hit ids of all volumes
+  for (const auto& [key, base_shower] : showermap)
+  {
+    const auto shower = static_cast<const PHG4Showerv1*>(base_shower);
+    compact_shower_ints.insert(compact_shower_ints.end(), {key, shower->_id, shower->_parent_particle_id, shower->_parent_shower_id});
+    compact_shower_floats.insert(compact_shower_floats.end(), std::begin(shower->_pos), std::end(shower->_pos));
+    compact_shower_floats.insert(compact_shower_floats.end(), std::begin(shower->_covar), std::end(shower->_covar));
+
+    compact_shower_ints.push_back(shower->_nhits.size());
+    for (const auto& [volume, nhits] : shower->_nhits)
+    {
+      compact_shower_ints.insert(compact_shower_ints.end(), {volume, static_cast<int>(nhits)});
+    }
+
+    for (const auto* values : {&shower->_edep, &shower->_eion, &shower->_light_yield, &shower->_eh_ratio})
+    {
+      pack_keys(compact_shower_ints, *values);
+      for (const auto& [volume, value] : *values)
+      {
+        compact_shower_floats.push_back(value);
+      }
+    }
+
+    pack_keys(compact_shower_ints, shower->_g4particle_ids);
+    pack_keys(compact_shower_ints, shower->_g4vertex_ids);
+
+    compact_shower_ints.push_back(shower->_g4hit_ids.size());
+    for (const auto& [volume, hit_ids] : shower->_g4hit_ids)
+    {
+      compact_shower_ints.insert(compact_shower_ints.end(), {volume, static_cast<int>(hit_ids.size())});
+      compact_shower_hit_ids.insert(compact_shower_hit_ids.end(), hit_ids.begin(), hit_ids.end());
+    }
+  }
+
+  return true;
+}
+
+void PHG4TruthInfoContainer::unpack_compact()
+{
+  const size_t nparticles = compact_particle_ints.size() / particle_nints;
+  if (compact_particle_doubles.size() != nparticles * particle_ndoubles ||
+      compact_particle_name_index.size() != nparticles ||
+      compact_vtx_doubles.size() / vtx_ndoubles != compact_vtx_ints.size() / vtx_nints)
+  {
+    std::cout << "PHG4TruthInfoContainer::unpack_compact - inconsistent compact arrays. Ignored" << std::endl;
+    clear_compact();
+    return;
+  }
+
+  // arrays are sorted by id, so that insertions at the end of the maps, with an end() hint, are constant time
+  size_t iion = 0;
+  for (size_t i = 0; i < nparticles; ++i)
+  {
+    const int* ints = &compact_particle_ints[i * particle_nints];
+    const double* doubles = &compact_particle_doubles[i * particle_ndoubles];
+
+    PHG4Particle* particle = nullptr;
+    switch (ints[1])
+    {
+    case 1:
+      particle = new PHG4Particlev1;
+      break;
+    case 2:
+      particle = new PHG4Particlev2;
+      break;
+    default:
+      particle = new PHG4Particlev3;
+      break;
+    }
+
+    particle->set_pid(ints[2]);
+    particle->set_barcode(ints[7]);
+    particle->set_px(doubles[0]);
+    particle->set_py(doubles[1]);
+    particle->set_pz(doubles[2]);
+
+    const auto name = compact_particle_name_index[i];
+    if (name >= 0 && static_cast<size_t>(name) < compact_particle_names.size())
+    {
+      particle->set_name(compact_particle_names[name]);
+    }
+
+    if (ints[1] > 1)
+    {
+      particle->set_track_id(ints[3]);
+      particle->set_vtx_id(ints[4]);
+      particle->set_parent_id(ints[5]);
+      particle->set_primary_id(ints[6]);
+      particle->set_e(doubles[3]);
+    }
+
+    if (ints[1] > 2 && 2 * iion + 1 < compact_ion_ints.size() && 2 * iion + 1 < compact_ion_doubles.size())
+    {
+      particle->set_A(compact_ion_ints[2 * iion]);
+      particle->set_Z(compact_ion_ints[2 * iion + 1]);
+      particle->set_IonCharge(compact_ion_doubles[2 * iion]);
+      particle->set_ExcitEnergy(compact_ion_doubles[2 * iion + 1]);
+      ++iion;
+    }
+
+    auto iter = particlemap.emplace_hint(particlemap.end(), ints[0], particle);
+    if (iter->second != particle)
+    {
+      delete iter->second;
+      iter->second = particle;
+    }
+  }
+
+  const size_t nvertices = compact_vtx_ints.size() / vtx_nints;
+  for (size_t i = 0; i < nvertices; ++i)
+  {
+    const int* ints = &compact_vtx_ints[i * vtx_nints];
+    const double* doubles = &compact_vtx_doubles[i * vtx_ndoubles];
+
+    PHG4VtxPoint* vtx = nullptr;
+    if (ints[1] == 1)
+    {
+      vtx = new PHG4VtxPointv1(doubles[0], doubles[1], doubles[2], doubles[3], ints[2]);
+    }
+    else
+    {
+      vtx = new PHG4VtxPointv2(doubles[0], doubles[1], doubles[2], doubles[3], ints[2]);
+      vtx->set_process(ints[3]);
+    }
+
+    auto iter = vtxmap.emplace_hint(vtxmap.end(), ints[0], vtx);
+    if (iter->second != vtx)
+    {
+      delete iter->second;
+      iter->second = vtx;
+    }
+  }
+
+  compact_reader ints(compact_shower_ints);
+  compact_reader floats(compact_shower_floats);
+  compact_reader hit_ids(compact_shower_hit_ids);
+  while (ints.valid() && !ints.at_end())
+  {
+    const int key = ints.next();
+    auto shower = new PHG4Showerv1;
+    shower->_id = ints.next();
+    shower->_parent_particle_id = ints.next();
+    shower->_parent_shower_id = ints.next();
+    for (auto& x : shower->_pos)
+    {
+      x = floats.next();
+    }
+    for (auto& x : shower->_covar)
+    {
+      x = floats.next();
+    }
+
+    for (size_t i = 0, n = ints.next_size(); i < n; ++i)
+    {
+      const int volume = ints.next();
+      shower->_nhits[volume] = ints.next();
+    }
+
+    for (auto* values : {&shower->_edep, &shower->_eion, &shower->_light_yield, &shower->_eh_ratio})
+    {
+      std::vector<int> volumes(ints.next_size());
+      for (auto& volume : volumes)
+      {
+        volume = ints.next();
+      }
+      for (const auto& volume : volumes)
+      {
+        (*values)[volume] = floats.next();
+      }
+    }
+
+    for (size_t i = 0, n = ints.next_size(); i < n; ++i)
+    {
+      shower->_g4particle_ids.insert(ints.next());
+    }
+    for (size_t i = 0, n = ints.next_size(); i < n; ++i)
+    {
+      shower->_g4vertex_ids.insert(ints.next());
+    }
+    for (size_t i = 0, n = ints.next_size(); i < n; ++i)
+    {
+      auto& volume_hit_ids = shower->_g4hit_ids[ints.next()];
+      for (size_t j = 0, nhits = ints.next_size(hit_ids.remaining()); j < nhits; ++j)
+      {
+        volume_hit_ids.insert(hit_ids.next());
+      }
+    }
+
+    if (!ints.valid() || !floats.valid() || !hit_ids.valid())
+    {
+      std::cout << "PHG4TruthInfoContainer::unpack_compact - inconsistent compact shower arrays. Ignored" << std::endl;
+      delete shower;
+      break;
+    }
+
+    auto iter = showermap.emplace_hint(showermap.end(), key, shower);
+    if (iter->second != shower)
+    {
+      delete iter->second;
+      iter->second = shower;
+    }
+  }
+
+  clear_compact();
+}
+
+void PHG4TruthInfoContainer::clear_compact()
+{
+  compact_particle_ints.clear();
+  compact_particle_doubles.clear();
+  compact_particle_name_index.clear();
+  compact_particle_names.clear();
+  compact_ion_ints.clear();
+  compact_ion_doubles.clear();
+  compact_vtx_ints.clear();
+  compact_vtx_doubles.clear();
+  compact_shower_ints.clear();
+  compact_shower_floats.clear();
+  compact_shower_hit_ids.clear();
+}
@@ -3,12 +3,16 @@
 #ifndef G4MAIN_PHG4TRUTHINFOCONTAINER_H
 #define G4MAIN_PHG4TRUTHINFOCONTAINER_H
 
+#include "PHG4HitDefs.h"
+
 #include <phool/PHObject.h>
 
 #include <iostream>
 #include <iterator>  // for distance
 #include <map>
+#include <string>
 #include <utility>
+#include <vector>
 
 class PHG4Shower;
 class PHG4Particle;
@@ -204,7 +208,25 @@ class PHG4TruthInfoContainer : public PHObject
   int maxshowerindex() const;
   int minshowerindex() const;
 
+  // --- compact I/O ---------------------------------------------------------
+
+  //! write particles, vertices and showers to file as flat, id sorted arrays instead of maps of objects
+  //! this reduces the output size, files are read back transparently into the maps
+  //! the setting is stored with the container, so that copies made by the output managers are written the same way
+  void set_compact_io(bool b = true) { m_compact_io = b; }
+  bool get_compact_io() const { return m_compact_io; }
+
  private:
+  //! fill compact arrays from particle, vertex and shower maps
+  /*! returns false if some objects have types that are not supported by the compact storage */
+  bool pack_compact();
+
+  //! move compact arrays content back to particle, vertex and shower maps
+  void unpack_compact();
+
+  //! clear compact arrays
+  void clear_compact();
+
   /// particle storage map format description:
   /// primary particles are appended in the positive direction
   /// secondary particles are appended in the negative direction
@@ -243,7 +265,23 @@ class PHG4TruthInfoContainer : public PHObject
   std::map<int, int> particle_embed_flags;  //< trackid => embed flag
   std::map<int, int> vertex_embed_flags;    //< vtxid => embed flag
 
-  ClassDefOverride(PHG4TruthInfoContainer, 2)
+  /// compact storage of particles, vertices and showers, sorted by id. Only filled while streaming in compact mode
+  /// the particle, vertex and shower maps are then written empty
+  std::vector<int> compact_particle_ints;        //< key, class version, pid, track, vertex, parent, primary, barcode
+  std::vector<double> compact_particle_doubles;  //< px, py, pz, e
+  std::vector<int> compact_particle_name_index;  //< index in compact_particle_names
+  std::vector<std::string> compact_particle_names;
+  std::vector<int> compact_ion_ints;        //< A, Z for ions (PHG4Particlev3) only
+  std::vector<double> compact_ion_doubles;  //< ion charge, excitation energy for ions only
+  std::vector<int> compact_vtx_ints;        //< key, class version, id, process
+  std::vector<double> compact_vtx_doubles;  //< x, y, z, t
+  std::vector<int> compact_shower_ints;      //< key, id, parent particle, parent shower, followed by the sizes and ids of the shower maps and sets
+  std::vector<float> compact_shower_floats;  //< position, covariance, followed by the per volume values
+  std::vector<PHG4HitDefs::keytype> compact_shower_hit_ids;
+
+  bool m_compact_io = false;  //< written to file, so that snapshots streamed back into new objects keep the setting
+
+  ClassDefOverride(PHG4TruthInfoContainer, 3)
 };
 
 /**
@@ -1,5 +1,5 @@
 #ifdef __CINT__
 
-#pragma link C++ class PHG4TruthInfoContainer + ;
+#pragma link C++ class PHG4TruthInfoContainer - ;
 
 #endif /* __CINT__ */
@@ -44,6 +44,10 @@ int PHG4TruthSubsystem::InitRun(PHCompositeNode* topNode)
     truthInfoList = new PHG4TruthInfoContainer();
     dstNode->addNode(new PHIODataNode<PHObject>(truthInfoList, "G4TruthInfo", "PHObject"));
   }
+  if (m_CompactTruthIOFlag)
+  {
+    truthInfoList->set_compact_io();
+  }
 
   // event action
   m_EventAction = new PHG4TruthEventAction();
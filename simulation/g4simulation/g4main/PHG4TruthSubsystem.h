@@ -43,6 +43,9 @@ class PHG4TruthSubsystem : public PHG4Subsystem
   //! only save the G4 truth information that is associated with the embedded particle
   void SetSaveOnlyEmbeded(bool b = true) { m_SaveOnlyEmbededFlag = b; };
 
+  //! write truth particles, vertices and showers to the DST as flat arrays (see PHG4TruthInfoContainer::set_compact_io)
+  void SetCompactTruthIO(bool b = true) { m_CompactTruthIOFlag = b; }
+
  private:
   PHG4TruthEventAction *m_EventAction{nullptr};
 
@@ -50,6 +53,9 @@ class PHG4TruthSubsystem : public PHG4Subsystem
 
   //! only save the G4 truth information that is associated with the embedded particle
   bool m_SaveOnlyEmbededFlag{false};
+
+  //! compact truth output
+  bool m_CompactTruthIOFlag{false};
 };
 
 #endif
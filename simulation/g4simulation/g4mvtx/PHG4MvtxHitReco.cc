@@ -66,6 +66,7 @@
 #include <limits>
 #include <memory>  // for allocator_tra...
 #include <set>     // for vector
+#include <tuple>
 #include <vector>  // for vector
 
 // New headers I added
@@ -454,10 +455,6 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
             << std::endl;
       }
 
-      std::vector<int> vpixel;
-      std::vector<int> vxbin;
-      std::vector<int> vzbin;
-      std::vector<std::pair<double, double> > venergy;
       // double trklen = 0.0;
 
       //===================================================
@@ -551,9 +548,46 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
         continue;
       }
 
-      // this hit is skipped earlier if this dimensioning would be exceeded
-      double pixenergy[12][12] = {};  // init to 0
-      double pixeion[12][12] = {};    // init to 0
+      // dense charge raster over the window, reused from hit to hit
+      const int nx = xbin_max - xbin_min + 1;
+      const int nz = zbin_max - zbin_min + 1;
+      if (nx <= 0 || nz <= 0)
+      {
+        continue;
+      }
+      m_pixenergy.assign(nx * nz, 0);
+
+      // pixel edges, the local x coordinate only depends on the row and the local z coordinate on the column,
+      // so they are computed once per row and column rather than for every pixel and segment
+      m_pixel_x1.resize(nx);
+      m_pixel_x2.resize(nx);
+      m_pixel_z1.resize(nz);
+      m_pixel_z2.resize(nz);
+      for (int ix = xbin_min; ix <= xbin_max; ix++)
+      {
+        const TVector3 tmp = layergeom->get_local_coords_from_pixel(layergeom->get_pixel_number_from_xbin_zbin(ix, zbin_min));
+        m_pixel_x1[ix - xbin_min] = tmp.X() - xpixw_half;
+        m_pixel_x2[ix - xbin_min] = tmp.X() + xpixw_half;
+      }
+      for (int iz = zbin_min; iz <= zbin_max; iz++)
+      {
+        const int pixnum = layergeom->get_pixel_number_from_xbin_zbin(xbin_min, iz);
+        if (pixnum < 0)
+        {
+          std::cout
+              << " pixnum < 0 , pixnum = " << pixnum << "\n"
+              << " iz " << iz << "\n"
+              << " xbin_min " << xbin_min << " zbin_min " << zbin_min << "\n"
+              << " xbin_max " << xbin_max << " zbin_max " << zbin_max << "\n"
+              << " maxNX " << maxNX << " maxNZ " << maxNZ
+              << std::endl;
+        }
+        const TVector3 tmp = layergeom->get_local_coords_from_pixel(pixnum);
+        m_pixel_z1[iz - zbin_min] = tmp.Z() + zpixw_half;
+        m_pixel_z2[iz - zbin_min] = tmp.Z() - zpixw_half;
+      }
+
+      const auto edep = g4hit->get_edep();
 
       // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
       for (int i = 0; i < nsegments; i++)
@@ -595,154 +629,136 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
               << std::endl;
         }
         // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
-        for (int ix = xbin_min; ix <= xbin_max; ix++)
+        const double cx = segvec.X();
+        const double cz = segvec.Z();
+        const double circle_area = M_PI * pow(ydiffusion_radius, 2);
+        for (int jx = 0; jx < nx; jx++)
         {
-          for (int iz = zbin_min; iz <= zbin_max; iz++)
+          const double x1 = m_pixel_x1[jx];
+          const double x2 = m_pixel_x2[jx];
+          double* energy_row = &m_pixenergy[jx * nz];
+          for (int jz = 0; jz < nz; jz++)
           {
-            // Find the pixel corners for this pixel number
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
-
-            if (pixnum < 0)
-            {
-              std::cout
-                  << " pixnum < 0 , pixnum = " << pixnum << "\n"
-                  << " ix " << ix << " iz " << iz << "\n"
-                  << " xbin_min " << xbin_min << " zbin_min " << zbin_min << "\n"
-                  << " xbin_max " << xbin_max << " zbin_max " << zbin_max << "\n"
-                  << " maxNX " << maxNX << " maxNZ " << maxNZ
-                  << std::endl;
-            }
-
-            TVector3 tmp = layergeom->get_local_coords_from_pixel(pixnum);
             // note that (x1,z1) is the top left corner, (x2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
-            double x1 = tmp.X() - xpixw_half;
-            double z1 = tmp.Z() + zpixw_half;
-            double x2 = tmp.X() + xpixw_half;
-            double z2 = tmp.Z() - zpixw_half;
-
-            // here segvec.X and segvec.Z are the center of the circle, and diffusion_radius is the circle radius
+            // here cx and cz are the center of the circle, and diffusion_radius is the circle radius
             // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
-            double pixarea_frac = PHG4Utils::circle_rectangle_intersection(x1, z1, x2, z2, segvec.X(), segvec.Z(), ydiffusion_radius) / (M_PI * pow(ydiffusion_radius, 2));
+            double pixarea_frac = PHG4Utils::circle_rectangle_intersection(x1, m_pixel_z1[jz], x2, m_pixel_z2[jz], cx, cz, ydiffusion_radius) / circle_area;
             // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
-            pixenergy[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_edep() / (float) nsegments;
-            if (g4hit->has_property(PHG4Hit::prop_eion))
-            {
-              pixeion[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_eion() / (float) nsegments;
-            }
+            energy_row[jz] += pixarea_frac * edep / (float) nsegments;
             if (Verbosity() > 5)
             {
               std::cout
-                  << "    pixnum " << pixnum << " xbin " << ix << " zbin " << iz
-                  << " pixel_area fraction of circle " << pixarea_frac << " accumulated pixel energy " << pixenergy[ix - xbin_min][iz - zbin_min]
+                  << "    pixnum " << layergeom->get_pixel_number_from_xbin_zbin(xbin_min + jx, zbin_min + jz) << " xbin " << xbin_min + jx << " zbin " << zbin_min + jz
+                  << " pixel_area fraction of circle " << pixarea_frac << " accumulated pixel energy " << energy_row[jz]
                   << std::endl;
             }
           }
         }
       }  // end loop over segments
 
-      // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
-      for (int ix = xbin_min; ix <= xbin_max; ix++)
-      {
-        for (int iz = zbin_min; iz <= zbin_max; iz++)
-        {
-          if (pixenergy[ix - xbin_min][iz - zbin_min] > 0.0)
-          {
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
-            vpixel.push_back(pixnum);
-            vxbin.push_back(ix);
-            vzbin.push_back(iz);
-            std::pair<double, double> tmppair = std::make_pair(pixenergy[ix - xbin_min][iz - zbin_min], pixeion[ix - xbin_min][iz - zbin_min]);
-            venergy.push_back(tmppair);
-            if (Verbosity() > 1)
-            {
-              std::cout
-                  << " Added pixel number " << pixnum << " xbin " << ix
-                  << " zbin " << iz << " to vectors with energy " << pixenergy[ix - xbin_min][iz - zbin_min]
-                  << std::endl;
-            }
-          }
-        }
-      }
-
       //===================================
       // End of charge sharing implementation
       //===================================
 
-      // loop over all fired cells for this g4hit and add them to the TrkrHitSet
+      // hitsets are looked up once per strobe replica rather than once per fired pixel
+      m_replica_hitsets.assign(n_replica, nullptr);
+      const TrkrDefs::hitsetkey hitsetkeymask = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, 0);
 
-      for (unsigned int i1 = 0; i1 < vpixel.size(); i1++)  // loop over all fired cells
+      // loop over all pixels with non-zero energy deposited, summed over all tracklet segments, and add them to the TrkrHitSet
+      for (int ix = xbin_min; ix <= xbin_max; ix++)
       {
-        // This is the new storage object version
-        //====================================
-        for (unsigned int i_rep = 0; i_rep < n_replica; i_rep++)
+        for (int iz = zbin_min; iz <= zbin_max; iz++)
         {
-          int strobe = t0_strobe_frame + i_rep;
-          // to fit in a 5 bit field in the hitsetkey [-16,15]
-          strobe = std::max(strobe, -16);
-          if (strobe >= 16)
+          const double pixenergy = m_pixenergy[(ix - xbin_min) * nz + (iz - zbin_min)];
+          if (pixenergy <= 0.0)
           {
-            strobe = 15;
+            continue;
           }
 
-          // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a chip for the Mvtx
-          TrkrDefs::hitsetkey hitsetkey = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, strobe);
-          // Use existing hitset or add new one if needed
-          TrkrHitSetContainer::Iterator hitsetit = trkrHitSetContainer->findOrAddHitSet(hitsetkey);
+          if (Verbosity() > 1)
+          {
+            std::cout
+                << " Added pixel number " << layergeom->get_pixel_number_from_xbin_zbin(ix, iz) << " xbin " << ix
+                << " zbin " << iz << " with energy " << pixenergy
+                << std::endl;
+          }
 
           // generate the key for this hit
-          TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(vzbin[i1], vxbin[i1]);
-          // See if this hit already exists
-          TrkrHit* hit = nullptr;
-          hit = hitsetit->second->getHit(hitkey);
+          const TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(iz, ix);
+          const bool masked = is_masked(hitsetkeymask, hitkey);
 
-          if (hit)
+          for (unsigned int i_rep = 0; i_rep < n_replica; i_rep++)
           {
-            if (Verbosity() > 0)
+            int strobe = t0_strobe_frame + i_rep;
+            // to fit in a 5 bit field in the hitsetkey [-16,15]
+            strobe = std::max(strobe, -16);
+            if (strobe >= 16)
             {
-              std::cout << PHWHERE << "::" << __func__
-                        << " - duplicated hit, hitsetkey: " << hitsetkey
-                        << " hitkey: " << hitkey << std::endl;
+              strobe = 15;
             }
-            continue;
-          }
-          const TrkrDefs::hitsetkey hitsetkeymask = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, 0);
 
-          // Regardless of whether the hit should be masked, add the energy to the truth hit
-          double hitenergy = venergy[i1].first * TrkrDefs::MvtxEnergyScaleup;
-          addtruthhitset(hitsetkey, hitkey, hitenergy);
+            // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a chip for the Mvtx
+            TrkrDefs::hitsetkey hitsetkey = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, strobe);
+            // Use existing hitset or add new one if needed
+            TrkrHitSet*& hitset = m_replica_hitsets[i_rep];
+            if (!hitset)
+            {
+              hitset = trkrHitSetContainer->findOrAddHitSet(hitsetkey)->second;
+            }
 
-          if ((std::find(m_deadPixelMap.begin(), m_deadPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_deadPixelMap.end()) && (std::find(m_hotPixelMap.begin(), m_hotPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_hotPixelMap.end()))
-          {
-            // create hit and insert in hitset
-            hit = new TrkrHitv2();
+            // See if this hit already exists
+            TrkrHit* hit = nullptr;
+            hit = hitset->getHit(hitkey);
 
-            hit->addEnergy(hitenergy);
-            hitsetit->second->addHitSpecificKey(hitkey, hit);
-          }
-          else
-          {
-            continue;
-          }
+            if (hit)
+            {
+              if (Verbosity() > 0)
+              {
+                std::cout << PHWHERE << "::" << __func__
+                          << " - duplicated hit, hitsetkey: " << hitsetkey
+                          << " hitkey: " << hitkey << std::endl;
+              }
+              continue;
+            }
 
-          if (Verbosity() > 0)
-          {
-            std::cout << "Layer: " << layer << ", Stave: " << (uint16_t) MvtxDefs::getStaveId(hitsetkey) << ", Chip: " << (uint16_t) MvtxDefs::getChipId(hitsetkey) << ", Row: " << MvtxDefs::getRow(hitkey) << ", Col: " << MvtxDefs::getCol(hitkey) << ", Strobe: " << MvtxDefs::getStrobeId(hitsetkey) << ", added hit " << hitkey << " to hitset " << hitsetkey << " with energy " << hit->getEnergy() / TrkrDefs::MvtxEnergyScaleup << std::endl;
-          }
+            // Regardless of whether the hit should be masked, add the energy to the truth hit
+            double hitenergy = pixenergy * TrkrDefs::MvtxEnergyScaleup;
+            addtruthhitset(hitsetkey, hitkey, hitenergy);
+
+            if (!masked)
+            {
+              // create hit and insert in hitset
+              hit = new TrkrHitv2();
 
-          // now we update the TrkrHitTruthAssoc map - the map contains <hitsetkey, std::pair <hitkey, g4hitkey> >
-          // There is only one TrkrHit per pixel, but there may be multiple g4hits
-          // How do we know how much energy from PHG4Hit went into TrkrHit? We don't, have to sort it out in evaluator to save memory
+              hit->addEnergy(hitenergy);
+              hitset->addHitSpecificKey(hitkey, hit);
+            }
+            else
+            {
+              continue;
+            }
+
+            if (Verbosity() > 0)
+            {
+              std::cout << "Layer: " << layer << ", Stave: " << (uint16_t) MvtxDefs::getStaveId(hitsetkey) << ", Chip: " << (uint16_t) MvtxDefs::getChipId(hitsetkey) << ", Row: " << MvtxDefs::getRow(hitkey) << ", Col: " << MvtxDefs::getCol(hitkey) << ", Strobe: " << MvtxDefs::getStrobeId(hitsetkey) << ", added hit " << hitkey << " to hitset " << hitsetkey << " with energy " << hit->getEnergy() / TrkrDefs::MvtxEnergyScaleup << std::endl;
+            }
+
+            // now we update the TrkrHitTruthAssoc map - the map contains <hitsetkey, std::pair <hitkey, g4hitkey> >
+            // There is only one TrkrHit per pixel, but there may be multiple g4hits
+            // How do we know how much energy from PHG4Hit went into TrkrHit? We don't, have to sort it out in evaluator to save memory
 
-          // we set the strobe ID to zero in the hitsetkey
-          // we use the findOrAdd method to keep from adding identical entries
-          TrkrDefs::hitsetkey bare_hitsetkey = zero_strobe_bits(hitsetkey);
-          hitTruthAssoc->findOrAddAssoc(bare_hitsetkey, hitkey, g4hit_it->first);
+            // we set the strobe ID to zero in the hitsetkey
+            // entries are collected in a flat table, duplicates are removed in fill_truth_assoc
+            m_truth_assoc.push_back({hitsetkeymask, hitkey, g4hit_it->first, m_truth_assoc.size()});
+          }
         }
       }  // end loop over hit cells
     }    // end loop over g4hits for this layer
 
   }  // end loop over layers
 
+  fill_truth_assoc(hitTruthAssoc);
+
   // print the list of entries in the association table
   if (Verbosity() > 0)
   {
@@ -1360,5 +1376,35 @@ void PHG4MvtxHitReco::makePixelMask(hitMask& aMask, const std::string& dbName, c
     aMask.push_back({std::make_pair(DeadPixelHitKey, DeadHitKey)});
   }
 
+  // sort for binary search in is_masked
+  std::sort(aMask.begin(), aMask.end());
+  aMask.erase(std::unique(aMask.begin(), aMask.end()), aMask.end());
+
   delete cdbttree;
 }
+
+bool PHG4MvtxHitReco::is_masked(TrkrDefs::hitsetkey bare_hitsetkey, TrkrDefs::hitkey hitkey) const
+{
+  const auto key = std::make_pair(bare_hitsetkey, hitkey);
+  return std::binary_search(m_deadPixelMap.begin(), m_deadPixelMap.end(), key) || std::binary_search(m_hotPixelMap.begin(), m_hotPixelMap.end(), key);
+}
+
+void PHG4MvtxHitReco::fill_truth_assoc(TrkrHitTruthAssoc* hitTruthAssoc)
+{
+  // remove duplicated entries (same pixel in several strobe replicas), keeping the first one,
+  // then restore the fill order so that the association map is identical to filling it hit by hit
+  std::sort(m_truth_assoc.begin(), m_truth_assoc.end(), [](const TruthAssoc& lhs, const TruthAssoc& rhs)
+            { return std::tie(lhs.hitsetkey, lhs.hitkey, lhs.g4hitkey, lhs.index) < std::tie(rhs.hitsetkey, rhs.hitkey, rhs.g4hitkey, rhs.index); });
+  m_truth_assoc.erase(std::unique(m_truth_assoc.begin(), m_truth_assoc.end(), [](const TruthAssoc& lhs, const TruthAssoc& rhs)
+                                  { return lhs.hitsetkey == rhs.hitsetkey && lhs.hitkey == rhs.hitkey && lhs.g4hitkey == rhs.g4hitkey; }),
+                      m_truth_assoc.end());
+  std::sort(m_truth_assoc.begin(), m_truth_assoc.end(), [](const TruthAssoc& lhs, const TruthAssoc& rhs)
+            { return lhs.index < rhs.index; });
+
+  // the association node may already hold entries from the input, so findOrAdd is still needed
+  for (const auto& assoc : m_truth_assoc)
+  {
+    hitTruthAssoc->findOrAddAssoc(assoc.hitsetkey, assoc.hitkey, assoc.g4hitkey);
+  }
+  m_truth_assoc.clear();
+}
@@ -4,10 +4,13 @@
 #include <phparameter/PHParameterInterface.h>
 #include <trackbase/TrkrDefs.h>
 
+#include <g4main/PHG4HitDefs.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <gsl/gsl_rng.h>
 
+#include <cstddef>
 #include <map>
 #include <memory>  // for unique_ptr
 #include <string>
@@ -20,7 +23,9 @@ class PHCompositeNode;
 class PHG4Hit;
 class PHG4TruthInfoContainer;
 class TrkrClusterContainer;
+class TrkrHitSet;
 class TrkrHitSetContainer;
+class TrkrHitTruthAssoc;
 class TrkrTruthTrack;
 class TrkrTruthTrackContainer;
 
@@ -96,9 +101,36 @@ class PHG4MvtxHitReco : public SubsysReco, public PHParameterInterface
   TrkrHitSetContainer* m_truth_hits;                              // generate and delete a container for each truth track
   std::map<TrkrDefs::hitsetkey, unsigned int> m_hitsetkey_cnt{};  // counter for making ckeys form hitsetkeys
 
+  //! sorted, searched with binary search
   hitMask m_deadPixelMap;
   hitMask m_hotPixelMap;
 
+  //! true if pixel is in the dead or hot pixel maps
+  bool is_masked(TrkrDefs::hitsetkey bare_hitsetkey, TrkrDefs::hitkey hitkey) const;
+
+  //! charge raster over the (xbin, zbin) window of the current g4hit, indexed (ix - xbin_min) * nz + (iz - zbin_min)
+  std::vector<double> m_pixenergy;
+
+  //! pixel edges in local coordinates for the rows (x) and columns (z) of the window
+  std::vector<double> m_pixel_x1;
+  std::vector<double> m_pixel_x2;
+  std::vector<double> m_pixel_z1;
+  std::vector<double> m_pixel_z2;
+
+  //! hitset for each strobe replica of the current g4hit, created on first use
+  std::vector<TrkrHitSet*> m_replica_hitsets;
+
+  //! flat per-event table of hit to g4hit associations, written to the node at end of event
+  struct TruthAssoc
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    TrkrDefs::hitkey hitkey = 0;
+    PHG4HitDefs::keytype g4hitkey = 0;
+    size_t index = 0;
+  };
+  std::vector<TruthAssoc> m_truth_assoc;
+  void fill_truth_assoc(TrkrHitTruthAssoc*);
+
   PHG4Hit* prior_g4hit{nullptr};  // used to check for jumps in g4hits for loopers;
   void addtruthhitset(TrkrDefs::hitsetkey, TrkrDefs::hitkey, float neffelectrons);
   void truthcheck_g4hit(PHG4Hit*, PHCompositeNode* topNode);
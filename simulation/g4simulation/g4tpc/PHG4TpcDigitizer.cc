@@ -25,6 +25,7 @@
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdlib>  // for exit
 #include <iostream>
@@ -252,10 +253,11 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
       exit(1);
     }
 
-    int nphibins = layergeom->get_phibins();
+    const int nphibins = layergeom->get_phibins();
+    const int ntbins = layergeom->get_zbins();
     if (Verbosity() > 1)
     {
-      std::cout << "    nphibins " << nphibins << std::endl;
+      std::cout << "    nphibins " << nphibins << " ntbins " << ntbins << std::endl;
     }
 
     for (unsigned int side = 0; side < 2; ++side)
@@ -265,21 +267,11 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
         std::cout << "TPC layer " << layer << " side " << side << std::endl;
       }
 
-      // for this layer and side, use a vector of a vector of cells for each phibin
-      if (phi_sorted_hits.size() != static_cast<std::size_t>(nphibins))
-      {
-        phi_sorted_hits.clear();
-        phi_sorted_hits.resize(nphibins);
-      }
-      else
-      {
-        for (auto &hits : phi_sorted_hits)
-        {
-          hits.clear();
-        }
-      }
+      // dense (phi, t) raster of the signal hits for this layer and side, row major in phi
+      signal_hit_raster.assign(static_cast<size_t>(nphibins) * ntbins, nullptr);
+      signal_bins.clear();
 
-      // Loop over all hitsets containing signals for this layer and add them to phi_sorted_hits for their phibin
+      // Loop over all hitsets containing signals for this layer and add them to the raster
       TrkrHitSetContainer::ConstRange hitset_range = trkrhitsetcontainer->getHitSets(TrkrDefs::TrkrId::tpcId, layer);
       for (TrkrHitSetContainer::ConstIterator hitset_iter = hitset_range.first;
            hitset_iter != hitset_range.second;
@@ -311,96 +303,60 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
              hit_iter != hit_range.second;
              ++hit_iter)
         {
-          // Fill the vector of signal hits for each phibin
-          unsigned int phibin = TpcDefs::getPad(hit_iter->first);
-          phi_sorted_hits[phibin].push_back(hit_iter);
+          const int phibin = TpcDefs::getPad(hit_iter->first);
+          const int tbin = TpcDefs::getTBin(hit_iter->first);
+          if (phibin >= nphibins || tbin >= ntbins)
+          {
+            continue;
+          }
+          const size_t index = static_cast<size_t>(phibin) * ntbins + tbin;
+          if (!signal_hit_raster[index])
+          {
+            signal_hit_raster[index] = hit_iter->second;
+            signal_bins.push_back(index);
+          }
         }
-        // For this hitset we now have the signal hits sorted into vectors for each phi
-      }
-
-      // Process one phi bin at a time
-      if (Verbosity() > 1)
-      {
-        std::cout << "    phi_sorted_hits size " << phi_sorted_hits.size() << " ntbins " << layergeom->get_zbins() << std::endl;
       }
 
-      for (unsigned int iphi = 0; iphi < phi_sorted_hits.size(); iphi++)
+      // For this step we take the edep value and convert it to mV at the ADC input
+      // See comments above for how to do this for signal and noise
+      adc_input_raster.assign(signal_hit_raster.size(), 0.0);
+      if (!skip_noise)
       {
-        int ntbins = layergeom->get_zbins();
-        signal_hit_by_tbin.assign(ntbins, nullptr);
-
-        // add a signal hit from phi_sorted_hits for each t bin that has one
-        for (unsigned int it = 0; it < phi_sorted_hits[iphi].size(); it++)
+        // every bin gets noise, the random numbers are drawn in (phi, t) order
+        // as if the bins were processed one by one
+        for (auto &adc : adc_input_raster)
         {
-          int tbin = TpcDefs::getTBin(phi_sorted_hits[iphi][it]->first);
-          if (!signal_hit_by_tbin[tbin])
-          {
-            signal_hit_by_tbin[tbin] = phi_sorted_hits[iphi][it]->second;
-          }
-
-          if (Verbosity() > 2)
-          {
-            if (layer == print_layer)
-            {
-              TrkrDefs::hitkey hitkey = phi_sorted_hits[iphi][it]->first;
-              std::cout << "iphi " << iphi << " adding existing signal hit for layer " << layer
-                        << " side " << side
-                        << " tbin " << tbin << "  hitkey " << hitkey
-                        << " pad " << TpcDefs::getPad(hitkey)
-                        << " t bin " << TpcDefs::getTBin(hitkey)
-                        << "  energy " << (phi_sorted_hits[iphi][it]->second)->getEnergy()
-                        << std::endl;
-            }
-          }
+          adc = added_noise();
         }
+        for (auto &adc : adc_input_raster)
+        {
+          adc = (Pedestal + adc) * ADCNoiseConversionGain;  // mV - from definition of noise charge and pedestal charge
+        }
+        for (const auto index : signal_bins)
+        {
+          const float signal = signal_hit_raster[index]->getEnergy();
+          adc_input_raster[index] = signal * ADCSignalConversionGain + adc_input_raster[index];
+        }
+      }
 
-        // initialize entries to zero for each t bin
-        adc_input.assign(ntbins, 0.0);
+      // hitsets for new noise hits, by sector
+      std::array<TrkrHitSet *, 12> sector_hitsets{};
 
-        // Now for this phibin we process all bins ordered by t into hits with noise
-        //======================================================
-        // For this step we take the edep value and convert it to mV at the ADC input
-        // See comments above for how to do this for signal and noise
+      for (int iphi = 0; iphi < nphibins; iphi++)
+      {
+        TrkrHit **signal_hit_by_tbin = &signal_hit_raster[static_cast<size_t>(iphi) * ntbins];
+        float *adc_input = &adc_input_raster[static_cast<size_t>(iphi) * ntbins];
 
-        for (int it = 0; it < ntbins; it++)
+        if (skip_noise)
         {
-          TrkrHit *signal_hit = signal_hit_by_tbin[it];
-          if (signal_hit)
+          // only bins with signal get noise, the random numbers used in the
+          // digitization below are drawn in between, so this is done phi bin by phi bin
+          for (int it = 0; it < ntbins; it++)
           {
-            // This tbin has a hit, add noise
-            float signal_with_noise = add_noise_to_bin(signal_hit->getEnergy());
-            adc_input[it] = signal_with_noise;
-
-            if (Verbosity() > 2)
+            if (signal_hit_by_tbin[it])
             {
-              if (layer == print_layer)
-              {
-                std::cout << "existing signal hit: layer " << layer << " iphi " << iphi << " it " << it
-                          << " edep " << signal_hit->getEnergy()
-                          << " adc gain " << ADCSignalConversionGain
-                          << " signal with noise " << signal_with_noise
-                          << " adc_input " << adc_input[it] << std::endl;
-              }
-            }
-          }
-          else
-          {
-            if (!skip_noise)
-            {
-              // This t bin does not have a filled cell, add noise
-              float noise = add_noise_to_bin(0.0);
-              adc_input[it] = noise;
-
-              if (Verbosity() > 2)
-              {
-                if (layer == print_layer)
-                {
-                  std::cout << "noise hit: layer " << layer << " side " << side << " iphi " << iphi << " it " << it
-                            << " adc gain " << ADCSignalConversionGain
-                            << " noise " << noise
-                            << " adc_input " << adc_input[it] << std::endl;
-                }
-              }
+              adc_input[it] = add_noise_to_bin(signal_hit_by_tbin[it]->getEnergy());
             }
           }
         }
@@ -497,11 +453,15 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
                   // Hit does not exist yet, have to make one
                   // we need the hitset key, requires (layer, sector, side)
                   unsigned int sector = 12 * iphi / nphibins;
-                  TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
-                  auto hitset_iter = trkrhitsetcontainer->findOrAddHitSet(hitsetkey);
+                  TrkrHitSet *&hitset = sector_hitsets[sector];
+                  if (!hitset)
+                  {
+                    TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
+                    hitset = trkrhitsetcontainer->findOrAddHitSet(hitsetkey)->second;
+                  }
 
                   hit = new TrkrHitv2();
-                  hitset_iter->second->addHitSpecificKey(hitkey, hit);
+                  hitset->addHitSpecificKey(hitkey, hit);
 
                   if (Verbosity() > 2)
                   {
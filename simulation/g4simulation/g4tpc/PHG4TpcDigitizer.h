@@ -10,6 +10,7 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <cstddef>
 #include <map>
 #include <string>   // for string
 #include <utility>  // for pair, make_pair
@@ -59,9 +60,11 @@ class PHG4TpcDigitizer : public SubsysReco
 
   bool skip_noise {false};
 
-  std::vector<std::vector<TrkrHitSet::ConstIterator> > phi_sorted_hits;
-  std::vector<float> adc_input;
-  std::vector<TrkrHit *> signal_hit_by_tbin;
+  //! dense (phi, t) rasters for the layer and side being digitized, row major in phi
+  std::vector<TrkrHit *> signal_hit_raster;
+  std::vector<float> adc_input_raster;
+  //! raster indices of the signal hits
+  std::vector<size_t> signal_bins;
 
   // settings
   std::map<int, unsigned int> _max_adc;
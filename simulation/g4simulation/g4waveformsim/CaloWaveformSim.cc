@@ -29,7 +29,7 @@
 #include <g4detectors/PHG4CylinderGeom_Spacalv1.h>  // for PHG4CylinderGeom_Spaca...
 #include <g4detectors/PHG4CylinderGeom_Spacalv3.h>
 
-#include <TF1.h>
+#include <TAxis.h>
 #include <TFile.h>
 #include <TProfile.h>
 #include <TSystem.h>
@@ -39,10 +39,83 @@
 #include <sstream>
 #include <string>
 
-double CaloWaveformSim::template_function(double *x, double *par)
+void CaloWaveformSim::tabulate_template()
 {
-  Double_t v1 = par[0] * h_template->Interpolate(x[0] - par[1]) + par[2];
-  return v1;
+  // TH1::Interpolate is linear between bin centers and constant outside the first and last center.
+  // For uniform bins the bin contents are the exact table, otherwise resample on a fine grid
+  const TAxis *axis = h_template->GetXaxis();
+  const int nbins = h_template->GetNbinsX();
+  m_template_x0 = h_template->GetBinCenter(1);
+  if (!axis->IsVariableBinSize())
+  {
+    m_template_dx = axis->GetBinWidth(1);
+    m_template_y.resize(nbins);
+    for (int i = 0; i < nbins; i++)
+    {
+      m_template_y[i] = h_template->GetBinContent(i + 1);
+    }
+  }
+  else
+  {
+    const int npoints = 10 * nbins + 1;
+    m_template_dx = (h_template->GetBinCenter(nbins) - m_template_x0) / (npoints - 1);
+    m_template_y.resize(npoints);
+    for (int i = 0; i < npoints; i++)
+    {
+      m_template_y[i] = h_template->Interpolate(m_template_x0 + i * m_template_dx);
+    }
+  }
+
+  // maximum of the unshifted template within the readout window,
+  // for a piecewise linear template it is at a table point or at the window edges
+  double ymax = template_value(0.);
+  m_template_peak = 0.;
+  for (size_t i = 0; i < m_template_y.size(); i++)
+  {
+    double x = m_template_x0 + i * m_template_dx;
+    if (x > 0. && x < m_nsamples && m_template_y[i] > ymax)
+    {
+      ymax = m_template_y[i];
+      m_template_peak = x;
+    }
+  }
+  if (template_value(m_nsamples) > ymax)
+  {
+    m_template_peak = m_nsamples;
+  }
+}
+
+double CaloWaveformSim::template_value(const double x) const
+{
+  const double pos = (x - m_template_x0) / m_template_dx;
+  const int last = static_cast<int>(m_template_y.size()) - 1;
+  if (pos <= 0.)
+  {
+    return m_template_y.front();
+  }
+  if (pos >= last)
+  {
+    return m_template_y.back();
+  }
+  const int i = static_cast<int>(pos);
+  const double frac = pos - i;
+  return m_template_y[i] + frac * (m_template_y[i + 1] - m_template_y[i]);
+}
+
+void CaloWaveformSim::add_pulse(float *waveform, const double ampl, const double shift) const
+{
+  // sample i sees the template at i - shift, so consecutive samples are 1/dx table points apart
+  const double pos0 = (-shift - m_template_x0) / m_template_dx;
+  const double step = 1. / m_template_dx;
+  const double last = static_cast<double>(m_template_y.size() - 1);
+  const double *table = m_template_y.data();
+  for (int i = 0; i < m_nsamples; i++)
+  {
+    const double pos = std::clamp(pos0 + i * step, 0., last);
+    const int idx = std::min(static_cast<int>(pos), static_cast<int>(last) - 1);
+    const double frac = pos - idx;
+    waveform[i] += ampl * (table[idx] + frac * (table[idx + 1] - table[idx]));
+  }
 }
 
 CaloWaveformSim::CaloWaveformSim(const std::string &name)
@@ -73,6 +146,7 @@ int CaloWaveformSim::InitRun(PHCompositeNode *topNode)
   TFile *ft = TFile::Open(templatefilename.c_str());
   assert(ft && ft->IsOpen());
   h_template = static_cast<TProfile *>(ft->Get("hpwaveform"));
+  tabulate_template();
 
   // Determine run number
   EventHeader *evtHeader = findNode::getClass<EventHeader>(topNode, "EventHeader");
@@ -221,7 +295,7 @@ int CaloWaveformSim::InitRun(PHCompositeNode *topNode)
   }
 
   // Prepare waveform buffers
-  m_waveforms.assign(m_nchannels, std::vector<float>(m_nsamples));
+  m_waveforms.assign(static_cast<size_t>(m_nchannels) * m_nsamples, 0.);
 
   // Create node tree and finish
   CreateNodeTree(topNode);
@@ -263,27 +337,13 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
   }
 
   // initialize the waveform
-  for (auto &waveform : m_waveforms)
-  {
-    for (auto &sample : waveform)
-    {
-      sample = 0.;
-    }
-  }
-  // waveform TH1
-  TF1 *f_fit = new TF1(
-      "f_fit", [this](double *x, double *par)
-      { return this->template_function(x, par); },
-      0, m_nsamples, 3);
-  f_fit->SetParameter(0, 1.0);
-  f_fit->SetParameter(1, 0.0);
-  float template_peak = f_fit->GetMaximumX();
+  std::fill(m_waveforms.begin(), m_waveforms.end(), 0.);
+
+  float template_peak = m_template_peak;
   float shift_of_shift = m_timeshiftwidth * gsl_rng_uniform(m_RandomGenerator);
 
   float _shiftval = m_peakpos + shift_of_shift - template_peak;
 
-  f_fit->SetParameters(1, _shiftval, 0);
-
   // get G4Hits
   std::string nodename = "G4HIT_" + m_detector;
   PHG4HitContainer *hits = findNode::getClass<PHG4HitContainer>(topNode, nodename);
@@ -352,6 +412,11 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
 
     float t0 = hit->get_t(0) / m_sampletime;
     unsigned int tower_index = decode_tower(key);
+    if (tower_index >= static_cast<unsigned int>(m_nchannels))
+    {
+      std::cout << PHWHERE << " tower index " << tower_index << " out of range for " << m_detector << ", skipping hit" << std::endl;
+      continue;
+    }
     // here I will add the truth matching part
     //  for the cell reco, the truth matching info relys on edep not light yield, I will be consistent here :)
     TowerInfo *tower = m_CaloWaveformContainer->get_tower_at_channel(tower_index);
@@ -364,11 +429,7 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     edepMap[hit->get_hit_id()] += hitEdep;
     showerMap[showerID] += hitEdep;
 
-    f_fit->SetParameters(ADC, _shiftval + t0, 0.);
-    for (int i = 0; i < m_nsamples; i++)
-    {
-      m_waveforms.at(tower_index).at(i) += f_fit->Eval(i);
-    }
+    add_pulse(&m_waveforms[static_cast<size_t>(tower_index) * m_nsamples], ADC, _shiftval + t0);
   }
 
   // do noise here and add to waveform
@@ -386,10 +447,21 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     }
   }
 
+  if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
+  {
+    // draw the noise for all channels in one go
+    m_noise.resize(m_waveforms.size());
+    for (auto &noise : m_noise)
+    {
+      noise = gsl_ran_gaussian_ziggurat(m_RandomGenerator, m_gaussian_noise);
+    }
+  }
+
+  std::vector<float> m_waveform_pedestal(m_nsamples);
   for (int i = 0; i < m_nchannels; i++)
   {
-    std::vector<float> m_waveform_pedestal;
-    m_waveform_pedestal.resize(m_nsamples);
+    float *waveform = &m_waveforms[static_cast<size_t>(i) * m_nsamples];
+    TowerInfo *waveform_tower = m_CaloWaveformContainer->get_tower_at_channel(i);
     if (m_noiseType == NoiseType::NOISE_TREE)
     {
       TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
@@ -411,24 +483,22 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
       {
         // TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
         // m_waveforms.at(i).at(j) += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
-        m_waveforms.at(i).at(j) += m_waveform_pedestal.at(j);
+        waveform[j] += m_waveform_pedestal[j];
       }
       if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
       {
-        m_waveforms.at(i).at(j) += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
+        waveform[j] += m_noise[static_cast<size_t>(i) * m_nsamples + j];
       }
       if (m_noiseType == NoiseType::NOISE_NONE)
       {
-        m_waveforms.at(i).at(j) += m_fixpedestal;
+        waveform[j] += m_fixpedestal;
       }
       // saturate at 2^14 - 1
-      m_waveforms.at(i).at(j) = std::min<__gnu_cxx::__alloc_traits<class std::allocator<float> >::value_type>(m_waveforms.at(i).at(j), 16383);
-      m_waveforms.at(i).at(j) = std::max<__gnu_cxx::__alloc_traits<class std::allocator<float> >::value_type>(m_waveforms.at(i).at(j), 0);
+      waveform[j] = std::clamp(waveform[j], 0.F, 16383.F);
 
-      m_CaloWaveformContainer->get_tower_at_channel(i)->set_waveform_value(j, m_waveforms.at(i).at(j));
+      waveform_tower->set_waveform_value(j, waveform[j]);
     }
   }
-  delete f_fit;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -217,7 +217,10 @@ class CaloWaveformSim : public SubsysReco
   gsl_rng *m_RandomGenerator{nullptr};
   PHG4CylinderCellGeom_Spacalv1 *geo{nullptr};
   const PHG4CylinderGeom_Spacalv3 *layergeom{nullptr};
-  std::vector<std::vector<float>> m_waveforms;
+  //! channel by sample waveforms, m_nsamples per channel
+  std::vector<float> m_waveforms;
+  //! per event noise, channel by sample
+  std::vector<double> m_noise;
   int m_runNumber{0};
 
   unsigned int (*encode_tower)(unsigned int, unsigned int){TowerInfoDefs::encode_emcal};
@@ -226,6 +229,13 @@ class CaloWaveformSim : public SubsysReco
   CDBTTree *cdbttree{nullptr}, *cdbttree_MC{nullptr};
   CDBTTree *cdbttree_time{nullptr}, *cdbttree_MC_time{nullptr};
   TProfile *h_template{nullptr};
+
+  //! pulse template tabulated on a uniform grid, linear interpolation between points as TH1::Interpolate
+  std::vector<double> m_template_y;
+  double m_template_x0{0.};
+  double m_template_dx{1.};
+  //! position of the template maximum within the readout window, for unit amplitude and no shift
+  double m_template_peak{0.};
   LightCollectionModel light_collection_model;
 
   NoiseType m_noiseType{NOISE_TREE};
@@ -235,7 +245,10 @@ class CaloWaveformSim : public SubsysReco
                     unsigned short &etabin,
                     unsigned short &phibin,
                     float &correction);
-  double template_function(double *x, double *par);
+  void tabulate_template();
+  double template_value(const double x) const;
+  //! add ampl times the template shifted by shift (in samples) to the waveform
+  void add_pulse(float *waveform, const double ampl, const double shift) const;
 };
 
 #endif  // G4WAVEFORMSIM_CALOWAVEFORMSIM_H